@@ -0,0 +1,303 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/game_record.h"
+
+#define GAME_RECORD_BUFFER_SIZE (1 << 16)
+
+static const char g_gameRecordMagic[4] = { 'Q', 'R', 'E', 'C' };
+
+/// @brief Renvoie le code de fin de partie, qui suit le dernier code d'action.
+static int GameRecord_getEndCode(int gridSize)
+{
+    return gridSize * gridSize + 2 * (gridSize - 1) * (gridSize - 1);
+}
+
+/// @brief Renvoie le nombre de bits nécessaires pour coder une action (code de fin compris).
+static int GameRecord_getBitsPerTurn(int gridSize)
+{
+    const int endCode = GameRecord_getEndCode(gridSize);
+    int bits = 1;
+    while ((1 << bits) <= endCode)
+        bits++;
+    return bits;
+}
+
+/// @brief Code une action : les déplacements d'abord, puis les murs (horizontal puis vertical).
+static int GameRecord_encodeTurn(int gridSize, QuoridorTurn turn)
+{
+    if (turn.action == QUORIDOR_MOVE_TO)
+        return turn.i * gridSize + turn.j;
+
+    const int slot = turn.i * (gridSize - 1) + turn.j;
+    return gridSize * gridSize + 2 * slot + (turn.action == QUORIDOR_PLAY_VERTICAL_WALL ? 1 : 0);
+}
+
+static QuoridorTurn GameRecord_decodeTurn(int gridSize, int code)
+{
+    QuoridorTurn turn = { 0 };
+    if (code < gridSize * gridSize)
+    {
+        turn.action = QUORIDOR_MOVE_TO;
+        turn.i = code / gridSize;
+        turn.j = code % gridSize;
+        return turn;
+    }
+
+    code -= gridSize * gridSize;
+    const int slot = code / 2;
+    turn.action = (code & 1) ? QUORIDOR_PLAY_VERTICAL_WALL : QUORIDOR_PLAY_HORIZONTAL_WALL;
+    turn.i = slot / (gridSize - 1);
+    turn.j = slot % (gridSize - 1);
+    return turn;
+}
+
+/// @brief Vérifie si une position est la position initiale standard
+/// (celle de QuoridorCore_reset()), auquel cas quatre octets suffisent pour la décrire.
+static bool GameRecord_isStandardStart(QuoridorCore *core)
+{
+    if (core->wallCounts[0] > 0xFF)
+        return false;
+
+    QuoridorCore start = { 0 };
+    QuoridorCore_reset(&start, core->gridSize, core->wallCounts[0], core->playerID, core->playerCount == 8);
+    start.playerCount = core->playerCount;
+    QuoridorCore_updateValidMoves(&start);
+
+    char str1[MAX_POSITION_STRING] = { 0 };
+    char str2[MAX_POSITION_STRING] = { 0 };
+    QuoridorCore_toString(core, str1, sizeof(str1));
+    QuoridorCore_toString(&start, str2, sizeof(str2));
+    return strcmp(str1, str2) == 0;
+}
+
+GameRecordWriter *GameRecordWriter_create(const char *path, bool append)
+{
+    FILE *file = fopen(path, append ? "ab" : "wb");
+    if (file == NULL) return NULL;
+
+    GameRecordWriter *self = (GameRecordWriter *)calloc(1, sizeof(GameRecordWriter));
+    AssertNew(self);
+
+    self->file = file;
+    setvbuf(file, NULL, _IOFBF, GAME_RECORD_BUFFER_SIZE);
+
+    // L'en-tête n'est écrit qu'au début du fichier
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0)
+    {
+        fwrite(g_gameRecordMagic, 1, sizeof(g_gameRecordMagic), file);
+        fputc(GAME_RECORD_VERSION, file);
+    }
+    return self;
+}
+
+void GameRecordWriter_destroy(GameRecordWriter *self)
+{
+    if (!self) return;
+    fclose(self->file);
+    free(self);
+}
+
+static void GameRecordWriter_writeBits(GameRecordWriter *self, int value, int bitCount)
+{
+    self->bits |= (Uint64)value << self->bitCount;
+    self->bitCount += bitCount;
+    while (self->bitCount >= 8)
+    {
+        fputc((int)(self->bits & 0xFF), self->file);
+        self->bits >>= 8;
+        self->bitCount -= 8;
+    }
+}
+
+void GameRecordWriter_beginGame(GameRecordWriter *self, QuoridorCore *core)
+{
+    assert(self && "The GameRecordWriter must be created");
+    self->gridSize = core->gridSize;
+    self->bitsPerTurn = GameRecord_getBitsPerTurn(core->gridSize);
+    self->bits = 0;
+    self->bitCount = 0;
+
+    if (GameRecord_isStandardStart(core))
+    {
+        fputc('S', self->file);
+        fputc(core->gridSize, self->file);
+        fputc(core->playerCount, self->file);
+        fputc(core->wallCounts[0], self->file);
+        fputc(core->playerID, self->file);
+        return;
+    }
+
+    char str[MAX_POSITION_STRING] = { 0 };
+    unsigned int length = (unsigned int)QuoridorCore_toString(core, str, sizeof(str));
+
+    fputc('P', self->file);
+    for (unsigned int value = length; ; value >>= 7)
+    {
+        if (value < 0x80)
+        {
+            fputc((int)value, self->file);
+            break;
+        }
+        fputc((int)(value & 0x7F) | 0x80, self->file);
+    }
+    fwrite(str, 1, length, self->file);
+}
+
+void GameRecordWriter_addTurn(GameRecordWriter *self, QuoridorTurn turn)
+{
+    assert(self && "The GameRecordWriter must be created");
+    assert(turn.action != QUORIDOR_ACTION_UNDEFINED);
+    GameRecordWriter_writeBits(self, GameRecord_encodeTurn(self->gridSize, turn), self->bitsPerTurn);
+}
+
+void GameRecordWriter_endGame(GameRecordWriter *self, QuoridorState state)
+{
+    assert(self && "The GameRecordWriter must be created");
+    GameRecordWriter_writeBits(self, GameRecord_getEndCode(self->gridSize), self->bitsPerTurn);
+
+    // Complète le dernier octet
+    if (self->bitCount > 0)
+        GameRecordWriter_writeBits(self, 0, 8 - self->bitCount);
+
+    const int result = (state == QUORIDOR_STATE_IN_PROGRESS) ? 0 : 1 + (state - QUORIDOR_STATE_P0_WON);
+    fputc(result, self->file);
+    self->gameCount++;
+}
+
+GameRecordReader *GameRecordReader_create(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    char magic[sizeof(g_gameRecordMagic)] = { 0 };
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, g_gameRecordMagic, sizeof(magic)) != 0 ||
+        fgetc(file) != GAME_RECORD_VERSION)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    GameRecordReader *self = (GameRecordReader *)calloc(1, sizeof(GameRecordReader));
+    AssertNew(self);
+
+    self->file = file;
+    setvbuf(file, NULL, _IOFBF, GAME_RECORD_BUFFER_SIZE);
+    return self;
+}
+
+void GameRecordReader_destroy(GameRecordReader *self)
+{
+    if (!self) return;
+    fclose(self->file);
+    free(self);
+}
+
+bool GameRecordReader_beginGame(GameRecordReader *self, QuoridorCore *core)
+{
+    assert(self && "The GameRecordReader must be created");
+    if (self->hasError) return false;
+
+    self->bits = 0;
+    self->bitCount = 0;
+    self->result = QUORIDOR_STATE_IN_PROGRESS;
+
+    const int tag = fgetc(self->file);
+    if (tag == EOF) return false;
+
+    if (tag == 'S')
+    {
+        const int gridSize = fgetc(self->file);
+        const int playerCount = fgetc(self->file);
+        const int wallCount = fgetc(self->file);
+        const int firstPlayer = fgetc(self->file);
+        if (firstPlayer == EOF || gridSize < 3 || gridSize > MAX_GRID_SIZE ||
+            (playerCount != 2 && playerCount != 4 && playerCount != 8) || firstPlayer >= playerCount)
+        {
+            self->hasError = true;
+            return false;
+        }
+
+        QuoridorCore_reset(core, gridSize, wallCount, firstPlayer, playerCount == 8);
+        core->playerCount = playerCount;
+        QuoridorCore_updateValidMoves(core);
+    }
+    else if (tag == 'P')
+    {
+        unsigned int length = 0;
+        for (int shift = 0; shift < 28; shift += 7)
+        {
+            const int byte = fgetc(self->file);
+            if (byte == EOF) break;
+            length |= (unsigned int)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) break;
+        }
+
+        char str[MAX_POSITION_STRING] = { 0 };
+        if (length >= sizeof(str) ||
+            fread(str, 1, length, self->file) != length ||
+            QuoridorCore_fromString(core, str) == 0)
+        {
+            self->hasError = true;
+            return false;
+        }
+    }
+    else
+    {
+        self->hasError = true;
+        return false;
+    }
+
+    self->gridSize = core->gridSize;
+    self->bitsPerTurn = GameRecord_getBitsPerTurn(core->gridSize);
+    return true;
+}
+
+bool GameRecordReader_nextTurn(GameRecordReader *self, QuoridorTurn *turn)
+{
+    assert(self && "The GameRecordReader must be created");
+    if (self->hasError) return false;
+
+    while (self->bitCount < self->bitsPerTurn)
+    {
+        const int byte = fgetc(self->file);
+        if (byte == EOF)
+        {
+            self->hasError = true;
+            return false;
+        }
+        self->bits |= (Uint64)byte << self->bitCount;
+        self->bitCount += 8;
+    }
+
+    const int code = (int)(self->bits & ((1u << self->bitsPerTurn) - 1));
+    self->bits >>= self->bitsPerTurn;
+    self->bitCount -= self->bitsPerTurn;
+
+    const int endCode = GameRecord_getEndCode(self->gridSize);
+    if (code > endCode)
+    {
+        self->hasError = true;
+        return false;
+    }
+    if (code == endCode)
+    {
+        // Les bits de remplissage du dernier octet sont ignorés
+        const int result = fgetc(self->file);
+        if (result == EOF)
+        {
+            self->hasError = true;
+            return false;
+        }
+        self->result = (result == 0) ? QUORIDOR_STATE_IN_PROGRESS : (QuoridorState)(QUORIDOR_STATE_P0_WON + result - 1);
+        return false;
+    }
+
+    *turn = GameRecord_decodeTurn(self->gridSize, code);
+    return true;
+}
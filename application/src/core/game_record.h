@@ -0,0 +1,114 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+
+// Format binaire d'enregistrement des parties.
+//
+// Un fichier commence par l'en-tête "QREC" suivi d'un octet de version,
+// puis contient une suite de parties écrites les unes après les autres :
+// - un octet 'S' suivi de la taille de la grille, du nombre de joueurs,
+//   du nombre de murs par joueur et du premier joueur (un octet chacun)
+//   si la partie commence par la position initiale standard,
+//   ou un octet 'P' suivi de la position en notation compacte
+//   (longueur en varint puis QuoridorCore_toString()) sinon ;
+// - les actions, codées sur le nombre minimal de bits pour la taille de la grille
+//   (8 bits en 9x9, 10 bits en 17x17) et terminées par un code de fin ;
+// - un octet de résultat : 0 si la partie n'est pas terminée, 1 + l'indice du gagnant sinon.
+
+/// @brief Version du format écrite dans l'en-tête.
+#define GAME_RECORD_VERSION 1
+
+/// @brief Écrit des parties au fil de l'eau dans un fichier.
+typedef struct GameRecordWriter
+{
+    FILE *file;
+
+    /// @brief Bits en attente d'écriture.
+    Uint64 bits;
+    int bitCount;
+
+    /// @brief Taille de la grille de la partie en cours.
+    int gridSize;
+
+    /// @brief Nombre de bits par action de la partie en cours.
+    int bitsPerTurn;
+
+    /// @brief Nombre de parties écrites.
+    Uint64 gameCount;
+} GameRecordWriter;
+
+/// @brief Lit des parties au fil de l'eau depuis un fichier.
+typedef struct GameRecordReader
+{
+    FILE *file;
+
+    /// @brief Bits lus mais pas encore consommés.
+    Uint64 bits;
+    int bitCount;
+
+    /// @brief Taille de la grille de la partie en cours.
+    int gridSize;
+
+    /// @brief Nombre de bits par action de la partie en cours.
+    int bitsPerTurn;
+
+    /// @brief Résultat de la dernière partie terminée de lire.
+    QuoridorState result;
+
+    /// @brief Booléen indiquant si le fichier est mal formé.
+    bool hasError;
+} GameRecordReader;
+
+/// @brief Crée un enregistreur de parties.
+/// @param path Chemin du fichier.
+/// @param append Booléen indiquant s'il faut ajouter les parties à la fin d'un fichier existant.
+/// @return L'enregistreur créé, ou NULL si le fichier ne peut pas être ouvert.
+GameRecordWriter *GameRecordWriter_create(const char *path, bool append);
+
+/// @brief Détruit un enregistreur de parties et ferme son fichier.
+/// @param self L'enregistreur.
+void GameRecordWriter_destroy(GameRecordWriter *self);
+
+/// @brief Commence l'enregistrement d'une partie à partir de sa position de départ.
+/// @param self L'enregistreur.
+/// @param core Position de départ de la partie.
+void GameRecordWriter_beginGame(GameRecordWriter *self, QuoridorCore *core);
+
+/// @brief Enregistre une action de la partie en cours.
+/// @param self L'enregistreur.
+/// @param turn Action jouée.
+void GameRecordWriter_addTurn(GameRecordWriter *self, QuoridorTurn turn);
+
+/// @brief Termine l'enregistrement de la partie en cours.
+/// @param self L'enregistreur.
+/// @param state État final de la partie.
+void GameRecordWriter_endGame(GameRecordWriter *self, QuoridorState state);
+
+/// @brief Crée un lecteur de parties.
+/// @param path Chemin du fichier.
+/// @return Le lecteur créé, ou NULL si le fichier ne peut pas être ouvert ou n'est pas un enregistrement.
+GameRecordReader *GameRecordReader_create(const char *path);
+
+/// @brief Détruit un lecteur de parties et ferme son fichier.
+/// @param self Le lecteur.
+void GameRecordReader_destroy(GameRecordReader *self);
+
+/// @brief Lit le début de la partie suivante et place la partie dans sa position de départ.
+/// @param self Le lecteur.
+/// @param core Instance du jeu Quoridor à initialiser.
+/// @return false s'il n'y a plus de partie (ou si le fichier est mal formé).
+bool GameRecordReader_beginGame(GameRecordReader *self, QuoridorCore *core);
+
+/// @brief Lit l'action suivante de la partie en cours.
+/// Après la dernière action, le résultat de la partie est disponible dans self->result.
+/// @param self Le lecteur.
+/// @param turn Adresse où est écrite l'action lue.
+/// @return false à la fin de la partie.
+bool GameRecordReader_nextTurn(GameRecordReader *self, QuoridorTurn *turn);
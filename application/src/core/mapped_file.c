@@ -0,0 +1,99 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/mapped_file.h"
+
+#ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile *MappedFile_open(const char *path)
+{
+    HANDLE file = CreateFileA(
+        path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    LARGE_INTEGER size = { 0 };
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return NULL;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void *data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (data == NULL)
+    {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return NULL;
+    }
+
+    MappedFile *self = (MappedFile *)calloc(1, sizeof(MappedFile));
+    AssertNew(self);
+
+    self->data = (const Uint8 *)data;
+    self->size = (size_t)size.QuadPart;
+    self->fileHandle = file;
+    self->mappingHandle = mapping;
+    return self;
+}
+
+void MappedFile_close(MappedFile *self)
+{
+    if (!self) return;
+    UnmapViewOfFile(self->data);
+    CloseHandle(self->mappingHandle);
+    CloseHandle(self->fileHandle);
+    free(self);
+}
+
+#else
+
+MappedFile *MappedFile_open(const char *path)
+{
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    // La projection reste valide après la fermeture du descripteur
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return NULL;
+
+    MappedFile *self = (MappedFile *)calloc(1, sizeof(MappedFile));
+    AssertNew(self);
+
+    self->data = (const Uint8 *)data;
+    self->size = (size_t)info.st_size;
+    return self;
+}
+
+void MappedFile_close(MappedFile *self)
+{
+    if (!self) return;
+    munmap((void *)self->data, self->size);
+    free(self);
+}
+
+#endif
@@ -0,0 +1,37 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Fichier projeté en mémoire en lecture seule.
+/// Les pages ne sont lues sur le disque qu'au premier accès et sont partagées
+/// entre les processus qui projettent le même fichier : l'ouverture ne coûte rien,
+/// quelle que soit la taille du fichier.
+typedef struct MappedFile
+{
+    /// @brief Début du contenu du fichier.
+    const Uint8 *data;
+
+    /// @brief Taille du fichier en octets.
+    size_t size;
+
+#ifdef _WIN32
+    /// @brief Descripteurs du fichier et de la projection.
+    void *fileHandle;
+    void *mappingHandle;
+#endif
+} MappedFile;
+
+/// @brief Projette un fichier en mémoire.
+/// @param path Chemin du fichier.
+/// @return Le fichier projeté, ou NULL si le fichier ne peut pas être ouvert ou est vide.
+MappedFile *MappedFile_open(const char *path);
+
+/// @brief Libère la projection et ferme le fichier.
+/// @param self Le fichier projeté.
+void MappedFile_close(MappedFile *self);
@@ -0,0 +1,644 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/mcts.h"
+#include "core/quoridor_ai.h"
+#include "core/utils.h"
+#include "core/trace.h"
+
+/// @brief Nombre maximal d'enfants d'un noeud (déplacements et murs candidats).
+#define MCTS_MAX_CHILDREN (25 + 7 * 2 * MCTS_WALL_STEPS)
+
+/// @brief Nombre d'enfants considérés par un noeud peu visité.
+#define MCTS_WIDENING_MIN 4
+
+/// @brief Nombre d'enfants considérés en plus par racine carrée du nombre de visites.
+#define MCTS_WIDENING_RATE 2.f
+
+/// @brief Données d'un thread de la recherche.
+typedef struct MCTSWorker
+{
+    MCTSTree *tree;
+    const QuoridorCore *root;
+    AIData *aiData;
+    Rng rng;
+    Uint64 deadline;
+    Uint64 iterationLimit;
+
+    Uint64 iterationCount;
+    Uint64 playoutCount;
+    Uint64 pathCount;
+    Uint64 wallCheckCount;
+    int maxDepth;
+} MCTSWorker;
+
+MCTS *MCTS_create()
+{
+    MCTS *self = (MCTS *)calloc(1, sizeof(MCTS));
+    AssertNew(self);
+    return self;
+}
+
+void MCTS_destroy(MCTS *self)
+{
+    if (!self) return;
+    for (int t = 0; t < MCTS_MAX_THREADS; t++)
+    {
+        free(self->trees[t].nodes);
+    }
+    free(self);
+}
+
+void MCTS_clear(MCTS *self)
+{
+    if (!self) return;
+    for (int t = 0; t < MCTS_MAX_THREADS; t++)
+    {
+        self->trees[t].nodeCount = 0;
+    }
+}
+
+/// @brief Réserve de la place pour count noeuds supplémentaires.
+/// @return false si l'arbre a atteint sa taille maximale.
+static bool MCTSTree_reserve(MCTSTree *self, int count)
+{
+    if (self->nodeCount + count <= self->nodeCapacity)
+        return true;
+    if (self->nodeCount + count > MCTS_MAX_NODES)
+        return false;
+
+    int capacity = Int_max(self->nodeCapacity, 4096);
+    while (capacity < self->nodeCount + count)
+        capacity *= 2;
+    capacity = Int_min(capacity, MCTS_MAX_NODES);
+
+    self->nodes = (MCTSNode *)realloc(self->nodes, capacity * sizeof(MCTSNode));
+    AssertNew(self->nodes);
+    self->nodeCapacity = capacity;
+    return true;
+}
+
+/// @brief Place la racine de l'arbre sur une position.
+/// Si la position se trouve dans les premiers niveaux de l'arbre
+/// (c'est le cas après les coups des autres joueurs), son sous-arbre est conservé
+/// et compacté au début du tableau ; sinon l'arbre est vidé.
+static void MCTSTree_setRoot(MCTSTree *self, const QuoridorCore *core)
+{
+    int found = -1;
+    if (self->nodeCount > 0 && self->nodes[0].hash == core->hash)
+        found = 0;
+
+    if (found < 0 && self->nodeCount > 1)
+    {
+        // Parcours en largeur des noeuds visités, jusqu'à un tour de table sous la racine
+        int *queue = (int *)malloc(self->nodeCount * sizeof(int));
+        int *depths = (int *)malloc(self->nodeCount * sizeof(int));
+        AssertNew(queue);
+        AssertNew(depths);
+
+        int front = 0, back = 1;
+        queue[0] = 0;
+        depths[0] = 0;
+        while (front < back && found < 0)
+        {
+            const int index = queue[front];
+            const int depth = depths[front++];
+            const MCTSNode *node = &(self->nodes[index]);
+            if (depth >= core->playerCount || node->childCount <= 0)
+                continue;
+
+            for (int c = node->firstChild; c < node->firstChild + node->childCount; c++)
+            {
+                if (self->nodes[c].visits == 0) continue;
+                if (self->nodes[c].hash == core->hash)
+                {
+                    found = c;
+                    break;
+                }
+                queue[back] = c;
+                depths[back++] = depth + 1;
+            }
+        }
+        free(queue);
+        free(depths);
+    }
+
+    if (found < 0)
+    {
+        MCTSTree_reserve(self, 1);
+        MCTSNode *root = &(self->nodes[0]);
+        memset(root, 0, sizeof(MCTSNode));
+        root->hash = core->hash;
+        root->childCount = -1;
+        root->playerID = (core->playerID + core->playerCount - 1) % core->playerCount;
+        self->nodeCount = 1;
+        return;
+    }
+    if (found == 0)
+        return;
+
+    MCTSNode *nodes = (MCTSNode *)malloc(self->nodeCapacity * sizeof(MCTSNode));
+    AssertNew(nodes);
+
+    nodes[0] = self->nodes[found];
+    int count = 1;
+    for (int k = 0; k < count; k++)
+    {
+        MCTSNode *node = &(nodes[k]);
+        if (node->childCount <= 0) continue;
+
+        memcpy(&(nodes[count]), &(self->nodes[node->firstChild]), node->childCount * sizeof(MCTSNode));
+        node->firstChild = count;
+        count += node->childCount;
+    }
+
+    free(self->nodes);
+    self->nodes = nodes;
+    self->nodeCount = count;
+}
+
+/// @brief Ajoute un mur candidat s'il est sur le plateau et pas encore dans la liste.
+static void MCTS_addWall(const QuoridorCore *core, QuoridorAction action, int i, int j, QuoridorTurn *turns, int *count)
+{
+    if (i < 0 || i >= core->gridSize - 1 || j < 0 || j >= core->gridSize - 1)
+        return;
+    for (int k = 0; k < *count; k++)
+    {
+        if (turns[k].action == action && turns[k].i == i && turns[k].j == j)
+            return;
+    }
+    turns[*count].action = action;
+    turns[*count].i = i;
+    turns[*count].j = j;
+    (*count)++;
+}
+
+/// @brief Ajoute les deux murs qui coupent le passage entre deux cases voisines.
+static void MCTS_addBlockingWalls(const QuoridorCore *core, QuoridorPos a, QuoridorPos b, QuoridorTurn *turns, int *count)
+{
+    if (a.i != b.i)
+    {
+        const int i = Int_min(a.i, b.i);
+        MCTS_addWall(core, QUORIDOR_PLAY_HORIZONTAL_WALL, i, a.j, turns, count);
+        MCTS_addWall(core, QUORIDOR_PLAY_HORIZONTAL_WALL, i, a.j - 1, turns, count);
+    }
+    else
+    {
+        const int j = Int_min(a.j, b.j);
+        MCTS_addWall(core, QUORIDOR_PLAY_VERTICAL_WALL, a.i, j, turns, count);
+        MCTS_addWall(core, QUORIDOR_PLAY_VERTICAL_WALL, a.i - 1, j, turns, count);
+    }
+}
+
+static QuoridorTurn MCTS_getPathTurn(MCTSWorker *worker, QuoridorCore *core);
+
+/// @brief Génère les actions explorées depuis une position, les plus prometteuses en premier :
+/// le pas suivant du plus court chemin, les autres déplacements, puis les murs
+/// qui coupent les premiers pas du plus court chemin des adversaires,
+/// en commençant par les plus proches de leur arrivée.
+/// La légalité des murs n'est vérifiée qu'à la première visite de l'enfant correspondant.
+static int MCTS_generateTurns(MCTSWorker *worker, QuoridorCore *core, QuoridorTurn *turns)
+{
+    const int playerID = core->playerID;
+    const QuoridorPos pos = core->positions[playerID];
+    int count = 0;
+
+    turns[count++] = MCTS_getPathTurn(worker, core);
+    if (turns[0].action == QUORIDOR_ACTION_UNDEFINED)
+        count = 0;
+
+    for (int i = Int_max(0, pos.i - 2); i <= Int_min(core->gridSize - 1, pos.i + 2); i++)
+    {
+        for (int j = Int_max(0, pos.j - 2); j <= Int_min(core->gridSize - 1, pos.j + 2); j++)
+        {
+            if (core->isValid[i][j] == false) continue;
+            if (count > 0 && turns[0].i == i && turns[0].j == j) continue;
+            turns[count].action = QUORIDOR_MOVE_TO;
+            turns[count].i = i;
+            turns[count].j = j;
+            count++;
+        }
+    }
+
+    if (core->wallCounts[playerID] <= 0)
+        return count;
+
+    // Adversaires triés par distance croissante (tri par insertion)
+    QuoridorPos paths[8][MAX_PATH_LEN];
+    int sizes[8] = { 0 };
+    int order[8] = { 0 };
+    int otherCount = 0;
+    for (int k = 1; k < core->playerCount; k++)
+    {
+        const int otherID = (playerID + k) % core->playerCount;
+        sizes[otherID] = BFS_search2(core, otherID, paths[otherID]);
+        worker->pathCount++;
+
+        int m = otherCount++;
+        while (m > 0 && sizes[order[m - 1]] > sizes[otherID])
+        {
+            order[m] = order[m - 1];
+            m--;
+        }
+        order[m] = otherID;
+    }
+
+    for (int s = 0; s < MCTS_WALL_STEPS; s++)
+    {
+        for (int k = 0; k < otherCount; k++)
+        {
+            const int otherID = order[k];
+            if (s + 1 < sizes[otherID])
+                MCTS_addBlockingWalls(core, paths[otherID][s], paths[otherID][s + 1], turns, &count);
+        }
+    }
+    return count;
+}
+
+/// @brief Renvoie le déplacement du joueur courant qui suit son plus court chemin
+/// (ou un déplacement quelconque si le chemin est bloqué par un pion).
+static QuoridorTurn MCTS_getPathTurn(MCTSWorker *worker, QuoridorCore *core)
+{
+    QuoridorPos path[MAX_PATH_LEN];
+    QuoridorTurn turn = { 0 };
+    const int size = BFS_search2(core, core->playerID, path);
+    worker->pathCount++;
+
+    turn.action = QUORIDOR_MOVE_TO;
+    for (int s = Int_min(size - 1, 2); s >= 1; s--)
+    {
+        // Le pas suivant, ou le saut par-dessus le pion qui l'occupe
+        if (core->isValid[path[s].i][path[s].j])
+        {
+            turn.i = path[s].i;
+            turn.j = path[s].j;
+            return turn;
+        }
+    }
+
+    const QuoridorPos pos = core->positions[core->playerID];
+    int count = 0;
+    for (int i = Int_max(0, pos.i - 2); i <= Int_min(core->gridSize - 1, pos.i + 2); i++)
+    {
+        for (int j = Int_max(0, pos.j - 2); j <= Int_min(core->gridSize - 1, pos.j + 2); j++)
+        {
+            if (core->isValid[i][j] == false) continue;
+
+            // Choix uniforme parmi les cases accessibles (échantillonnage par réservoir)
+            count++;
+            if (Rng_intAB(&worker->rng, 0, count) == 0)
+            {
+                turn.i = i;
+                turn.j = j;
+            }
+        }
+    }
+    if (count == 0)
+        turn.action = QUORIDOR_ACTION_UNDEFINED;
+    return turn;
+}
+
+/// @brief Évalue une position pour tous les joueurs, sans bruit
+/// (voir QuoridorCore_computeScores()).
+static void MCTS_evaluate(MCTSWorker *worker, QuoridorCore *core, float *rewards)
+{
+    if (core->state == QUORIDOR_STATE_IN_PROGRESS)
+        worker->pathCount += core->playerCount;
+    QuoridorCore_computeScores(core, rewards, NULL);
+}
+
+/// @brief Termine la partie par une simulation rapide : chaque joueur avance
+/// sur son plus court chemin, ou pose parfois un mur devant un adversaire.
+/// La simulation s'arrête après MCTS_PLAYOUT_ROUNDS tours de table et la position est évaluée.
+static void MCTS_playout(MCTSWorker *worker, QuoridorCore *core, float *rewards)
+{
+    const int plyCount = MCTS_PLAYOUT_ROUNDS * core->playerCount;
+    QuoridorPos path[MAX_PATH_LEN];
+
+    // Les actions sont vérifiées avant d'être jouées : QuoridorCore_makeTurn()
+    // évite de vérifier une deuxième fois la légalité des murs
+    QuoridorUndo undo = { 0 };
+
+    for (int ply = 0; ply < plyCount && core->state == QUORIDOR_STATE_IN_PROGRESS; ply++)
+    {
+        const int playerID = core->playerID;
+        if (core->wallCounts[playerID] > 0 && Rng_float01(&worker->rng) < MCTS_PLAYOUT_WALL_RATE)
+        {
+            const int otherID = (playerID + Rng_intAB(&worker->rng, 1, core->playerCount)) % core->playerCount;
+            const int size = BFS_search2(core, otherID, path);
+            worker->pathCount++;
+
+            if (size >= 2)
+            {
+                QuoridorTurn walls[2];
+                int wallCount = 0;
+                MCTS_addBlockingWalls(core, path[0], path[1], walls, &wallCount);
+
+                if (wallCount > 0)
+                {
+                    const QuoridorTurn wall = walls[Rng_intAB(&worker->rng, 0, wallCount)];
+                    const WallType type = (wall.action == QUORIDOR_PLAY_HORIZONTAL_WALL) ? WALL_TYPE_HORIZONTAL : WALL_TYPE_VERTICAL;
+                    worker->wallCheckCount++;
+                    if (QuoridorCore_canPlayWall(core, type, wall.i, wall.j))
+                    {
+                        QuoridorCore_makeTurn(core, wall, &undo);
+                        continue;
+                    }
+                }
+            }
+        }
+
+        const QuoridorTurn turn = MCTS_getPathTurn(worker, core);
+        if (turn.action == QUORIDOR_ACTION_UNDEFINED)
+            break;
+        QuoridorCore_makeTurn(core, turn, &undo);
+    }
+
+    worker->playoutCount++;
+    MCTS_evaluate(worker, core, rewards);
+}
+
+/// @brief Choisit l'enfant à explorer selon la formule UCT.
+/// Seuls les premiers enfants sont considérés, et leur nombre augmente avec
+/// la racine carrée du nombre de visites du parent (élargissement progressif).
+/// Les enfants jamais visités passent en premier ; un mur illégal est alors écarté.
+/// @return L'indice de l'enfant, ou -1 si aucun enfant n'est jouable.
+static int MCTS_select(MCTSWorker *worker, QuoridorCore *core, int index)
+{
+    MCTSNode *nodes = worker->tree->nodes;
+    const MCTSNode *parent = &(nodes[index]);
+    const float logVisits = logf((float)parent->visits + 1.f);
+    const int widthMax = MCTS_WIDENING_MIN + (int)(MCTS_WIDENING_RATE * sqrtf((float)parent->visits));
+    int width = 0;
+    int best = -1;
+    float bestValue = -INFINITY;
+
+    for (int c = parent->firstChild; c < parent->firstChild + parent->childCount && width < widthMax; c++)
+    {
+        MCTSNode *child = &(nodes[c]);
+        if (child->turn.action == QUORIDOR_ACTION_UNDEFINED)
+            continue;
+
+        if (child->visits == 0)
+        {
+            if (child->turn.action != QUORIDOR_MOVE_TO)
+            {
+                const WallType type = (child->turn.action == QUORIDOR_PLAY_HORIZONTAL_WALL) ? WALL_TYPE_HORIZONTAL : WALL_TYPE_VERTICAL;
+                worker->wallCheckCount++;
+                if (QuoridorCore_canPlayWall(core, type, child->turn.i, child->turn.j) == false)
+                {
+                    child->turn.action = QUORIDOR_ACTION_UNDEFINED;
+                    continue;
+                }
+            }
+            return c;
+        }
+        width++;
+
+        const float value = child->reward / (float)child->visits +
+            MCTS_EXPLORATION * sqrtf(logVisits / (float)child->visits);
+        if (value > bestValue)
+        {
+            bestValue = value;
+            best = c;
+        }
+    }
+    return best;
+}
+
+/// @brief Développe un noeud : ses enfants sont ajoutés à la fin de l'arbre.
+/// @return false si l'arbre est plein.
+static bool MCTS_expand(MCTSWorker *worker, QuoridorCore *core, int index)
+{
+    QuoridorTurn turns[MCTS_MAX_CHILDREN];
+    const int count = MCTS_generateTurns(worker, core, turns);
+
+    MCTSTree *tree = worker->tree;
+    if (MCTSTree_reserve(tree, count) == false)
+        return false;
+
+    MCTSNode *node = &(tree->nodes[index]);
+    node->firstChild = tree->nodeCount;
+    node->childCount = count;
+    for (int k = 0; k < count; k++)
+    {
+        MCTSNode *child = &(tree->nodes[tree->nodeCount++]);
+        memset(child, 0, sizeof(MCTSNode));
+        child->turn = turns[k];
+        child->childCount = -1;
+        child->playerID = core->playerID;
+    }
+    return true;
+}
+
+/// @brief Effectue une itération : sélection, développement, simulation et rétropropagation.
+static void MCTS_iterate(MCTSWorker *worker)
+{
+    QuoridorCore core = *(worker->root);
+    int path[MCTS_MAX_DEPTH + 1] = { 0 };
+    int depth = 0;
+    int index = 0;
+
+    while (core.state == QUORIDOR_STATE_IN_PROGRESS && depth < MCTS_MAX_DEPTH)
+    {
+        MCTSNode *node = &(worker->tree->nodes[index]);
+        // Un noeud est développé à sa deuxième visite (la racine immédiatement)
+        if (node->childCount < 0 && MCTS_expand(worker, &core, index) == false)
+            break;
+
+        const int child = MCTS_select(worker, &core, index);
+        if (child < 0)
+            break;
+
+        // La légalité de l'action a été vérifiée par MCTS_select()
+        MCTSNode *childNode = &(worker->tree->nodes[child]);
+        QuoridorUndo undo = { 0 };
+        QuoridorCore_makeTurn(&core, childNode->turn, &undo);
+        childNode->hash = core.hash;
+        path[++depth] = child;
+        index = child;
+
+        if (childNode->visits == 0)
+            break;
+    }
+    worker->maxDepth = Int_max(worker->maxDepth, depth);
+
+    float rewards[8] = { 0 };
+    MCTS_playout(worker, &core, rewards);
+
+    for (int d = 0; d <= depth; d++)
+    {
+        MCTSNode *node = &(worker->tree->nodes[path[d]]);
+        node->visits++;
+        node->reward += rewards[node->playerID];
+    }
+    worker->iterationCount++;
+}
+
+/// @brief Vérifie si un thread doit s'arrêter.
+static bool MCTS_isStopped(MCTSWorker *worker)
+{
+    if (worker->iterationLimit > 0 && worker->iterationCount >= worker->iterationLimit)
+        return true;
+    if (SDL_GetAtomicInt(&(worker->aiData->stopRequested)))
+        return true;
+    return worker->deadline && SDL_GetPerformanceCounter() >= worker->deadline;
+}
+
+static int MCTS_workerMain(void *data)
+{
+    MCTSWorker *worker = (MCTSWorker *)data;
+    MCTSTree_setRoot(worker->tree, worker->root);
+
+    while (MCTS_isStopped(worker) == false)
+    {
+        MCTS_iterate(worker);
+    }
+    return 0;
+}
+
+QuoridorTurn MCTS_search(MCTS *self, QuoridorCore *core, AIData *aiData)
+{
+    assert(self && "The MCTS must be created");
+    assert(aiData && "The AIData must be created");
+    TRACE_SCOPE_BEGIN("MCTS");
+
+    const MCTSSettings *settings = &(aiData->mctsSettings);
+    int threadCount = Int_clamp(settings->threadCount, 1, MCTS_MAX_THREADS);
+
+    // La limite de noeuds de l'IA est partagée entre les threads
+    Uint64 iterationLimit = (settings->iterationCount > 0) ? (Uint64)settings->iterationCount : 0;
+    if (aiData->nodeLimit > 0)
+    {
+        if (aiData->nodeLimit < (Uint64)threadCount)
+            threadCount = (int)aiData->nodeLimit;
+        const Uint64 threadLimit = aiData->nodeLimit / (Uint64)threadCount;
+        if (iterationLimit == 0 || threadLimit < iterationLimit)
+            iterationLimit = threadLimit;
+    }
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    Uint64 deadline = 0;
+    if (settings->timeMS > 0)
+        deadline = start + (Uint64)settings->timeMS * SDL_GetPerformanceFrequency() / 1000;
+    if (aiData->deadline && (deadline == 0 || aiData->deadline < deadline))
+        deadline = aiData->deadline;
+
+    MCTSWorker workers[MCTS_MAX_THREADS] = { 0 };
+    SDL_Thread *threads[MCTS_MAX_THREADS] = { 0 };
+    for (int t = 0; t < threadCount; t++)
+    {
+        MCTSWorker *worker = &(workers[t]);
+        worker->tree = &(self->trees[t]);
+        worker->root = core;
+        worker->aiData = aiData;
+        worker->deadline = deadline;
+        worker->iterationLimit = iterationLimit;
+        Rng_seed(&(worker->rng), ((Uint64)Rng_next(&aiData->rng) << 32) | Rng_next(&aiData->rng));
+    }
+
+    // Parallélisation à la racine : chaque thread construit son propre arbre
+    for (int t = 1; t < threadCount; t++)
+    {
+        threads[t] = SDL_CreateThread(MCTS_workerMain, "mcts", &workers[t]);
+        if (threads[t] == NULL)
+            printf("ERROR - SDL_CreateThread %s\n", SDL_GetError());
+    }
+    MCTS_workerMain(&workers[0]);
+    for (int t = 1; t < threadCount; t++)
+    {
+        if (threads[t]) SDL_WaitThread(threads[t], NULL);
+        else MCTS_workerMain(&workers[t]);
+    }
+
+    // Fusion des statistiques des enfants de la racine
+    AIStats *stats = &(aiData->stats);
+    QuoridorTurn bestTurn = { 0 };
+    Uint32 bestVisits = 0;
+    float bestReward = 0.f;
+
+    const MCTSTree *tree = &(self->trees[0]);
+    const MCTSNode *root = &(tree->nodes[0]);
+    for (int c = root->firstChild; root->childCount > 0 && c < root->firstChild + root->childCount; c++)
+    {
+        const QuoridorTurn turn = tree->nodes[c].turn;
+        if (turn.action == QUORIDOR_ACTION_UNDEFINED) continue;
+
+        Uint32 visits = 0;
+        float reward = 0.f;
+        for (int t = 0; t < threadCount; t++)
+        {
+            const MCTSTree *other = &(self->trees[t]);
+            const MCTSNode *otherRoot = &(other->nodes[0]);
+            for (int k = otherRoot->firstChild; otherRoot->childCount > 0 && k < otherRoot->firstChild + otherRoot->childCount; k++)
+            {
+                const MCTSNode *node = &(other->nodes[k]);
+                if (node->turn.action == turn.action && node->turn.i == turn.i && node->turn.j == turn.j)
+                {
+                    visits += node->visits;
+                    reward += node->reward;
+                    break;
+                }
+            }
+        }
+        if (visits > bestVisits)
+        {
+            bestVisits = visits;
+            bestReward = reward;
+            bestTurn = turn;
+        }
+    }
+
+    // Variation principale : les enfants les plus visités de l'arbre du premier thread
+    aiData->pvLength[0] = 0;
+    if (bestVisits > 0)
+    {
+        aiData->pvTable[0][aiData->pvLength[0]++] = bestTurn;
+
+        int index = -1;
+        for (int c = root->firstChild; c < root->firstChild + root->childCount; c++)
+        {
+            const QuoridorTurn turn = tree->nodes[c].turn;
+            if (turn.action == bestTurn.action && turn.i == bestTurn.i && turn.j == bestTurn.j)
+                index = c;
+        }
+        while (index >= 0 && tree->nodes[index].childCount > 0 && aiData->pvLength[0] < AI_MAX_PLY)
+        {
+            const MCTSNode *node = &(tree->nodes[index]);
+            index = -1;
+            Uint32 visits = 0;
+            for (int c = node->firstChild; c < node->firstChild + node->childCount; c++)
+            {
+                if (tree->nodes[c].turn.action != QUORIDOR_ACTION_UNDEFINED && tree->nodes[c].visits > visits)
+                {
+                    visits = tree->nodes[c].visits;
+                    index = c;
+                }
+            }
+            if (index >= 0)
+                aiData->pvTable[0][aiData->pvLength[0]++] = tree->nodes[index].turn;
+        }
+    }
+    else if (core->state == QUORIDOR_STATE_IN_PROGRESS)
+    {
+        // Aucune itération n'a abouti (arrêt immédiat) : le coup suit le plus court chemin
+        bestTurn = MCTS_getPathTurn(&workers[0], core);
+    }
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        stats->nodeCount += workers[t].iterationCount;
+        stats->leafCount += workers[t].playoutCount;
+        stats->pathCount += workers[t].pathCount;
+        stats->wallCheckCount += workers[t].wallCheckCount;
+        stats->depth = Int_max(stats->depth, workers[t].maxDepth);
+    }
+    stats->score = bestVisits > 0 ? bestReward / (float)bestVisits : 0.f;
+    stats->aborted = SDL_GetAtomicInt(&(aiData->stopRequested)) != 0;
+
+    TRACE_SCOPE_END();
+    return bestTurn;
+}
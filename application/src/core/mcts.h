@@ -0,0 +1,116 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+
+typedef struct AIData AIData;
+
+/// @brief Nombre maximal de threads d'une recherche MCTS.
+#define MCTS_MAX_THREADS 16
+
+/// @brief Nombre maximal de noeuds d'un arbre (un arbre par thread).
+#define MCTS_MAX_NODES (1 << 19)
+
+/// @brief Profondeur maximale de la descente dans l'arbre.
+#define MCTS_MAX_DEPTH 128
+
+/// @brief Constante d'exploration de la formule UCT (récompenses entre 0 et 1).
+#define MCTS_EXPLORATION 0.25f
+
+/// @brief Nombre de tours de table joués par une simulation avant l'évaluation.
+#define MCTS_PLAYOUT_ROUNDS 1
+
+/// @brief Probabilité qu'un joueur pose un mur pendant une simulation.
+#define MCTS_PLAYOUT_WALL_RATE 0.15f
+
+/// @brief Nombre de pas du plus court chemin d'un adversaire devant lesquels
+/// des murs sont essayés lors de l'expansion d'un noeud.
+#define MCTS_WALL_STEPS 5
+
+/// @brief Paramètres d'une recherche MCTS.
+typedef struct MCTSSettings
+{
+    /// @brief Durée de la recherche en millisecondes.
+    int timeMS;
+
+    /// @brief Nombre de threads (un arbre par thread, fusionnés à la racine).
+    int threadCount;
+
+    /// @brief Nombre maximal d'itérations par thread (0 si aucune limite).
+    /// Avec une limite et sans limite de temps, la recherche est reproductible.
+    int iterationCount;
+} MCTSSettings;
+
+/// @brief Noeud d'un arbre MCTS.
+/// Les enfants d'un noeud sont contigus dans le tableau des noeuds.
+typedef struct MCTSNode
+{
+    /// @brief Action menant au noeud.
+    QuoridorTurn turn;
+
+    /// @brief Clé de la position après l'action (voir QuoridorCore::hash).
+    Uint64 hash;
+
+    /// @brief Indice du premier enfant.
+    int firstChild;
+
+    /// @brief Nombre d'enfants, -1 si le noeud n'a pas encore été développé.
+    int childCount;
+
+    /// @brief Joueur ayant joué l'action.
+    int playerID;
+
+    /// @brief Nombre de passages par le noeud.
+    Uint32 visits;
+
+    /// @brief Somme des récompenses du joueur playerID.
+    float reward;
+} MCTSNode;
+
+/// @brief Arbre de recherche d'un thread. La racine est à l'indice 0.
+typedef struct MCTSTree
+{
+    MCTSNode *nodes;
+    int nodeCount;
+    int nodeCapacity;
+} MCTSTree;
+
+/// @brief Arbres d'une recherche MCTS, conservés d'un coup à l'autre :
+/// la recherche suivante repart du sous-arbre de la nouvelle position.
+typedef struct MCTS
+{
+    MCTSTree trees[MCTS_MAX_THREADS];
+} MCTS;
+
+/// @brief Crée des arbres vides.
+/// @return Les arbres créés.
+MCTS *MCTS_create();
+
+/// @brief Détruit les arbres.
+/// @param self Les arbres.
+void MCTS_destroy(MCTS *self);
+
+/// @brief Oublie les arbres (à appeler au début d'une nouvelle partie).
+/// @param self Les arbres.
+void MCTS_clear(MCTS *self);
+
+/// @brief Cherche le coup du joueur courant par Monte Carlo Tree Search (UCT).
+/// Chaque noeud maximise la récompense du joueur qui y joue, ce qui modélise
+/// correctement les parties à plus de deux joueurs. Les simulations suivent
+/// les plus courts chemins avec quelques murs, puis la position est évaluée
+/// d'après les distances de tous les joueurs.
+/// La recherche s'arrête à la fin de sa durée, à la limite de temps de l'IA, à sa limite de noeuds
+/// (itérations de tous les threads, voir AIData_setNodeLimit()) ou sur AIData_stop().
+/// Les statistiques sont écrites dans aiData->stats et la variation principale
+/// dans aiData->pvTable[0].
+/// @param self Les arbres.
+/// @param core La position.
+/// @param aiData Données de l'IA (paramètres, générateur et statistiques).
+/// @return Le coup choisi, toujours jouable si la partie n'est pas finie.
+QuoridorTurn MCTS_search(MCTS *self, QuoridorCore *core, AIData *aiData);
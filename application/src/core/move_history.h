@@ -0,0 +1,112 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+
+/// @brief Nombre de coups retenus par joueur (puissance de deux).
+#define MOVE_HISTORY_CAPACITY 256
+
+/// @brief Coup joué, avec ce qu'il faut pour l'annuler.
+typedef struct QuoridorData
+{
+    /// @brief Type d'action.
+    QuoridorAction action;
+    QuoridorPos destPos;
+    QuoridorPos originPos;
+    int score;
+} QuoridorData;
+
+/// @brief Historique des derniers coups d'un joueur, dans un tampon circulaire.
+/// Quand l'historique est plein, un nouveau coup remplace le plus ancien.
+typedef struct MoveHistory
+{
+    QuoridorData data[MOVE_HISTORY_CAPACITY];
+
+    /// @brief Indice du prochain coup à écrire.
+    int head;
+
+    /// @brief Nombre de coups dans l'historique.
+    int count;
+} MoveHistory;
+
+/// @brief Itérateur sur un historique, du coup le plus récent au plus ancien.
+typedef struct MoveHistoryIter
+{
+    const MoveHistory *history;
+    int index;
+} MoveHistoryIter;
+
+/// @brief Vide l'historique.
+/// @param self L'historique.
+INLINE void MoveHistory_clear(MoveHistory *self)
+{
+    self->head = 0;
+    self->count = 0;
+}
+
+/// @brief Renvoie le nombre de coups dans l'historique.
+/// @param self L'historique.
+INLINE int MoveHistory_getCount(const MoveHistory *self)
+{
+    return self->count;
+}
+
+/// @brief Ajoute un coup à l'historique.
+/// @param self L'historique.
+/// @param data Coup joué.
+INLINE void MoveHistory_push(MoveHistory *self, QuoridorData data)
+{
+    self->data[self->head] = data;
+    self->head = (self->head + 1) & (MOVE_HISTORY_CAPACITY - 1);
+    if (self->count < MOVE_HISTORY_CAPACITY)
+        self->count++;
+}
+
+/// @brief Retire le coup le plus récent de l'historique.
+/// @param self L'historique.
+/// @param data Adresse où est écrit le coup retiré (peut être NULL).
+/// @return false si l'historique est vide.
+INLINE bool MoveHistory_pop(MoveHistory *self, QuoridorData *data)
+{
+    if (self->count == 0)
+        return false;
+
+    self->head = (self->head - 1) & (MOVE_HISTORY_CAPACITY - 1);
+    self->count--;
+    if (data) *data = self->data[self->head];
+    return true;
+}
+
+/// @brief Renvoie un coup de l'historique.
+/// @param self L'historique.
+/// @param index Ancienneté du coup (0 pour le plus récent), inférieure à MoveHistory_getCount().
+/// @return Le coup.
+INLINE const QuoridorData *MoveHistory_get(const MoveHistory *self, int index)
+{
+    assert(0 <= index && index < self->count);
+    return &(self->data[(self->head - 1 - index) & (MOVE_HISTORY_CAPACITY - 1)]);
+}
+
+/// @brief Crée un itérateur placé sur le coup le plus récent.
+/// @param self L'historique.
+INLINE MoveHistoryIter MoveHistory_begin(const MoveHistory *self)
+{
+    MoveHistoryIter iter = { self, 0 };
+    return iter;
+}
+
+/// @brief Renvoie le coup courant de l'itérateur puis passe au coup précédent.
+/// @param self L'itérateur.
+/// @return Le coup, ou NULL une fois le plus ancien coup dépassé.
+INLINE const QuoridorData *MoveHistoryIter_next(MoveHistoryIter *self)
+{
+    if (self->index >= self->history->count)
+        return NULL;
+    return MoveHistory_get(self->history, self->index++);
+}
@@ -0,0 +1,311 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/opening_book.h"
+
+static const char g_openingBookMagic[4] = { 'Q', 'B', 'O', 'K' };
+
+/// @brief Nombre de pas de la recherche par interpolation avant de passer
+/// à la dichotomie, qui garantit un nombre de pas logarithmique.
+#define OPENING_BOOK_INTERPOLATION_STEPS 8
+
+struct OpeningBookBuilder
+{
+    /// @brief Table de hachage à adressage ouvert des coups (case vide si gameCount == 0).
+    OpeningBookEntry *entries;
+    int capacity;
+    int entryCount;
+
+    /// @brief Nombre de parties ajoutées.
+    int gameCount;
+
+    /// @brief Nombre de plies retenus au début de chaque partie.
+    int maxPlies;
+};
+
+Uint64 OpeningBook_getKey(QuoridorCore *core)
+{
+    const Uint64 extra = ((Uint64)core->gridSize << 16) | ((Uint64)core->wallCounts[0] << 8) | (Uint64)core->wallCounts[1];
+    return core->hash ^ Rng_mix(~extra);
+}
+
+OpeningBook *OpeningBook_open(const char *path)
+{
+    MappedFile *file = MappedFile_open(path);
+    if (file == NULL)
+        return NULL;
+
+    const OpeningBookHeader *header = (const OpeningBookHeader *)file->data;
+    if (file->size < sizeof(OpeningBookHeader) ||
+        memcmp(header->magic, g_openingBookMagic, sizeof(header->magic)) != 0 ||
+        header->version != OPENING_BOOK_VERSION ||
+        file->size != sizeof(OpeningBookHeader) + (size_t)header->entryCount * sizeof(OpeningBookEntry))
+    {
+        MappedFile_close(file);
+        return NULL;
+    }
+
+    OpeningBook *self = (OpeningBook *)calloc(1, sizeof(OpeningBook));
+    AssertNew(self);
+
+    self->file = file;
+    self->entries = (const OpeningBookEntry *)(file->data + sizeof(OpeningBookHeader));
+    self->entryCount = (int)header->entryCount;
+    self->positionCount = (int)header->positionCount;
+    self->gameCount = (int)header->gameCount;
+    self->maxPlies = (int)header->maxPlies;
+    return self;
+}
+
+void OpeningBook_close(OpeningBook *self)
+{
+    if (!self) return;
+    MappedFile_close(self->file);
+    free(self);
+}
+
+/// @brief Renvoie l'indice du premier coup d'une clé, ou -1 si la clé est absente.
+static int OpeningBook_findKey(OpeningBook *self, Uint64 key)
+{
+    const OpeningBookEntry *entries = self->entries;
+    int lo = 0, hi = self->entryCount - 1;
+
+    for (int step = 0; lo <= hi; step++)
+    {
+        const Uint64 first = entries[lo].key;
+        const Uint64 last = entries[hi].key;
+        if (key < first || key > last)
+            return -1;
+
+        // Les clés étant uniformes, la clé est cherchée à sa place attendue entre les bornes
+        int mid = lo + (hi - lo) / 2;
+        if (first == last)
+            mid = lo;
+        else if (step < OPENING_BOOK_INTERPOLATION_STEPS)
+            mid = lo + (int)((double)(key - first) / (double)(last - first) * (double)(hi - lo));
+        mid = Int_clamp(mid, lo, hi);
+
+        if (entries[mid].key < key)
+            lo = mid + 1;
+        else if (entries[mid].key > key)
+            hi = mid - 1;
+        else
+        {
+            while (mid > 0 && entries[mid - 1].key == key)
+                mid--;
+            return mid;
+        }
+    }
+    return -1;
+}
+
+const OpeningBookEntry *OpeningBook_find(OpeningBook *self, QuoridorCore *core, int *count)
+{
+    assert(self && count);
+    *count = 0;
+
+    const Uint64 key = OpeningBook_getKey(core);
+    const int first = OpeningBook_findKey(self, key);
+    if (first < 0)
+        return NULL;
+
+    int last = first;
+    while (last < self->entryCount && self->entries[last].key == key)
+        last++;
+    *count = last - first;
+    return &(self->entries[first]);
+}
+
+bool OpeningBook_chooseTurn(OpeningBook *self, QuoridorCore *core, Rng *rng, QuoridorTurn *turn, const OpeningBookEntry **entry)
+{
+    assert(self && rng && turn);
+    if (core->playerCount != 2 || core->state != QUORIDOR_STATE_IN_PROGRESS)
+        return false;
+
+    int count = 0;
+    const OpeningBookEntry *entries = OpeningBook_find(self, core, &count);
+
+    // Une collision de clés ne doit pas faire jouer un coup illégal
+    Uint64 totalWeight = 0;
+    for (int k = 0; k < count; k++)
+    {
+        const QuoridorTurn candidate = { entries[k].action, entries[k].i, entries[k].j };
+        if (QuoridorCore_canPlayTurn(core, candidate))
+            totalWeight += entries[k].weight;
+    }
+    if (totalWeight == 0)
+        return false;
+
+    Uint64 target = (((Uint64)Rng_next(rng) << 32) | Rng_next(rng)) % totalWeight;
+    for (int k = 0; k < count; k++)
+    {
+        const QuoridorTurn candidate = { entries[k].action, entries[k].i, entries[k].j };
+        if (!QuoridorCore_canPlayTurn(core, candidate))
+            continue;
+        if (target < entries[k].weight)
+        {
+            *turn = candidate;
+            if (entry) *entry = &entries[k];
+            return true;
+        }
+        target -= entries[k].weight;
+    }
+    assert(false);
+    return false;
+}
+
+OpeningBookBuilder *OpeningBookBuilder_create(int maxPlies)
+{
+    OpeningBookBuilder *self = (OpeningBookBuilder *)calloc(1, sizeof(OpeningBookBuilder));
+    AssertNew(self);
+
+    self->capacity = 1 << 12;
+    self->entries = (OpeningBookEntry *)calloc(self->capacity, sizeof(OpeningBookEntry));
+    AssertNew(self->entries);
+    self->maxPlies = maxPlies;
+    return self;
+}
+
+void OpeningBookBuilder_destroy(OpeningBookBuilder *self)
+{
+    if (!self) return;
+    free(self->entries);
+    free(self);
+}
+
+/// @brief Renvoie la case d'un coup dans la table de hachage (vide s'il n'y est pas encore).
+static OpeningBookEntry *OpeningBookBuilder_getEntry(OpeningBookBuilder *self, Uint64 key, QuoridorTurn turn)
+{
+    const Uint64 move = ((Uint64)turn.action << 16) | ((Uint64)turn.i << 8) | (Uint64)turn.j;
+    const int mask = self->capacity - 1;
+    int index = (int)(Rng_mix(key ^ move) & mask);
+    while (true)
+    {
+        OpeningBookEntry *entry = &(self->entries[index]);
+        if (entry->gameCount == 0)
+            return entry;
+        if (entry->key == key && entry->action == turn.action && entry->i == turn.i && entry->j == turn.j)
+            return entry;
+        index = (index + 1) & mask;
+    }
+}
+
+/// @brief Double la capacité de la table de hachage.
+static void OpeningBookBuilder_grow(OpeningBookBuilder *self)
+{
+    OpeningBookEntry *prevEntries = self->entries;
+    const int prevCapacity = self->capacity;
+
+    self->capacity *= 2;
+    self->entries = (OpeningBookEntry *)calloc(self->capacity, sizeof(OpeningBookEntry));
+    AssertNew(self->entries);
+
+    for (int k = 0; k < prevCapacity; k++)
+    {
+        if (prevEntries[k].gameCount == 0)
+            continue;
+        const QuoridorTurn turn = { prevEntries[k].action, prevEntries[k].i, prevEntries[k].j };
+        *OpeningBookBuilder_getEntry(self, prevEntries[k].key, turn) = prevEntries[k];
+    }
+    free(prevEntries);
+}
+
+bool OpeningBookBuilder_addGame(
+    OpeningBookBuilder *self, QuoridorCore *start, const QuoridorTurn *turns, int turnCount, QuoridorState result)
+{
+    assert(self && start && (turns || turnCount == 0));
+    if (start->playerCount != 2)
+        return false;
+
+    QuoridorCore core = *start;
+    const int plyCount = Int_min(turnCount, self->maxPlies);
+    for (int ply = 0; ply < plyCount && core.state == QUORIDOR_STATE_IN_PROGRESS; ply++)
+    {
+        if (!QuoridorCore_canPlayTurn(&core, turns[ply]))
+            break;
+
+        // La table reste au plus à moitié pleine
+        if (2 * (self->entryCount + 1) > self->capacity)
+            OpeningBookBuilder_grow(self);
+
+        const Uint64 key = OpeningBook_getKey(&core);
+        OpeningBookEntry *entry = OpeningBookBuilder_getEntry(self, key, turns[ply]);
+        if (entry->gameCount == 0)
+        {
+            entry->key = key;
+            entry->action = (Uint8)turns[ply].action;
+            entry->i = (Uint8)turns[ply].i;
+            entry->j = (Uint8)turns[ply].j;
+            self->entryCount++;
+        }
+        entry->gameCount++;
+        if (result == QUORIDOR_STATE_IN_PROGRESS)
+            entry->drawCount++;
+        else if (result - QUORIDOR_STATE_P0_WON == core.playerID)
+            entry->winCount++;
+
+        QuoridorCore_playTurn(&core, turns[ply]);
+    }
+    self->gameCount++;
+    return true;
+}
+
+/// @brief Ordre du fichier : clé croissante, puis poids décroissant.
+static int OpeningBookEntry_compare(const void *a, const void *b)
+{
+    const OpeningBookEntry *entryA = (const OpeningBookEntry *)a;
+    const OpeningBookEntry *entryB = (const OpeningBookEntry *)b;
+    if (entryA->key != entryB->key)
+        return (entryA->key < entryB->key) ? -1 : 1;
+    if (entryA->weight != entryB->weight)
+        return (entryA->weight > entryB->weight) ? -1 : 1;
+    return 0;
+}
+
+bool OpeningBookBuilder_write(OpeningBookBuilder *self, const char *path, int minGames)
+{
+    assert(self && path);
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+        return false;
+
+    OpeningBookEntry *entries = (OpeningBookEntry *)calloc(Int_max(self->entryCount, 1), sizeof(OpeningBookEntry));
+    AssertNew(entries);
+
+    int entryCount = 0;
+    for (int k = 0; k < self->capacity; k++)
+    {
+        OpeningBookEntry entry = self->entries[k];
+        if (entry.gameCount == 0 || (int)entry.gameCount < minGames)
+            continue;
+        entry.weight = 2 * entry.winCount + entry.drawCount;
+        entries[entryCount++] = entry;
+    }
+    qsort(entries, entryCount, sizeof(OpeningBookEntry), OpeningBookEntry_compare);
+
+    int positionCount = 0;
+    for (int k = 0; k < entryCount; k++)
+    {
+        if (k == 0 || entries[k].key != entries[k - 1].key)
+            positionCount++;
+    }
+
+    OpeningBookHeader header = { 0 };
+    memcpy(header.magic, g_openingBookMagic, sizeof(header.magic));
+    header.version = OPENING_BOOK_VERSION;
+    header.entryCount = entryCount;
+    header.positionCount = positionCount;
+    header.gameCount = self->gameCount;
+    header.maxPlies = self->maxPlies;
+
+    bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+    success = success && fwrite(entries, sizeof(OpeningBookEntry), entryCount, file) == (size_t)entryCount;
+    success = (fclose(file) == 0) && success;
+
+    free(entries);
+    return success;
+}
@@ -0,0 +1,152 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+#include "core/mapped_file.h"
+#include "core/utils.h"
+
+// Format du fichier de bibliothèque d'ouvertures.
+//
+// Un fichier commence par un en-tête OpeningBookHeader, suivi de entryCount OpeningBookEntry
+// triés par clé de position (voir OpeningBook_getKey()), puis par poids décroissant :
+// les coups d'une même position sont consécutifs. Les clés de Zobrist étant réparties
+// uniformément, une position est retrouvée par recherche par interpolation.
+// Le fichier est projeté en mémoire tel quel, sans lecture ni décodage à l'ouverture.
+
+/// @brief Version du format écrite dans l'en-tête.
+#define OPENING_BOOK_VERSION 1
+
+/// @brief En-tête du fichier.
+typedef struct OpeningBookHeader
+{
+    /// @brief "QBOK".
+    char magic[4];
+
+    /// @brief OPENING_BOOK_VERSION.
+    Uint32 version;
+
+    /// @brief Nombre de coups de la bibliothèque.
+    Uint32 entryCount;
+
+    /// @brief Nombre de positions de la bibliothèque.
+    Uint32 positionCount;
+
+    /// @brief Nombre de parties dont la bibliothèque est issue.
+    Uint32 gameCount;
+
+    /// @brief Nombre de plies retenus au début de chaque partie.
+    Uint32 maxPlies;
+} OpeningBookHeader;
+
+/// @brief Coup d'une position de la bibliothèque et ses statistiques.
+typedef struct OpeningBookEntry
+{
+    /// @brief Clé de la position (voir OpeningBook_getKey()).
+    Uint64 key;
+
+    /// @brief Poids du coup : 2 par victoire et 1 par nulle du joueur qui le joue.
+    /// Un coup de poids nul n'est jamais choisi.
+    Uint32 weight;
+
+    /// @brief Nombre de parties où le coup a été joué, gagnées et nulles
+    /// (du point de vue du joueur qui le joue).
+    Uint32 gameCount;
+    Uint32 winCount;
+    Uint32 drawCount;
+
+    /// @brief Action (QuoridorAction), ligne et colonne du coup.
+    Uint8 action;
+    Uint8 i;
+    Uint8 j;
+    Uint8 reserved[5];
+} OpeningBookEntry;
+
+/// @brief Bibliothèque d'ouvertures des parties à deux joueurs : coups joués dans les premières
+/// positions de parties enregistrées, avec leurs résultats. La bibliothèque est lue dans un fichier
+/// projeté en mémoire, partagé en lecture seule par toutes les IA et tous les threads.
+typedef struct OpeningBook
+{
+    /// @brief Fichier projeté.
+    MappedFile *file;
+
+    /// @brief Coups, triés par clé.
+    const OpeningBookEntry *entries;
+    int entryCount;
+
+    /// @brief Nombre de positions.
+    int positionCount;
+
+    /// @brief Nombre de parties dont la bibliothèque est issue.
+    int gameCount;
+
+    /// @brief Nombre de plies retenus au début de chaque partie.
+    int maxPlies;
+} OpeningBook;
+
+/// @brief Construit une bibliothèque à partir de parties (voir OpeningBookBuilder_addGame()).
+typedef struct OpeningBookBuilder OpeningBookBuilder;
+
+/// @brief Renvoie la clé d'une position dans la bibliothèque : la clé de Zobrist
+/// de la position, complétée par la taille de la grille et les murs restants.
+/// @param core La position.
+/// @return La clé.
+Uint64 OpeningBook_getKey(QuoridorCore *core);
+
+/// @brief Ouvre une bibliothèque.
+/// @param path Chemin du fichier.
+/// @return La bibliothèque, ou NULL si le fichier ne peut pas être ouvert ou n'est pas une bibliothèque.
+OpeningBook *OpeningBook_open(const char *path);
+
+/// @brief Ferme une bibliothèque.
+/// @param self La bibliothèque.
+void OpeningBook_close(OpeningBook *self);
+
+/// @brief Cherche les coups d'une position.
+/// @param self La bibliothèque.
+/// @param core La position.
+/// @param count Adresse où est écrit le nombre de coups de la position.
+/// @return Le premier coup de la position (les suivants sont consécutifs, par poids décroissant),
+/// ou NULL si la position n'est pas dans la bibliothèque.
+const OpeningBookEntry *OpeningBook_find(OpeningBook *self, QuoridorCore *core, int *count);
+
+/// @brief Choisit un coup d'une position de la bibliothèque au hasard, avec une probabilité
+/// proportionnelle à son poids. Seules les parties à deux joueurs en cours sont cherchées.
+/// @param self La bibliothèque.
+/// @param core La position.
+/// @param rng Générateur utilisé pour le tirage.
+/// @param turn Adresse où est écrit le coup choisi.
+/// @param entry Adresse où est écrite l'entrée du coup choisi (peut être NULL).
+/// @return false si la position n'a aucun coup de poids non nul.
+bool OpeningBook_chooseTurn(OpeningBook *self, QuoridorCore *core, Rng *rng, QuoridorTurn *turn, const OpeningBookEntry **entry);
+
+/// @brief Crée un constructeur de bibliothèque.
+/// @param maxPlies Nombre de plies retenus au début de chaque partie.
+/// @return Le constructeur créé.
+OpeningBookBuilder *OpeningBookBuilder_create(int maxPlies);
+
+/// @brief Détruit un constructeur de bibliothèque.
+/// @param self Le constructeur.
+void OpeningBookBuilder_destroy(OpeningBookBuilder *self);
+
+/// @brief Ajoute les premiers coups d'une partie à deux joueurs (les autres parties sont ignorées).
+/// @param self Le constructeur.
+/// @param start Position de départ de la partie.
+/// @param turns Coups de la partie.
+/// @param turnCount Nombre de coups.
+/// @param result État final de la partie (une partie non terminée compte comme nulle).
+/// @return false si la partie est ignorée.
+bool OpeningBookBuilder_addGame(
+    OpeningBookBuilder *self, QuoridorCore *start, const QuoridorTurn *turns, int turnCount, QuoridorState result);
+
+/// @brief Écrit la bibliothèque dans un fichier.
+/// @param self Le constructeur.
+/// @param path Chemin du fichier.
+/// @param minGames Nombre minimal de parties où un coup a été joué pour être gardé.
+/// @return false si le fichier ne peut pas être écrit.
+bool OpeningBookBuilder_write(OpeningBookBuilder *self, const char *path, int minGames);
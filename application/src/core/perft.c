@@ -0,0 +1,133 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/perft.h"
+
+static Uint64 Perft_countFast(QuoridorCore *self, int depth)
+{
+    if (depth <= 0 || self->state != QUORIDOR_STATE_IN_PROGRESS)
+        return 1;
+
+    QuoridorTurn turns[MAX_TURN_COUNT];
+    const int turnCount = QuoridorCore_getTurns(self, turns);
+
+    // Au dernier niveau, seul le nombre d'actions compte
+    if (depth == 1)
+        return (Uint64)turnCount;
+
+    Uint64 count = 0;
+    for (int k = 0; k < turnCount; k++)
+    {
+        QuoridorUndo undo;
+        QuoridorCore_makeTurn(self, turns[k], &undo);
+        count += Perft_countFast(self, depth - 1);
+        QuoridorCore_unmakeTurn(self, &undo);
+    }
+    return count;
+}
+
+/// @brief Liste les actions comme le fait la recherche min-max
+/// (balayage de isValid puis de tous les murs).
+static int Perft_getTurnsReference(QuoridorCore *self, QuoridorTurn *turns)
+{
+    const int gridSize = self->gridSize;
+    int count = 0;
+
+    for (int i = 0; i < MAX_GRID_SIZE; i++)
+    {
+        for (int j = 0; j < MAX_GRID_SIZE; j++)
+        {
+            if (QuoridorCore_canMoveTo(self, i, j))
+            {
+                turns[count].action = QUORIDOR_MOVE_TO;
+                turns[count].i = i;
+                turns[count].j = j;
+                count++;
+            }
+        }
+    }
+
+    if (self->state != QUORIDOR_STATE_IN_PROGRESS) return count;
+
+    for (int i = 0; i < gridSize - 1; i++)
+    {
+        for (int j = 0; j < gridSize - 1; j++)
+        {
+            if (QuoridorCore_canPlayWall(self, WALL_TYPE_HORIZONTAL, i, j))
+            {
+                turns[count].action = QUORIDOR_PLAY_HORIZONTAL_WALL;
+                turns[count].i = i;
+                turns[count].j = j;
+                count++;
+            }
+            if (QuoridorCore_canPlayWall(self, WALL_TYPE_VERTICAL, i, j))
+            {
+                turns[count].action = QUORIDOR_PLAY_VERTICAL_WALL;
+                turns[count].i = i;
+                turns[count].j = j;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+static Uint64 Perft_countReference(QuoridorCore *self, int depth)
+{
+    if (depth <= 0 || self->state != QUORIDOR_STATE_IN_PROGRESS)
+        return 1;
+
+    QuoridorTurn turns[MAX_TURN_COUNT];
+    const int turnCount = Perft_getTurnsReference(self, turns);
+
+    Uint64 count = 0;
+    for (int k = 0; k < turnCount; k++)
+    {
+        QuoridorCore copy = *self;
+        QuoridorCore_playTurn(&copy, turns[k]);
+        count += Perft_countReference(&copy, depth - 1);
+    }
+    return count;
+}
+
+Uint64 Perft_count(QuoridorCore *self, int depth, PerftMode mode)
+{
+    assert(self && "The QuoridorCore must be created");
+    if (mode == PERFT_MODE_REFERENCE)
+        return Perft_countReference(self, depth);
+    return Perft_countFast(self, depth);
+}
+
+int Perft_divide(QuoridorCore *self, int depth, PerftMode mode, PerftEntry *entries)
+{
+    assert(self && "The QuoridorCore must be created");
+    assert(depth >= 1);
+
+    QuoridorTurn turns[MAX_TURN_COUNT];
+    const int turnCount = (mode == PERFT_MODE_REFERENCE) ?
+        Perft_getTurnsReference(self, turns) :
+        QuoridorCore_getTurns(self, turns);
+
+    for (int k = 0; k < turnCount; k++)
+    {
+        entries[k].turn = turns[k];
+
+        if (mode == PERFT_MODE_REFERENCE)
+        {
+            QuoridorCore copy = *self;
+            QuoridorCore_playTurn(&copy, turns[k]);
+            entries[k].count = Perft_countReference(&copy, depth - 1);
+        }
+        else
+        {
+            QuoridorUndo undo;
+            QuoridorCore_makeTurn(self, turns[k], &undo);
+            entries[k].count = Perft_countFast(self, depth - 1);
+            QuoridorCore_unmakeTurn(self, &undo);
+        }
+    }
+    return turnCount;
+}
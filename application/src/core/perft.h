@@ -0,0 +1,53 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+
+/// @brief Méthode utilisée pour parcourir l'arbre de jeu.
+typedef enum PerftMode
+{
+    /// @brief Génération avec QuoridorCore_getTurns() et parcours sur place
+    /// avec QuoridorCore_makeTurn() / QuoridorCore_unmakeTurn().
+    PERFT_MODE_FAST,
+
+    /// @brief Génération avec QuoridorCore_canMoveTo() / QuoridorCore_canPlayWall()
+    /// et parcours par copie du plateau avec QuoridorCore_playTurn(),
+    /// comme dans la recherche min-max.
+    PERFT_MODE_REFERENCE,
+} PerftMode;
+
+/// @brief Nombre de feuilles sous une action de la racine.
+typedef struct PerftEntry
+{
+    /// @brief Action jouée à la racine.
+    QuoridorTurn turn;
+
+    /// @brief Nombre de positions feuilles atteintes après cette action.
+    Uint64 count;
+} PerftEntry;
+
+/// @brief Compte les positions feuilles à une profondeur donnée.
+/// Une position où la partie est terminée compte comme une feuille,
+/// même si la profondeur n'est pas atteinte.
+/// Le plateau est identique avant et après l'appel.
+/// @param self Instance du jeu Quoridor.
+/// @param depth Profondeur (en demi-coups).
+/// @param mode Méthode de parcours.
+/// @return Le nombre de positions feuilles.
+Uint64 Perft_count(QuoridorCore *self, int depth, PerftMode mode);
+
+/// @brief Compte les positions feuilles séparément pour chaque action de la racine.
+/// Les actions sont listées dans l'ordre de QuoridorCore_getTurns(),
+/// quel que soit le mode.
+/// @param self Instance du jeu Quoridor.
+/// @param depth Profondeur (en demi-coups, au moins 1).
+/// @param mode Méthode de parcours.
+/// @param entries Tableau (préalloué, taille MAX_TURN_COUNT) des résultats.
+/// @return Le nombre d'actions de la racine.
+int Perft_divide(QuoridorCore *self, int depth, PerftMode mode, PerftEntry *entries);
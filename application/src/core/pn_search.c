@@ -0,0 +1,392 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/pn_search.h"
+#include "core/quoridor_ai.h"
+#include "core/utils.h"
+#include "core/trace.h"
+
+PNSearch *PNSearch_create()
+{
+    PNSearch *self = (PNSearch *)calloc(1, sizeof(PNSearch));
+    AssertNew(self);
+
+    self->entries = (PNEntry *)calloc(PN_TABLE_CAPACITY, sizeof(PNEntry));
+    self->turns = (QuoridorTurn *)calloc((size_t)PN_MAX_DEPTH * MAX_TURN_COUNT, sizeof(QuoridorTurn));
+    self->keys = (Uint64 *)calloc((size_t)PN_MAX_DEPTH * MAX_TURN_COUNT, sizeof(Uint64));
+    AssertNew(self->entries);
+    AssertNew(self->turns);
+    AssertNew(self->keys);
+
+    return self;
+}
+
+void PNSearch_destroy(PNSearch *self)
+{
+    if (!self) return;
+    free(self->entries);
+    free(self->turns);
+    free(self->keys);
+    free(self);
+}
+
+void PNSearch_clear(PNSearch *self)
+{
+    if (!self) return;
+    memset(self->entries, 0, PN_TABLE_CAPACITY * sizeof(PNEntry));
+}
+
+bool PNSearch_canSearch(QuoridorCore *core, int attackerID)
+{
+    if (core->playerCount != 2 || core->state != QUORIDOR_STATE_IN_PROGRESS)
+        return false;
+
+    const int wallCount = core->wallCounts[attackerID];
+    return core->wallCounts[attackerID ^ 1] == 0 && wallCount >= 1 && wallCount <= PN_MAX_WALLS;
+}
+
+/// @brief Renvoie la clé d'une position pour un attaquant. QuoridorCore::hash ne contient
+/// pas les murs restants, qui changent pourtant le résultat.
+static Uint64 PNSearch_getKey(QuoridorCore *core, int attackerID)
+{
+    const Uint64 extra = ((Uint64)attackerID << 16) | ((Uint64)core->wallCounts[0] << 8) | (Uint64)core->wallCounts[1];
+    const Uint64 key = core->hash ^ Rng_mix(extra);
+    return key ? key : 1;
+}
+
+/// @brief Somme de nombres de preuve, saturée : l'infini est absorbant
+/// et une somme finie reste en dessous de l'infini.
+static Uint32 PNSearch_add(Uint32 a, Uint32 b)
+{
+    if (a >= PN_INFINITY || b >= PN_INFINITY)
+        return PN_INFINITY;
+    return (Uint32)Int_min((int)(a + b), (int)PN_INFINITY - 1);
+}
+
+/// @brief Lit les nombres de preuve d'une position ((1, 1) si elle est absente de la table).
+static PNEntry PNSearch_lookup(PNSearch *self, Uint64 key)
+{
+    const PNEntry entry = self->entries[key & (PN_TABLE_CAPACITY - 1)];
+    if (entry.key == key)
+        return entry;
+    return (PNEntry) { key, 1, 1 };
+}
+
+/// @brief Enregistre les nombres de preuve d'une position.
+/// Une position résolue n'est remplacée que par une autre position résolue.
+static void PNSearch_store(PNSearch *self, Uint64 key, Uint32 proof, Uint32 disproof)
+{
+    PNEntry *entry = &(self->entries[key & (PN_TABLE_CAPACITY - 1)]);
+    const bool solved = (proof == 0 || disproof == 0);
+    if (entry->key != key && entry->key != 0 && (entry->proof == 0 || entry->disproof == 0) && !solved)
+        return;
+
+    entry->key = key;
+    entry->proof = proof;
+    entry->disproof = disproof;
+}
+
+/// @brief Vérifie si la recherche doit s'arrêter (budget, demande d'arrêt ou limite de temps).
+static bool PNSearch_isStopped(PNSearch *self)
+{
+    if (self->aborted)
+        return true;
+    if (self->nodeCount >= self->maxNodes)
+        self->aborted = true;
+    else if ((self->nodeCount & 63) == 0)
+    {
+        AIData *aiData = self->aiData;
+        self->aborted = SDL_GetAtomicInt(&(aiData->stopRequested))
+            || (aiData->deadline && SDL_GetPerformanceCounter() >= aiData->deadline);
+    }
+    return self->aborted;
+}
+
+/// @brief Renvoie la longueur du plus court chemin d'un joueur (les pions ne bloquent pas le chemin).
+static int PNSearch_getDistance(QuoridorCore *core, int playerID)
+{
+    QuoridorPos path[MAX_PATH_LEN];
+#ifndef A_STAR
+    return BFS_search2(core, playerID, path);
+#else
+    return AStar_search(core, playerID, path);
+#endif
+}
+
+/// @brief Génère les actions explorées pour le joueur courant : tous les déplacements,
+/// puis les meilleurs murs de l'attaquant (voir getBestWall()) s'il n'a pas plus de
+/// PN_WALL_MAX_LEAD pas d'avance dans la course ; au-delà, ses murs multiplient les positions
+/// à prouver sans être nécessaires à la victoire.
+/// @param distance Longueur du plus court chemin de l'attaquant.
+/// @return Le nombre d'actions.
+static int PNSearch_getTurns(PNSearch *self, QuoridorCore *core, int distance, QuoridorTurn *turns)
+{
+    int turnCount = 0;
+    for (int i = 0; i < core->gridSize; i++)
+    {
+        for (int j = 0; j < core->gridSize; j++)
+        {
+            if (!core->isValid[i][j])
+                continue;
+            turns[turnCount].action = QUORIDOR_MOVE_TO;
+            turns[turnCount].i = i;
+            turns[turnCount].j = j;
+            turnCount++;
+        }
+    }
+
+    if (core->playerID != self->attackerID || core->wallCounts[core->playerID] == 0)
+        return turnCount;
+    if (PNSearch_getDistance(core, core->playerID ^ 1) - distance + 1 > PN_WALL_MAX_LEAD)
+        return turnCount;
+
+    QuoridorWall walls[MAX_BEST_WALLS];
+    int wallCount = 0;
+    getBestWall(core, core->playerID, core->playerID ^ 1, 999, walls, &wallCount, NULL);
+    for (int m = 0; m < Int_min(wallCount, PN_ATTACKER_WALLS); m++)
+    {
+        turns[turnCount].action = (walls[m].type == WALL_TYPE_HORIZONTAL) ?
+            QUORIDOR_PLAY_HORIZONTAL_WALL : QUORIDOR_PLAY_VERTICAL_WALL;
+        turns[turnCount].i = walls[m].pos.i;
+        turns[turnCount].j = walls[m].pos.j;
+        turnCount++;
+    }
+    return turnCount;
+}
+
+/// @brief Estime les nombres de preuve d'une position nouvelle : la preuve croît avec
+/// la distance de l'attaquant et son retard dans la course (différence des distances,
+/// plus un pas pour le joueur qui doit jouer), la réfutation avec son avance.
+static PNEntry PNSearch_estimate(PNSearch *self, QuoridorCore *core, Uint64 key, int attackerDistance)
+{
+    const int defenderDistance = PNSearch_getDistance(core, self->attackerID ^ 1);
+    const int lead = defenderDistance - attackerDistance + (core->playerID == self->attackerID ? 1 : 0);
+    const int proof = attackerDistance + 2 * Int_max(0, 1 - lead);
+    return (PNEntry) { key, (Uint32)Int_max(1, proof), (Uint32)Int_max(1, lead) };
+}
+
+/// @brief Génère les enfants d'une position dans les tableaux d'un ply : actions (voir PNSearch_getTurns())
+/// et clés. Les fins de partie et les enfants absents de la table y sont enregistrés.
+/// L'attaquant ne s'éloigne pas de son arrivée : la recherche reste exacte pour une preuve
+/// et aucune position ne se répète, car chacun de ses coups raccourcit son chemin ou pose un mur.
+/// @return Le nombre d'enfants.
+static int PNSearch_generate(PNSearch *self, QuoridorCore *core, int ply)
+{
+    QuoridorTurn *turns = self->turns + (size_t)ply * MAX_TURN_COUNT;
+    Uint64 *keys = self->keys + (size_t)ply * MAX_TURN_COUNT;
+    const int attackerID = self->attackerID;
+    const bool attacking = (core->playerID == attackerID);
+    const int distance = PNSearch_getDistance(core, attackerID);
+    const int generatedCount = PNSearch_getTurns(self, core, distance, turns);
+    int turnCount = 0;
+
+    for (int t = 0; t < generatedCount; t++)
+    {
+        QuoridorUndo undo;
+        QuoridorCore_makeTurn(core, turns[t], &undo);
+        const int childDistance = (turns[t].action == QUORIDOR_MOVE_TO && attacking) ?
+            PNSearch_getDistance(core, attackerID) : distance;
+
+        if (attacking && turns[t].action == QUORIDOR_MOVE_TO && childDistance >= distance
+            && core->state == QUORIDOR_STATE_IN_PROGRESS)
+        {
+            QuoridorCore_unmakeTurn(core, &undo);
+            continue;
+        }
+
+        turns[turnCount] = turns[t];
+        keys[turnCount] = PNSearch_getKey(core, attackerID);
+        if (core->state != QUORIDOR_STATE_IN_PROGRESS)
+        {
+            const bool won = (core->state - QUORIDOR_STATE_P0_WON == attackerID);
+            PNSearch_store(self, keys[turnCount], won ? 0 : PN_INFINITY, won ? PN_INFINITY : 0);
+        }
+        else if (self->entries[keys[turnCount] & (PN_TABLE_CAPACITY - 1)].key != keys[turnCount])
+        {
+            const int childAttackerDistance = (turns[t].action == QUORIDOR_MOVE_TO) ?
+                childDistance : PNSearch_getDistance(core, attackerID);
+            const PNEntry estimate = PNSearch_estimate(self, core, keys[turnCount], childAttackerDistance);
+            PNSearch_store(self, keys[turnCount], estimate.proof, estimate.disproof);
+        }
+        QuoridorCore_unmakeTurn(core, &undo);
+        turnCount++;
+    }
+
+    return turnCount;
+}
+
+/// @brief Développe une position jusqu'à ce que son nombre de preuve atteigne proofLimit
+/// ou son nombre de réfutation disproofLimit (Multiple Iterative Deepening de df-pn).
+/// L'attaquant choisit l'enfant de plus petit nombre de preuve et son adversaire celui
+/// de plus petit nombre de réfutation ; les limites de l'enfant s'arrêtent là où
+/// le deuxième meilleur enfant le dépasserait.
+static void PNSearch_expand(PNSearch *self, QuoridorCore *core, int ply, Uint32 proofLimit, Uint32 disproofLimit)
+{
+    const Uint64 key = PNSearch_getKey(core, self->attackerID);
+    self->nodeCount++;
+
+    if (core->state != QUORIDOR_STATE_IN_PROGRESS)
+    {
+        const bool won = (core->state - QUORIDOR_STATE_P0_WON == self->attackerID);
+        PNSearch_store(self, key, won ? 0 : PN_INFINITY, won ? PN_INFINITY : 0);
+        return;
+    }
+
+    // Trop profond : la position est comptée comme non gagnée
+    if (ply >= PN_MAX_DEPTH)
+    {
+        PNSearch_store(self, key, PN_INFINITY, 0);
+        return;
+    }
+
+    if (self->entries[key & (PN_TABLE_CAPACITY - 1)].key == key)
+        self->aiData->stats.ttHits++;
+
+    QuoridorTurn *turns = self->turns + (size_t)ply * MAX_TURN_COUNT;
+    Uint64 *keys = self->keys + (size_t)ply * MAX_TURN_COUNT;
+    const bool attacking = (core->playerID == self->attackerID);
+    const int turnCount = PNSearch_generate(self, core, ply);
+
+    Uint32 proof = 0, disproof = 0;
+    while (true)
+    {
+        // Nombres du noeud, meilleur enfant et deuxième meilleure valeur
+        // (preuve pour l'attaquant, réfutation pour son adversaire)
+        int best = -1;
+        Uint32 bestValue = PN_INFINITY, secondValue = PN_INFINITY;
+        Uint32 bestOther = 0;
+        proof = attacking ? PN_INFINITY : 0;
+        disproof = attacking ? 0 : PN_INFINITY;
+
+        for (int t = 0; t < turnCount; t++)
+        {
+            const PNEntry child = PNSearch_lookup(self, keys[t]);
+            const Uint32 value = attacking ? child.proof : child.disproof;
+            const Uint32 other = attacking ? child.disproof : child.proof;
+            if (attacking)
+            {
+                proof = Int_min(proof, child.proof);
+                disproof = PNSearch_add(disproof, child.disproof);
+            }
+            else
+            {
+                proof = PNSearch_add(proof, child.proof);
+                disproof = Int_min(disproof, child.disproof);
+            }
+
+            if (best < 0 || value < bestValue)
+            {
+                secondValue = bestValue;
+                bestValue = value;
+                bestOther = other;
+                best = t;
+            }
+            else if (value < secondValue)
+            {
+                secondValue = value;
+            }
+        }
+
+        if (proof >= proofLimit || disproof >= disproofLimit || PNSearch_isStopped(self))
+            break;
+
+        // Limites de l'enfant : il reste le meilleur tant que sa valeur ne dépasse pas
+        // la deuxième, et la somme des autres nombres doit rester sous la limite du noeud
+        Uint32 childProof, childDisproof;
+        if (attacking)
+        {
+            childProof = Int_min(proofLimit, PNSearch_add(secondValue, 1));
+            childDisproof = (Uint32)Int_min((int)PN_INFINITY - 1, (int)(disproofLimit - disproof + bestOther));
+        }
+        else
+        {
+            childDisproof = Int_min(disproofLimit, PNSearch_add(secondValue, 1));
+            childProof = (Uint32)Int_min((int)PN_INFINITY - 1, (int)(proofLimit - proof + bestOther));
+        }
+
+        QuoridorUndo undo;
+        QuoridorCore_makeTurn(core, turns[best], &undo);
+        PNSearch_expand(self, core, ply + 1, childProof, childDisproof);
+        QuoridorCore_unmakeTurn(core, &undo);
+    }
+
+    PNSearch_store(self, key, proof, disproof);
+}
+
+PNResult PNSearch_prove(
+    PNSearch *self, QuoridorCore *core, int attackerID, Uint64 maxNodes,
+    QuoridorTurn *proofTurn, AIData *aiData)
+{
+    assert(aiData && PNSearch_canSearch(core, attackerID));
+    TRACE_SCOPE_BEGIN("PNSearch_prove");
+
+    self->attackerID = attackerID;
+    self->nodeCount = 0;
+    self->maxNodes = maxNodes;
+    self->aborted = false;
+    self->aiData = aiData;
+
+    // Sans budget, seule la table est lue
+    QuoridorCore copy = *core;
+    if (maxNodes > 0)
+        PNSearch_expand(self, &copy, 0, PN_INFINITY - 1, PN_INFINITY - 1);
+    aiData->stats.proofNodeCount += self->nodeCount;
+
+    const PNEntry root = PNSearch_lookup(self, PNSearch_getKey(core, attackerID));
+    const PNResult result = (root.proof == 0) ? PN_RESULT_PROVEN :
+        (root.disproof == 0) ? PN_RESULT_DISPROVEN : PN_RESULT_UNKNOWN;
+
+    if (proofTurn)
+    {
+        *proofTurn = (QuoridorTurn) { 0 };
+        if (result == PN_RESULT_PROVEN && core->playerID == attackerID)
+        {
+            const int turnCount = PNSearch_generate(self, &copy, 0);
+            for (int t = 0; t < turnCount; t++)
+            {
+                if (PNSearch_lookup(self, self->keys[t]).proof == 0)
+                {
+                    *proofTurn = self->turns[t];
+                    break;
+                }
+            }
+        }
+    }
+
+    TRACE_SCOPE_END();
+    return result;
+}
+
+bool PNSearch_isProven(PNSearch *self, QuoridorCore *core)
+{
+    return PNSearch_lookup(self, PNSearch_getKey(core, self->attackerID)).proof == 0;
+}
+
+int PNSearch_getSolvedEntries(PNSearch *self, PNEntry *entries, int capacity)
+{
+    assert(self);
+    int count = 0;
+    for (int k = 0; k < PN_TABLE_CAPACITY; k++)
+    {
+        const PNEntry entry = self->entries[k];
+        if (entry.key == 0 || (entry.proof != 0 && entry.disproof != 0))
+            continue;
+        if (entries && count < capacity)
+            entries[count] = entry;
+        count++;
+    }
+    return count;
+}
+
+void PNSearch_addSolvedEntries(PNSearch *self, const PNEntry *entries, int count)
+{
+    assert(self && (entries || count == 0));
+    for (int k = 0; k < count; k++)
+    {
+        if (entries[k].key != 0 && (entries[k].proof == 0 || entries[k].disproof == 0))
+            PNSearch_store(self, entries[k].key, entries[k].proof, entries[k].disproof);
+    }
+}
@@ -0,0 +1,142 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+
+typedef struct AIData AIData;
+
+/// @brief Nombre d'emplacements de la table de transposition (puissance de deux).
+#define PN_TABLE_CAPACITY (1 << 18)
+
+/// @brief Profondeur maximale d'une branche (en plies) : au-delà, la victoire n'est pas prouvée.
+#define PN_MAX_DEPTH 96
+
+/// @brief Nombre maximal de murs restants à l'attaquant pour lancer la recherche.
+#define PN_MAX_WALLS 3
+
+/// @brief Nombre de murs de l'attaquant explorés (les meilleurs selon getBestWall()).
+#define PN_ATTACKER_WALLS 3
+
+/// @brief Avance maximale de l'attaquant dans la course (en pas, le joueur qui doit jouer
+/// ayant un pas d'avance) pour que ses murs soient explorés.
+#define PN_WALL_MAX_LEAD 0
+
+/// @brief Nombre de preuve (ou de réfutation) d'une position impossible à prouver (ou à réfuter).
+#define PN_INFINITY 100000000u
+
+/// @brief Résultat d'une recherche par nombres de preuve.
+typedef enum PNResult
+{
+    /// @brief Le budget est épuisé avant la preuve ou la réfutation.
+    PN_RESULT_UNKNOWN,
+
+    /// @brief L'attaquant gagne quoi que joue son adversaire.
+    PN_RESULT_PROVEN,
+
+    /// @brief L'attaquant ne gagne pas avec les actions explorées.
+    PN_RESULT_DISPROVEN,
+} PNResult;
+
+/// @brief Emplacement de la table de transposition. Une clé nulle indique un emplacement libre.
+typedef struct PNEntry
+{
+    Uint64 key;
+
+    /// @brief Nombre de positions à prouver pour montrer que l'attaquant gagne (0 si c'est prouvé).
+    Uint32 proof;
+
+    /// @brief Nombre de positions à prouver pour montrer qu'il ne gagne pas (0 si c'est prouvé).
+    Uint32 disproof;
+} PNEntry;
+
+/// @brief Recherche par nombres de preuve en profondeur d'abord (df-pn) : prouve ou réfute
+/// la victoire forcée d'un joueur, l'attaquant, dans une fin de partie à deux joueurs
+/// où son adversaire n'a plus de mur. L'attaquant n'explore que les déplacements qui raccourcissent
+/// son chemin et ses PN_ATTACKER_WALLS meilleurs murs, son adversaire tous ses déplacements :
+/// une preuve est exacte, une réfutation signifie seulement que l'attaquant ne gagne pas avec ces actions.
+/// Aucune position ne se répète dans une branche, ce qui évite les preuves dépendant du chemin suivi.
+/// Les nombres de preuve sont conservés d'une recherche à l'autre dans une table de transposition
+/// de taille fixe, indexée par QuoridorCore::hash complété des murs restants et de l'attaquant.
+typedef struct PNSearch
+{
+    /// @brief Table de transposition (PN_TABLE_CAPACITY emplacements).
+    PNEntry *entries;
+
+    /// @brief Actions et clés des enfants de chaque ply de la branche (PN_MAX_DEPTH * MAX_TURN_COUNT).
+    QuoridorTurn *turns;
+    Uint64 *keys;
+
+    /// @brief Attaquant de la recherche en cours ou de la dernière recherche.
+    int attackerID;
+
+    /// @brief Nombre de noeuds développés par la recherche en cours et limite.
+    Uint64 nodeCount;
+    Uint64 maxNodes;
+
+    /// @brief Booléen indiquant si la recherche en cours a été interrompue.
+    bool aborted;
+
+    /// @brief Données de l'IA qui lance la recherche (statistiques, arrêt).
+    AIData *aiData;
+} PNSearch;
+
+/// @brief Crée une recherche avec une table vide.
+/// @return La recherche créée.
+PNSearch *PNSearch_create();
+
+/// @brief Détruit une recherche.
+/// @param self La recherche.
+void PNSearch_destroy(PNSearch *self);
+
+/// @brief Vide la table de transposition.
+/// @param self La recherche.
+void PNSearch_clear(PNSearch *self);
+
+/// @brief Indique si une position est une fin de partie que la recherche sait traiter pour un attaquant :
+/// partie à deux joueurs en cours, où il reste entre 1 et PN_MAX_WALLS murs à l'attaquant
+/// et aucun à son adversaire (sans mur, voir RaceSolver). Au-delà, chaque mur de l'adversaire
+/// multiplie les positions à prouver par le nombre d'emplacements libres.
+/// @param core La position.
+/// @param attackerID L'attaquant.
+bool PNSearch_canSearch(QuoridorCore *core, int attackerID);
+
+/// @brief Cherche à prouver que l'attaquant gagne depuis une position.
+/// La recherche s'arrête après maxNodes noeuds, ou à la demande d'arrêt
+/// ou à la limite de temps de l'IA (sans marquer ses statistiques comme interrompues).
+/// @param self La recherche.
+/// @param core La position (inchangée au retour).
+/// @param attackerID L'attaquant.
+/// @param maxNodes Nombre maximal de noeuds développés (0 pour ne lire que la table).
+/// @param proofTurn Adresse où est écrite l'action gagnante si l'attaquant doit jouer
+///     et que sa victoire est prouvée (peut être NULL).
+/// @param aiData Données de l'IA qui lance la recherche.
+/// @return Le résultat de la recherche.
+PNResult PNSearch_prove(
+    PNSearch *self, QuoridorCore *core, int attackerID, Uint64 maxNodes,
+    QuoridorTurn *proofTurn, AIData *aiData);
+
+/// @brief Indique si la victoire de l'attaquant de la dernière recherche est prouvée
+/// depuis une position (lecture de la table, sans recherche).
+/// @param self La recherche.
+/// @param core La position.
+bool PNSearch_isProven(PNSearch *self, QuoridorCore *core);
+
+/// @brief Copie les positions résolues (prouvées ou réfutées) de la table.
+/// Elles restent exactes d'une partie à l'autre, contrairement aux nombres de preuve des autres positions.
+/// @param self La recherche.
+/// @param entries Tableau dans lequel sont écrits les emplacements (peut être NULL pour les compter).
+/// @param capacity Taille du tableau.
+/// @return Le nombre de positions résolues de la table (éventuellement plus que capacity).
+int PNSearch_getSolvedEntries(PNSearch *self, PNEntry *entries, int capacity);
+
+/// @brief Ajoute à la table des positions résolues obtenues avec PNSearch_getSolvedEntries().
+/// @param self La recherche.
+/// @param entries Les emplacements.
+/// @param count Nombre d'emplacements.
+void PNSearch_addSolvedEntries(PNSearch *self, const PNEntry *entries, int count);
@@ -0,0 +1,112 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+/// @brief Nombre d'emplacements de l'ensemble (puissance de deux).
+#define POSITION_SET_CAPACITY 1024
+
+/// @brief Nombre maximal de clés distinctes, pour que les recherches restent courtes.
+#define POSITION_SET_MAX_SIZE (3 * POSITION_SET_CAPACITY / 4)
+
+/// @brief Emplacement de l'ensemble. Une clé nulle indique un emplacement libre.
+typedef struct PositionSetEntry
+{
+    Uint64 key;
+    int count;
+} PositionSetEntry;
+
+/// @brief Multi-ensemble de clés de positions (voir QuoridorCore::hash),
+/// à adressage ouvert avec sondage linéaire.
+/// Une clé dont la dernière occurrence est retirée libère son emplacement :
+/// les clés suivantes de la même séquence sont décalées pour combler le trou.
+typedef struct PositionSet
+{
+    PositionSetEntry entries[POSITION_SET_CAPACITY];
+
+    /// @brief Nombre d'emplacements utilisés.
+    int size;
+} PositionSet;
+
+/// @brief Vide l'ensemble.
+/// @param self L'ensemble.
+INLINE void PositionSet_clear(PositionSet *self)
+{
+    memset(self, 0, sizeof(PositionSet));
+}
+
+/// @brief Renvoie l'emplacement d'une clé, ou l'emplacement libre où l'insérer.
+INLINE PositionSetEntry *PositionSet_find(PositionSet *self, Uint64 key)
+{
+    if (key == 0) key = 1;
+
+    int index = (int)(key & (POSITION_SET_CAPACITY - 1));
+    while (self->entries[index].key != 0 && self->entries[index].key != key)
+    {
+        index = (index + 1) & (POSITION_SET_CAPACITY - 1);
+    }
+    return &(self->entries[index]);
+}
+
+/// @brief Ajoute une occurrence d'une clé.
+/// @param self L'ensemble.
+/// @param key La clé.
+/// @return false si l'ensemble est plein (la clé n'est alors pas ajoutée).
+INLINE bool PositionSet_add(PositionSet *self, Uint64 key)
+{
+    PositionSetEntry *entry = PositionSet_find(self, key);
+    if (entry->key == 0)
+    {
+        if (self->size >= POSITION_SET_MAX_SIZE)
+            return false;
+
+        entry->key = (key == 0) ? 1 : key;
+        self->size++;
+    }
+    entry->count++;
+    return true;
+}
+
+/// @brief Retire une occurrence d'une clé.
+/// @param self L'ensemble.
+/// @param key La clé.
+INLINE void PositionSet_remove(PositionSet *self, Uint64 key)
+{
+    PositionSetEntry *entry = PositionSet_find(self, key);
+    if (entry->count == 0 || --entry->count > 0)
+        return;
+
+    // Décale les clés suivantes dont l'emplacement idéal ne se trouve pas après le trou
+    int hole = (int)(entry - self->entries);
+    int index = hole;
+    while (true)
+    {
+        index = (index + 1) & (POSITION_SET_CAPACITY - 1);
+        if (self->entries[index].key == 0)
+            break;
+
+        const int home = (int)(self->entries[index].key & (POSITION_SET_CAPACITY - 1));
+        const bool stays = (hole <= index) ? (hole < home && home <= index) : (hole < home || home <= index);
+        if (stays)
+            continue;
+
+        self->entries[hole] = self->entries[index];
+        hole = index;
+    }
+    self->entries[hole].key = 0;
+    self->entries[hole].count = 0;
+    self->size--;
+}
+
+/// @brief Renvoie le nombre d'occurrences d'une clé.
+/// @param self L'ensemble.
+/// @param key La clé.
+INLINE int PositionSet_getCount(PositionSet *self, Uint64 key)
+{
+    return PositionSet_find(self, key)->count;
+}
@@ -7,146 +7,377 @@
 #include "core/quoridor_core.h"
 #include "core/utils.h"
 #include "core/quoridor_ai.h"
+#include "core/trace.h"
 #include "limits.h"
 
 
 
 
-ListData* AIData_create()
+const char* AIEngine_getName(AIEngine engine)
 {
-	QuoridorData clear;
-	memset(&clear, 0, sizeof(QuoridorData));
+	switch (engine)
+	{
+	case AI_ENGINE_MAXN: return "maxn";
+	case AI_ENGINE_MCTS: return "mcts";
+	default: return "minmax";
+	}
+}
 
-	ListData* data = ListData_create();
+AIEngine AIEngine_fromName(const char* name)
+{
+	if (strcmp(name, "maxn") == 0)
+		return AI_ENGINE_MAXN;
+	if (strcmp(name, "mcts") == 0)
+		return AI_ENGINE_MCTS;
+	return AI_ENGINE_MINMAX;
+}
 
-	for (int i = 0; i < MAX_BACK_ANALYS; i++)
-		ListData_insertFirst(data, clear);
+const char* AILevel_getName(AILevel level)
+{
+	switch (level)
+	{
+	case AI_LEVEL_EASY: return "easy";
+	case AI_LEVEL_MEDIUM: return "medium";
+	default: return "hard";
+	}
+}
 
-	return data;
+AILevel AILevel_fromName(const char* name)
+{
+	for (int level = 0; level < AI_LEVEL_COUNT; level++)
+	{
+		if (strcmp(name, AILevel_getName((AILevel)level)) == 0)
+			return (AILevel)level;
+	}
+	return AI_LEVEL_COUNT;
 }
 
-void AIData_destroy(void* data)
+Uint64 AILevel_getNodeLimit(AILevel level, AIEngine engine)
 {
-	ListData* database = (ListData*)data;
-	ListData_destroy(database);
-	return;
+	// Sur 9x9 à deux joueurs, un noeud du min-max coûte environ 35 µs et une itération MCTS
+	// 20 µs ; sur 17x17 à huit joueurs, respectivement 600 µs et 100 µs.
+	// Les niveaux du min-max correspondent en moyenne aux profondeurs 3, 4 et 5
+	static const Uint64 minMaxLimits[AI_LEVEL_COUNT] = { 200, 1000, 8000 };
+	static const Uint64 mctsLimits[AI_LEVEL_COUNT] = { 2000, 10000, 40000 };
+
+	level = (AILevel)Int_clamp(level, 0, AI_LEVEL_COUNT - 1);
+	return (engine == AI_ENGINE_MCTS) ? mctsLimits[level] : minMaxLimits[level];
 }
 
-void AIData_reset(void* data)
+int AILevel_getMCTSThreadCount(AILevel level)
+{
+	// Chaque arbre garde au moins 5000 itérations ; sur une machine avec moins de coeurs,
+	// les threads se partagent les coeurs et le coup est plus long mais identique
+	static const int threadCounts[AI_LEVEL_COUNT] = { 1, 2, 4 };
+
+	level = (AILevel)Int_clamp(level, 0, AI_LEVEL_COUNT - 1);
+	return threadCounts[level];
+}
+
+void AISearchSettings_setDefault(AISearchSettings* self)
+{
+	self->lateMoveReductions = true;
+	self->nullMove = true;
+	self->futility = true;
+	self->quiescence = true;
+	self->proofNumber = true;
+}
+
+AIData* AIData_create()
 {
-	ListData* database = (ListData*)data;
-	QuoridorData clear;
-	memset(&clear, 0, sizeof(QuoridorData)); // on remet a zero le coup 
+	AIData* self = (AIData*)calloc(1, sizeof(AIData));
+	AssertNew(self);
+
+	// Graine différente pour chaque IA (rand() est initialisé dans main())
+	AIData_setSeed(self, ((Uint64)rand() << 32) ^ (Uint64)rand() ^ (Uint64)(uintptr_t)self);
 
-	for (int i = 0; i < MAX_BACK_ANALYS; i++)
-		ListData_insertFirstPopLast(database, clear);
+	self->engine = AI_ENGINE_MINMAX;
+	self->mctsSettings.timeMS = 500;
+	self->mctsSettings.threadCount = 1;
+	AISearchSettings_setDefault(&self->searchSettings);
 
-	return;
+	return self;
 }
 
-/// @brief Calcule le plus court chemin entre la position du joueur et sa zone d'arrivée. disjktra
-void QuoridorCore_getShortestPath(QuoridorCore* self, int playerID, QuoridorPos* path, int* size)
-{			
+void AIData_setSeed(AIData* self, Uint64 seed)
+{
+	self->seed = seed;
+	Rng_seed(&self->rng, seed);
 }
 
-/// @brief Calcule une heuristique d'évaluation de l'état du jeu pour un joueur donné.
-/// Cette fonction est utilisée dans l'algorithme Min-Max pour estimer la qualité d'une position.
-/// Elle retourne une valeur représentant l'avantage du joueur playerID.
-/// Une valeur positive indique un avantage pour ce joueur, une valeur négative indique un avantage pour l'adversaire.
-/// @param self Instance du jeu Quoridor.
-/// @param playerID Indice du joueur à évaluer (0 ou 1).
-/// @return Une estimation numérique de l'avantage du joueur playerID.
-static float QuoridorCore_computeScore(QuoridorCore* self, int playerID)
+void AIData_stop(AIData* self)
+{
+	SDL_SetAtomicInt(&self->stopRequested, 1);
+}
+
+void AIData_clearStop(AIData* self)
+{
+	SDL_SetAtomicInt(&self->stopRequested, 0);
+	self->deadline = 0;
+}
+
+void AIData_setTimeLimit(AIData* self, Uint64 timeMS)
 {
+	self->deadline = SDL_GetPerformanceCounter() + timeMS * SDL_GetPerformanceFrequency() / 1000;
+}
 
-	int playerA = playerID;
-	int playerB = playerID ^ 1;
+void AIData_setNodeLimit(AIData* self, Uint64 nodeCount)
+{
+	self->nodeLimit = nodeCount;
+}
 
+/// @brief Renvoie le nombre de noeuds comptés dans la limite de noeuds par la recherche en cours.
+static Uint64 AIData_getSpentNodes(AIData* self)
+{
+	return self->spentNodeCount + self->stats.nodeCount + self->stats.proofNodeCount;
+}
 
-	playerB = (playerID + 1) % 4;
-	int playerC = (playerID + 2) % 4;
-	int playerD = (playerID + 3) % 4;
-	QuoridorPos playerCpath[MAX_GRID_SIZE * MAX_GRID_SIZE];
-	QuoridorPos playerDpath[MAX_GRID_SIZE * MAX_GRID_SIZE];
+/// @brief Renvoie le nombre de noeuds que la recherche par nombres de preuve peut encore visiter :
+/// au plus AI_PN_MAX_NODES et, avec une limite de noeuds, sa part de la limite (voir AI_PN_NODE_SHARE)
+/// moins les noeuds des preuves déjà tentées.
+static Uint64 AIData_getProofNodes(AIData* self)
+{
+	if (self->nodeLimit == 0)
+		return AI_PN_MAX_NODES;
 
-	int distA = 0;
-	int distB = 0;
-	int distC = 0;
-	int distD = 0;
+	const Uint64 share = self->nodeLimit / AI_PN_NODE_SHARE;
+	const Uint64 spent = self->stats.proofNodeCount;
+	const Uint64 remaining = (spent < share) ? share - spent : 0;
+	return (remaining < AI_PN_MAX_NODES) ? remaining : AI_PN_MAX_NODES;
+}
 
+/// @brief Vérifie si la recherche doit s'arrêter (demande d'arrêt, limite de temps dépassée
+/// ou limite de noeuds atteinte). Elle est appelée avant de compter un noeud :
+/// la recherche ne dépasse donc jamais la limite de noeuds, sauf pendant la première
+/// itération (voir AIData::nodeLimitDeferred).
+/// @param self Données de l'IA (jamais d'arrêt si NULL).
+/// @return true si la recherche doit s'arrêter.
+static bool AIData_isStopped(AIData* self)
+{
+	if (!self) return false;
+	if (self->stats.aborted) return true;
 
-	QuoridorPos playerApath[MAX_GRID_SIZE * MAX_GRID_SIZE];
-	QuoridorPos playerBpath[MAX_GRID_SIZE * MAX_GRID_SIZE];
-	if (self->playerCount == 8)
+	if (SDL_GetAtomicInt(&self->stopRequested) ||
+		(self->deadline && SDL_GetPerformanceCounter() >= self->deadline) ||
+		(self->nodeLimit && !self->nodeLimitDeferred && AIData_getSpentNodes(self) >= self->nodeLimit))
 	{
-#ifdef A_STAR
-		distA = AStar_search(self, playerA, playerApath); 
-#else 
-		distA = BFS_search2(self, playerA, playerApath); 
-#endif
-		
-		float scores = 0;
+		self->stats.aborted = true;
+	}
+	return self->stats.aborted;
+}
 
-		for (int i = 0; i < 7; i++)
-		{
-			playerA = (playerA + 1) % 8;
-#ifdef A_STAR
-			scores += AStar_search(self, playerA, playerApath);
-#else 
-			scores += BFS_search2(self, playerA, playerApath);
-#endif
+void AIData_destroy(void* data)
+{
+	AIData* self = (AIData*)data;
+	if (!self) return;
 
-		}
-		scores -= distA;
-		scores += Float_randAB(-RAND_VALUE, +RAND_VALUE);
+	MCTS_destroy(self->mcts);
+	RaceSolver_destroy(self->raceSolver);
+	PNSearch_destroy(self->pnSearch);
+	free(self);
+}
+
+void AIData_reset(void* data)
+{
+	AIData* self = (AIData*)data;
+	MoveHistory_clear(&(self->history));
+	PositionSet_clear(&(self->positions));
+	MCTS_clear(self->mcts);
+
+	memset(&(self->stats), 0, sizeof(AIStats));
+}
+
+/// @brief En-tête d'un fichier de connaissances (voir AIData_saveKnowledge()).
+typedef struct AIKnowledgeHeader
+{
+	char magic[4];
+	Uint32 version;
+	Uint32 gridSize;
+	Uint32 pnEntryCount;
+} AIKnowledgeHeader;
 
+static const char g_knowledgeMagic[4] = { 'Q', 'K', 'N', 'W' };
 
-		return scores;
+void AIData_clearKnowledge(AIData* self)
+{
+	memset(self->historyTable, 0, sizeof(self->historyTable));
+	PNSearch_clear(self->pnSearch);
+}
+
+bool AIData_saveKnowledge(AIData* self, const char* path)
+{
+	FILE* file = fopen(path, "wb");
+	if (file == NULL)
+		return false;
+
+	const int pnEntryCount = self->pnSearch ? PNSearch_getSolvedEntries(self->pnSearch, NULL, 0) : 0;
+	PNEntry* pnEntries = (PNEntry*)calloc(Int_max(pnEntryCount, 1), sizeof(PNEntry));
+	AssertNew(pnEntries);
+	if (pnEntryCount > 0)
+		PNSearch_getSolvedEntries(self->pnSearch, pnEntries, pnEntryCount);
+
+	AIKnowledgeHeader header = { 0 };
+	memcpy(header.magic, g_knowledgeMagic, sizeof(header.magic));
+	header.version = AI_KNOWLEDGE_VERSION;
+	header.gridSize = MAX_GRID_SIZE;
+	header.pnEntryCount = pnEntryCount;
+
+	bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+	success = success && fwrite(self->historyTable, sizeof(self->historyTable), 1, file) == 1;
+	success = success && fwrite(pnEntries, sizeof(PNEntry), pnEntryCount, file) == (size_t)pnEntryCount;
+	success = (fclose(file) == 0) && success;
+
+	free(pnEntries);
+	return success;
+}
 
+bool AIData_loadKnowledge(AIData* self, const char* path)
+{
+	FILE* file = fopen(path, "rb");
+	if (file == NULL)
+		return false;
 
+	AIKnowledgeHeader header = { 0 };
+	if (fread(&header, sizeof(header), 1, file) != 1 ||
+		memcmp(header.magic, g_knowledgeMagic, sizeof(header.magic)) != 0 ||
+		header.version != AI_KNOWLEDGE_VERSION ||
+		header.gridSize != MAX_GRID_SIZE ||
+		header.pnEntryCount > PN_TABLE_CAPACITY)
+	{
+		fclose(file);
+		return false;
 	}
 
-#ifndef A_STAR 
-	distA = BFS_search2(self, playerA, playerApath);
-	distB = BFS_search2(self, playerB, playerBpath);
-#else
-	distA = AStar_search(self, playerA, playerApath);
-	distB = AStar_search(self, playerB, playerBpath);
-#endif
-	float score = (float)(distB - distA);
+	// Le fichier est lu en entier avant de remplacer les connaissances
+	const int pnEntryCount = (int)header.pnEntryCount;
+	Uint32* historyTable = (Uint32*)calloc(1, sizeof(self->historyTable));
+	PNEntry* pnEntries = (PNEntry*)calloc(Int_max(pnEntryCount, 1), sizeof(PNEntry));
+	AssertNew(historyTable);
+	AssertNew(pnEntries);
 
-	if (self->playerCount == 4)
+	bool success = fread(historyTable, sizeof(self->historyTable), 1, file) == 1;
+	success = success && fread(pnEntries, sizeof(PNEntry), pnEntryCount, file) == (size_t)pnEntryCount;
+	fclose(file);
+
+	if (success)
 	{
-#ifndef A_STAR 
-		distC = BFS_search2(self, playerC, playerCpath);
-		distD = BFS_search2(self, playerD, playerDpath);
+		AIData_clearKnowledge(self);
+		memcpy(self->historyTable, historyTable, sizeof(self->historyTable));
+		if (pnEntryCount > 0)
+		{
+			if (self->pnSearch == NULL)
+				self->pnSearch = PNSearch_create();
+			PNSearch_addSolvedEntries(self->pnSearch, pnEntries, pnEntryCount);
+		}
+	}
+	free(historyTable);
+	free(pnEntries);
+	return success;
+}
+
+/// @brief Calcule le plus court chemin entre la position du joueur et sa zone d'arrivée. disjktra
+void QuoridorCore_getShortestPath(QuoridorCore* self, int playerID, QuoridorPos* path, int* size)
+{			
+}
+
+void QuoridorCore_getDistances(QuoridorCore* self, int* distances, AIStats* stats)
+{
+	QuoridorPos path[MAX_PATH_LEN];
+	for (int p = 0; p < self->playerCount; p++)
+	{
+#ifndef A_STAR
+		const int size = BFS_search2(self, p, path);
 #else
-		distC = AStar_search(self, playerC, playerCpath);
-		distD = AStar_search(self, playerD, playerDpath);
+		const int size = AStar_search(self, p, path);
 #endif
-		score = (float)(distB + distC + distD - distA);
+		distances[p] = (size > 0) ? size - 1 : MAX_PATH_LEN;
+	}
+	if (stats)
+		stats->pathCount += self->playerCount;
+}
+
+/// @brief Calcule une heuristique d'évaluation de l'état du jeu pour un joueur donné.
+/// Cette fonction est utilisée dans l'algorithme Min-Max pour estimer la qualité d'une position.
+/// Elle retourne la somme des distances des adversaires moins celle du joueur playerID.
+/// Une valeur positive indique un avantage pour ce joueur, une valeur négative indique un avantage pour les adversaires.
+/// @param self Instance du jeu Quoridor.
+/// @param playerID Indice du joueur à évaluer.
+/// @param aiData Données de l'IA dont le générateur fournit le bruit (aucun bruit si NULL).
+/// @return Une estimation numérique de l'avantage du joueur playerID.
+static float QuoridorCore_computeScore(QuoridorCore* self, int playerID, AIData* aiData)
+{
+	int distances[8] = { 0 };
+	AIStats* stats = AIData_getStats(aiData);
+	if (stats)
+		stats->leafCount++;
+	QuoridorCore_getDistances(self, distances, stats);
+
+	float score = 0.f;
+	for (int p = 0; p < self->playerCount; p++)
+	{
+		score += (p == playerID) ? -(float)distances[p] : (float)distances[p];
 	}
 
+	if (aiData)
+		score += Rng_floatAB(&aiData->rng, -RAND_VALUE, +RAND_VALUE);
+
+	return score;
+}
 
+void QuoridorCore_computeScores(QuoridorCore* self, float* scores, AIData* aiData)
+{
+	const int playerCount = self->playerCount;
+	if (self->state != QUORIDOR_STATE_IN_PROGRESS)
+	{
+		const int winnerID = self->state - QUORIDOR_STATE_P0_WON;
+		for (int p = 0; p < playerCount; p++)
+			scores[p] = (p == winnerID) ? 1.f : 0.f;
+		return;
+	}
 
-	score += Float_randAB(-RAND_VALUE, +RAND_VALUE);
+	int distances[8] = { 0 };
+	AIStats* stats = AIData_getStats(aiData);
+	if (stats)
+		stats->leafCount++;
+	QuoridorCore_getDistances(self, distances, stats);
 
+	// Coups restant à jouer ; à distance égale, le joueur qui joue le plus tôt est devant
+	float remaining[8] = { 0 };
+	float best = INFINITY;
+	for (int p = 0; p < playerCount; p++)
+	{
+		const int order = (p - self->playerID + playerCount) % playerCount;
+		remaining[p] = (float)distances[p] + (float)order / (float)playerCount;
+		if (aiData)
+			remaining[p] += Rng_floatAB(&aiData->rng, -RAND_VALUE, +RAND_VALUE);
+		best = fminf(best, remaining[p]);
+	}
 
-	return score;
+	float sum = 0.f;
+	for (int p = 0; p < playerCount; p++)
+	{
+		scores[p] = expf(-AI_SCORES_SHARPNESS * (remaining[p] - best));
+		sum += scores[p];
+	}
+	for (int p = 0; p < playerCount; p++)
+	{
+		scores[p] /= sum;
+	}
 }
 
 
 float isTheMoveWorth(int i, int j, void* aiData)
 {
-	ListData* data = (ListData*)aiData;
-	NodeData* current = data->head;
+	AIData* data = (AIData*)aiData;
+	MoveHistoryIter iter = MoveHistory_begin(&(data->history));
 
 	int count = 0;
-	for (int k = 0; k < MAX_BACK_ANALYS; k++)
+	const QuoridorData* move = NULL;
+	while ((move = MoveHistoryIter_next(&iter)) != NULL)
 	{
-		if (current->data.action == QUORIDOR_MOVE_TO)
+		if (move->action == QUORIDOR_MOVE_TO)
 		{
-			if (current->data.destPos.i == i && current->data.destPos.j == j)
+			if (move->destPos.i == i && move->destPos.j == j)
 			{
 				count++;
 			}
@@ -173,218 +404,1381 @@ float isTheMoveWorth(int i, int j, void* aiData)
 
 
 
-/// @brief Applique l'algorithme Min-Max (avec élagage alpha-bêta) pour déterminer le coup joué par l'IA.
-/// Cette fonction explore récursivement une partie de l'arbre des coups possibles jusqu'à une profondeur maximale donnée.
-/// @param self Instance du jeu Quoridor.
-/// @param playerID Identifiant du joueur pour lequel on cherche le meilleur coup.
-/// @param currDepth Profondeur actuelle dans l'arbre de recherche.
-/// @param maxDepth Profondeur maximale à atteindre dans l'arbre.
-/// @param alpha Meilleure valeur actuellement garantie pour le joueur maximisant.
-/// @param beta Meilleure valeur actuellement garantie pour le joueur minimisant.
-/// @param turn Pointeur vers une variable où sera enregistré le meilleur coup trouvé (à la racine).
-/// @return L'évaluation numérique de la position courante, selon la fonction heuristique.
-static float QuoridorCore_minMax(QuoridorCore* self, int playerID, int currDepth, int maxDepth, float alpha, float beta, QuoridorTurn* turn, void* aiData, int isAMoveTo)
+/// @brief Met à jour la variation principale d'un ply après l'amélioration du meilleur coup.
+/// La variation du ply suivant (celle du coup qui vient d'être exploré) est recopiée derrière le coup.
+/// @param self Données de l'IA (rien n'est fait si NULL).
+/// @param ply Ply courant.
+/// @param turn Nouveau meilleur coup du ply.
+static void AIData_updatePV(AIData* self, int ply, QuoridorTurn turn)
 {
+	if (!self) return;
 
+	const int childLength = self->pvLength[ply + 1];
+	self->pvTable[ply][ply] = turn;
+	for (int k = ply + 1; k < childLength; k++)
+		self->pvTable[ply][k] = self->pvTable[ply + 1][k];
+	self->pvLength[ply] = Int_max(childLength, ply + 1);
+}
 
-	if (self->state != QUORIDOR_STATE_IN_PROGRESS && self->playerCount == 2) //si un des joueurs a gagné
-	{
-		if (self->state == QUORIDOR_STATE_P0_WON && playerID == 0)
-			return 1000.f - currDepth;
-		if (self->state == QUORIDOR_STATE_P1_WON && playerID == 0)
-			return -1000.f + currDepth * 10;
-		if (self->state == QUORIDOR_STATE_P0_WON && playerID == 1)
-			return -1000.f + currDepth * 10;
-		if (self->state == QUORIDOR_STATE_P1_WON && playerID == 1)
-			return 1000.f - currDepth;
-	}
+/// @brief Termine les statistiques d'une recherche (durée, vitesse, variation principale).
+/// @param self Données de l'IA (rien n'est fait si NULL).
+/// @param start Compteur de performance au début de la recherche.
+/// @param score Évaluation du coup choisi.
+static void AIData_endSearch(AIData* self, Uint64 start, float score)
+{
+	if (!self) return;
 
+	AIStats* stats = &(self->stats);
+	stats->score = score;
+	stats->elapsed = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+	stats->nodesPerSecond = stats->elapsed > 0.0 ? (double)stats->nodeCount / stats->elapsed : 0.0;
 
+	stats->pvLength = self->pvLength[0];
+	for (int k = 0; k < stats->pvLength; k++)
+		stats->pv[k] = self->pvTable[0][k];
+}
 
-	if (currDepth >= maxDepth) //si on atteint la profondeur max
-	{
+/// @brief Renvoie l'adversaire contre lequel un joueur pose ses murs :
+/// l'adversaire le plus proche de sa zone d'arrivée.
+/// @param self Instance du jeu Quoridor.
+/// @param playerID Joueur qui pose le mur.
+/// @param stats Statistiques où compter les calculs de plus court chemin (peut être NULL).
+static int QuoridorCore_getWallTarget(QuoridorCore* self, int playerID, AIStats* stats)
+{
+	if (self->playerCount == 2)
+		return playerID ^ 1;
 
-		float score = QuoridorCore_computeScore(self, playerID);
-		//if (isAMoveTo)
-		//    score += isTheMoveWorth(self->positions[playerID].i, self->positions[playerID].j, aiData);
-		return score;
+	int distances[8] = { 0 };
+	QuoridorCore_getDistances(self, distances, stats);
 
+	int target = (playerID + 1) % self->playerCount;
+	for (int p = 0; p < self->playerCount; p++)
+	{
+		if (p != playerID && distances[p] < distances[target])
+			target = p;
 	}
+	return target;
+}
 
-	const int gridSize = self->gridSize;
-	const int currI = self->positions[self->playerID].i;
-	const int currJ = self->positions[self->playerID].j;
-	QuoridorTurn childTurn = { 0 };
-
-	const bool maximizing = (currDepth % 2) == 0;
-	float value = maximizing ? -INFINITY : INFINITY;
+/// @brief Convertit un mur en action.
+static QuoridorTurn QuoridorWall_toTurn(QuoridorWall wall)
+{
+	QuoridorTurn turn = { 0 };
+	turn.action = (wall.type == WALL_TYPE_HORIZONTAL) ? QUORIDOR_PLAY_HORIZONTAL_WALL : QUORIDOR_PLAY_VERTICAL_WALL;
+	turn.i = wall.pos.i;
+	turn.j = wall.pos.j;
+	return turn;
+}
 
-	for (int i = 0; i < MAX_GRID_SIZE; i++)
+/// @brief Renvoie les actions explorées par la recherche pour le joueur courant :
+/// ses déplacements, puis les meilleurs murs contre un adversaire (voir getBestWall()).
+/// @param self Instance du jeu Quoridor.
+/// @param target Adversaire visé par les murs.
+/// @param turns Tableau (taille AI_MAX_SEARCH_TURNS) dans lequel sont écrites les actions.
+/// @param gains Tableau (taille AI_MAX_SEARCH_TURNS) dans lequel est écrit le gain maximal de chaque action
+///     sur la différence des distances (peut être NULL).
+/// @param stats Statistiques de la recherche (peut être NULL).
+/// @return Le nombre d'actions.
+static int QuoridorCore_getSearchTurns(QuoridorCore* self, int target, QuoridorTurn* turns, float* gains, AIStats* stats)
+{
+	int turnCount = 0;
+	for (int i = 0; i < self->gridSize; i++)
 	{
-		for (int j = 0; j < MAX_GRID_SIZE; j++)
+		for (int j = 0; j < self->gridSize; j++)
 		{
 			if (QuoridorCore_canMoveTo(self, i, j))
 			{
-				QuoridorCore copy = *self;
-
-				/*QuoridorCore* copy = calloc(1, sizeof(QuoridorCore));
-
-				if (copy == NULL) {
-					fprintf(stderr, "Erreur d'allocation mémoire\n");
-					exit(EXIT_FAILURE);
-				}
-
-				memcpy(copy, self, sizeof(QuoridorCore));*/
-
-				QuoridorCore_moveTo(&copy, i, j);
-				float tmp = QuoridorCore_minMax(&copy, playerID, currDepth + 1, maxDepth, alpha, beta, &childTurn, aiData, 1);
-
-				//free(copy);
-
-				if (maximizing)
-				{
-					if (tmp > value)
-					{
-						value = tmp;
-						turn->action = QUORIDOR_MOVE_TO;
-						turn->i = i;
-						turn->j = j;
-					}
-
-					if (value >= beta)
-						return value;
-					alpha = fmaxf(alpha, value);
-				}
-				else
-				{
+				turns[turnCount].action = QUORIDOR_MOVE_TO;
+				turns[turnCount].i = i;
+				turns[turnCount].j = j;
+				turnCount++;
+			}
+		}
+	}
 
-					if (tmp < value)
-					{
-						value = tmp;
-						turn->action = QUORIDOR_MOVE_TO;
-						turn->i = i;
-						turn->j = j;
-					}
+	for (int t = 0; gains && t < turnCount; t++)
+		gains[t] = AI_FUTILITY_MOVE_GAIN;
 
-				
-					if (value <= alpha)
-						return value; 
-					beta = fminf(beta, value);
-				}
-			}
+	// Le pas sur le plus court chemin est exploré en premier
+	QuoridorPos path[MAX_PATH_LEN];
+#ifndef A_STAR
+	const int size = BFS_search2(self, self->playerID, path);
+#else
+	const int size = AStar_search(self, self->playerID, path);
+#endif
+	if (stats)
+		stats->pathCount++;
+	for (int t = 1; t < turnCount && size > 1; t++)
+	{
+		if (turns[t].i == path[1].i && turns[t].j == path[1].j)
+		{
+			const QuoridorTurn first = turns[t];
+			for (int k = t; k > 0; k--)
+				turns[k] = turns[k - 1];
+			turns[0] = first;
+			break;
 		}
 	}
 
-	QuoridorWall walls[MAX_BEST_WALLS] = { 0 };  
+	QuoridorWall walls[MAX_BEST_WALLS] = { 0 };
 	int wallCount = 0;
-	getBestWall(self, playerID, 999, walls, &wallCount); 
-
+	getBestWall(self, self->playerID, target, 999, walls, &wallCount, stats);
 	for (int m = 0; m < wallCount; m++)
 	{
-		QuoridorCore gamecopy = *self;
+		if (gains)
+			gains[turnCount] = (float)walls[m].score;
+		turns[turnCount++] = QuoridorWall_toTurn(walls[m]);
+	}
+	return turnCount;
+}
 
-		//QuoridorCore* gamecopy = calloc(1, sizeof(QuoridorCore));
-		//if (gamecopy == NULL) {
-		//    fprintf(stderr, "Erreur d'allocation mémoire\n");
-		//    exit(EXIT_FAILURE);
-		//}
-		//memcpy(gamecopy, self, sizeof(QuoridorCore)); 
+/// @brief Joue une action renvoyée par QuoridorCore_getSearchTurns().
+static void QuoridorCore_playSearchTurn(QuoridorCore* self, QuoridorTurn turn, AIStats* stats)
+{
+	if (turn.action == QUORIDOR_MOVE_TO)
+	{
+		QuoridorCore_moveTo(self, turn.i, turn.j);
+		return;
+	}
 
-		QuoridorCore_playWall(&gamecopy, walls[m].type, walls[m].pos.i, walls[m].pos.j);
+	if (stats)
+		stats->wallCheckCount++;
+	QuoridorCore_playWall(self, turn.action == QUORIDOR_PLAY_HORIZONTAL_WALL ? WALL_TYPE_HORIZONTAL : WALL_TYPE_VERTICAL, turn.i, turn.j);
+}
 
-		float tmp = QuoridorCore_minMax(&gamecopy, playerID, currDepth + 1, maxDepth, alpha, beta, &childTurn, aiData, 0);
+/// @brief Indique si une action de la racine est exclue par l'analyse multi-PV (voir AIData::excludedTurns).
+static bool AIData_isExcludedTurn(AIData* self, QuoridorTurn turn)
+{
+	for (int k = 0; k < self->excludedCount; k++)
+	{
+		const QuoridorTurn other = self->excludedTurns[k];
+		if (turn.action == other.action && turn.i == other.i && turn.j == other.j)
+			return true;
+	}
+	return false;
+}
 
-		//free(gamecopy);
+/// @brief Retire des actions de la racine celles des lignes déjà trouvées par l'analyse multi-PV,
+/// sans changer l'ordre des autres.
+/// @param gains Gains des actions, déplacés avec elles (peut être NULL).
+/// @return Le nombre d'actions restantes.
+static int AIData_removeExcludedTurns(AIData* self, int ply, QuoridorTurn* turns, float* gains, int turnCount)
+{
+	if (!self || ply > 0 || self->excludedCount == 0) return turnCount;
 
-		if (maximizing)
-		{
-			if (tmp > value)
-			{
-				value = tmp;
-				if (walls[m].type == WALL_TYPE_HORIZONTAL)
-					turn->action = QUORIDOR_PLAY_HORIZONTAL_WALL;
-				else if (walls[m].type == WALL_TYPE_VERTICAL)
-					turn->action = QUORIDOR_PLAY_VERTICAL_WALL;
-				turn->i = walls[m].pos.i;
-				turn->j = walls[m].pos.j;
-			}
+	int count = 0;
+	for (int t = 0; t < turnCount; t++)
+	{
+		if (AIData_isExcludedTurn(self, turns[t]))
+			continue;
 
-			if (value >= beta)
-				return value; 
-			alpha = fmaxf(alpha, value);
-		}
-		else
+		turns[count] = turns[t];
+		if (gains)
+			gains[count] = gains[t];
+		count++;
+	}
+	return count;
+}
+
+/// @brief Place une action en tête des actions, en conservant l'ordre des autres.
+/// @param gains Gains des actions, déplacés avec elles (peut être NULL).
+/// @return true si l'action a été trouvée.
+static bool QuoridorTurn_moveFirst(QuoridorTurn* turns, float* gains, int turnCount, QuoridorTurn turn)
+{
+	for (int t = 0; t < turnCount; t++)
+	{
+		if (turns[t].action == turn.action && turns[t].i == turn.i && turns[t].j == turn.j)
 		{
-			if (tmp < value)
+			// Décale les actions précédentes pour conserver leur ordre
+			const float gain = gains ? gains[t] : 0.f;
+			for (int k = t; k > 0; k--)
 			{
-				value = tmp;
-				if (walls[m].type == WALL_TYPE_HORIZONTAL)
-					turn->action = QUORIDOR_PLAY_HORIZONTAL_WALL;
-				else if (walls[m].type == WALL_TYPE_VERTICAL)
-					turn->action = QUORIDOR_PLAY_VERTICAL_WALL;
-				turn->i = walls[m].pos.i;
-				turn->j = walls[m].pos.j;
+				turns[k] = turns[k - 1];
+				if (gains)
+					gains[k] = gains[k - 1];
 			}
-
-			// Alpha-beta pruning
-			if (value <= alpha)
-				return value; 
-			beta = fminf(beta, value);
+			turns[0] = turn;
+			if (gains)
+				gains[0] = gain;
+			return true;
 		}
 	}
-
-	return value;
+	return false;
 }
 
-QuoridorTurn QuoridorCore_computeTurn(QuoridorCore* self, int depth, void* aiData)
+/// @brief Place en tête le coup de la variation principale de l'itération précédente,
+/// si le noeud se trouve sur cette variation (voir AIData::followPV).
+/// @param gains Gains des actions, déplacés avec elles (peut être NULL).
+/// @return true si le coup a été trouvé parmi les actions.
+static bool AIData_orderPVTurn(AIData* self, int ply, QuoridorTurn* turns, float* gains, int turnCount)
 {
-	QuoridorTurn childTurn = { 0 };
+	if (!self || !self->followPV) return false;
+	self->followPV = false;
+	if (ply >= self->prevPVLength) return false;
 
+	return QuoridorTurn_moveFirst(turns, gains, turnCount, self->prevPV[ply]);
+}
 
-	const float alpha = -INFINITY;
-	const float beta = INFINITY;
+/// @brief Renvoie la clé d'une position dans la table des bornes (voir AIData::boundTable) :
+/// la clé de Zobrist ne tient pas compte des murs restants de chaque joueur.
+static Uint64 AIData_getBoundKey(QuoridorCore* core)
+{
+	Uint64 walls = 0;
+	for (int p = 0; p < core->playerCount; p++)
+		walls = (walls << 5) | (Uint64)core->wallCounts[p];
+	return core->hash ^ Rng_mix(~walls);
+}
 
+/// @brief Renvoie l'entrée d'une position dans la table des bornes, ou NULL si elle n'y est pas.
+static const AIBoundEntry* AIData_probeBound(AIData* self, Uint64 key)
+{
+	const AIBoundEntry* entry = &(self->boundTable[key & (AI_BOUND_TABLE_SIZE - 1)]);
+	return (entry->key == key) ? entry : NULL;
+}
 
+/// @brief Garde le résultat de l'exploration d'un noeud dans la table des bornes.
+/// L'entrée d'une autre position est remplacée, celle de la même position seulement
+/// par une recherche au moins aussi profonde.
+/// @param alpha,beta Fenêtre de l'exploration, qui fixe la nature du score.
+static void AIData_storeBound(AIData* self, Uint64 key, int remaining, float value, float alpha, float beta, QuoridorTurn turn)
+{
+	if (!self || !self->boundTable || AIData_isStopped(self) || fabsf(value) >= AI_BOUND_MAX_SCORE)
+		return;
 
+	AIBoundEntry* entry = &(self->boundTable[key & (AI_BOUND_TABLE_SIZE - 1)]);
+	if (entry->key == key && entry->depth > remaining)
+		return;
 
+	entry->key = key;
+	entry->score = value;
+	entry->depth = (Uint8)remaining;
+	entry->type = (Uint8)((value <= alpha) ? AI_BOUND_UPPER : (value >= beta) ? AI_BOUND_LOWER : AI_BOUND_EXACT);
+	entry->action = (Uint8)turn.action;
+	entry->i = (Uint8)turn.i;
+	entry->j = (Uint8)turn.j;
+}
 
-	if (self->wallCounts[self->playerID] == 0 && self->playerCount == 4)
-	{
-		QuoridorPos path[MAX_PATH_LEN];
+/// @brief Renvoie le score d'historique d'un mur du joueur courant (voir AIData::historyTable).
+static Uint32* AIData_getHistory(AIData* self, QuoridorCore* core, QuoridorTurn turn)
+{
+	assert(turn.action == QUORIDOR_PLAY_HORIZONTAL_WALL || turn.action == QUORIDOR_PLAY_VERTICAL_WALL);
+	const int type = (turn.action == QUORIDOR_PLAY_HORIZONTAL_WALL) ? 0 : 1;
+	return &(self->historyTable[core->playerID][type][turn.i][turn.j]);
+}
 
+/// @brief Trie les murs de même gain par score d'historique décroissant, à partir de l'action first.
+/// Les gains sont déplacés avec les actions.
+static void AIData_orderHistoryWalls(AIData* self, QuoridorCore* core, QuoridorTurn* turns, float* gains, int first, int turnCount)
+{
+	if (!self) return;
 
-#ifndef A_STAR 
-		BFS_search2(self, self->playerID, path);
-#else 
-		AStar_search(self, self->playerID, path);
-#endif
-		if (self->isValid[path[1].i][path[1].j])
+	// Tri par insertion, stable : les murs arrivent déjà triés par gain décroissant
+	for (int t = first + 1; t < turnCount; t++)
+	{
+		if (turns[t].action == QUORIDOR_MOVE_TO)
+			continue;
+		const QuoridorTurn turn = turns[t];
+		const float gain = gains[t];
+		const Uint32 score = *AIData_getHistory(self, core, turn);
+		int k = t;
+		while (k > first && turns[k - 1].action != QUORIDOR_MOVE_TO && gains[k - 1] == gain
+			&& *AIData_getHistory(self, core, turns[k - 1]) < score)
 		{
-			childTurn.i = path[1].i;
-			childTurn.j = path[1].j;
-			childTurn.action = QUORIDOR_MOVE_TO;
-			return childTurn;
+			turns[k] = turns[k - 1];
+			gains[k] = gains[k - 1];
+			k--;
 		}
+		turns[k] = turn;
+		gains[k] = gain;
 	}
+}
+
+/// @brief Réduit les scores d'historique au début d'une recherche : les coupures des coups
+/// précédents ordonnent encore les murs, mais celles de la nouvelle recherche comptent davantage.
+static void AIData_ageHistory(AIData* self)
+{
+	Uint32* scores = &(self->historyTable[0][0][0][0]);
+	const int count = (int)(sizeof(self->historyTable) / sizeof(Uint32));
+	for (int k = 0; k < count; k++)
+		scores[k] >>= AI_HISTORY_AGING_SHIFT;
+}
 
-	ListData* database;
-	QuoridorData turn;  
-	int minmaxdepth = depth;
-	if(self->playerCount == 4 || self->playerCount == 8) //bride si bcp de joueurs
-		minmaxdepth = 2;
+/// @brief Augmente le score d'historique d'un mur qui provoque une coupure.
+/// @param remaining Profondeur restante sous le noeud.
+static void AIData_updateHistory(AIData* self, QuoridorCore* core, QuoridorTurn turn, int remaining)
+{
+	if (!self || turn.action == QUORIDOR_MOVE_TO) return;
 
-	float childValue = QuoridorCore_minMax(self, self->playerID, 0, minmaxdepth, alpha, beta, &childTurn, aiData, 0);
+	Uint32* score = AIData_getHistory(self, core, turn);
+	*score += (Uint32)(remaining * remaining);
+	if (*score < AI_HISTORY_MAX_SCORE) return;
 
-	turn.action = childTurn.action;
-	turn.destPos.i = childTurn.i;
-	turn.destPos.j = childTurn.j;
-	turn.score = 0; //0 pour l'instant 
+	Uint32* scores = &(self->historyTable[core->playerID][0][0][0]);
+	const int count = 2 * (MAX_GRID_SIZE - 1) * (MAX_GRID_SIZE - 1);
+	for (int k = 0; k < count; k++)
+		scores[k] /= 2;
+}
 
+static float QuoridorCore_minMax(QuoridorCore* self, int playerID, int currDepth, int maxDepth, float alpha, float beta, QuoridorTurn* turn, void* aiData, int isAMoveTo);
 
-	//	AIData_add((ListData*)aiData, turn);
+/// @brief Marque les murs qui coupent un chemin, deux par pas (indices [i][j][type]).
+static void QuoridorCore_markPathWalls(QuoridorCore* self, QuoridorPos* path, int size, bool marks[MAX_GRID_SIZE][MAX_GRID_SIZE][2])
+{
+	const int last = self->gridSize - 2;
+	for (int k = 0; k + 1 < size; k++)
+	{
+		const QuoridorPos a = path[k], b = path[k + 1];
+		if (a.j == b.j)
+		{
+			// Pas vertical : murs horizontaux sous la case du haut
+			const int i = Int_min(a.i, b.i);
+			if (a.j <= last) marks[i][a.j][WALL_TYPE_HORIZONTAL] = true;
+			if (a.j >= 1) marks[i][a.j - 1][WALL_TYPE_HORIZONTAL] = true;
+		}
+		else
+		{
+			// Pas horizontal : murs verticaux à droite de la case de gauche
+			const int j = Int_min(a.j, b.j);
+			if (a.i <= last) marks[a.i][j][WALL_TYPE_VERTICAL] = true;
+			if (a.i >= 1) marks[a.i - 1][j][WALL_TYPE_VERTICAL] = true;
+		}
+	}
+}
 
+/// @brief Renvoie les murs forçants du joueur courant contre un adversaire : ceux qui allongent
+/// le chemin de l'adversaire d'au moins AI_QUIESCENCE_MIN_GAIN de plus que le sien.
+/// Seuls les murs qui coupent le plus court chemin de l'adversaire peuvent l'allonger :
+/// ce sont les seuls essayés, et le chemin du joueur n'est recalculé que si le mur coupe aussi le sien.
+/// La validité du mur n'est vérifiée qu'une fois son gain connu.
+/// @param walls Tableau (taille MAX_BEST_WALLS) dans lequel sont écrits les murs, par gain décroissant.
+/// @return Le nombre de murs.
+static int QuoridorCore_getForcingWalls(QuoridorCore* self, int target, QuoridorWall* walls, AIStats* stats)
+{
+	const int playerID = self->playerID;
+	QuoridorPos targetPath[MAX_PATH_LEN], playerPath[MAX_PATH_LEN];
+#ifndef A_STAR
+	const int targetSize = BFS_search2(self, target, targetPath);
+	const int playerSize = BFS_search2(self, playerID, playerPath);
+#else
+	const int targetSize = AStar_search(self, target, targetPath);
+	const int playerSize = AStar_search(self, playerID, playerPath);
+#endif
+	if (stats)
+		stats->pathCount += 2;
 
-	return childTurn;
+	bool candidates[MAX_GRID_SIZE][MAX_GRID_SIZE][2] = { 0 };
+	bool playerWalls[MAX_GRID_SIZE][MAX_GRID_SIZE][2] = { 0 };
+	QuoridorCore_markPathWalls(self, targetPath, targetSize, candidates);
+	QuoridorCore_markPathWalls(self, playerPath, playerSize, playerWalls);
+
+	int wallCount = 0;
+	for (int i = 0; i < self->gridSize - 1; i++)
+	{
+		for (int j = 0; j < self->gridSize - 1; j++)
+		{
+			for (int type = 0; type < 2; type++)
+			{
+				if (!candidates[i][j][type])
+					continue;
+
+				const bool horizontal = (type == WALL_TYPE_HORIZONTAL);
+				if ((horizontal ? self->hWalls[i][j] : self->vWalls[i][j]) != WALL_STATE_NONE)
+					continue;
+
+				QuoridorCore copy = *self;
+				if (horizontal)
+				{
+					copy.hWalls[i][j] = WALL_STATE_START;
+					copy.hWalls[i][j + 1] = WALL_STATE_END;
+				}
+				else
+				{
+					copy.vWalls[i][j] = WALL_STATE_START;
+					copy.vWalls[i + 1][j] = WALL_STATE_END;
+				}
+
+				QuoridorPos path[MAX_PATH_LEN];
+#ifndef A_STAR
+				const int newTargetSize = BFS_search2(&copy, target, path);
+				const int newPlayerSize = playerWalls[i][j][type] ? BFS_search2(&copy, playerID, path) : playerSize;
+#else
+				const int newTargetSize = AStar_search(&copy, target, path);
+				const int newPlayerSize = playerWalls[i][j][type] ? AStar_search(&copy, playerID, path) : playerSize;
+#endif
+				if (stats)
+					stats->pathCount += playerWalls[i][j][type] ? 2 : 1;
+
+				// Un chemin coupé rend le mur invalide, ce que canPlayWall() vérifie ensuite
+				const int gain = (newTargetSize - targetSize) - (newPlayerSize - playerSize);
+				if (newTargetSize <= 0 || newPlayerSize <= 0 || gain < AI_QUIESCENCE_MIN_GAIN)
+					continue;
+
+				if (stats)
+					stats->wallCheckCount++;
+				if (!QuoridorCore_canPlayWall(self, (WallType)type, i, j))
+					continue;
+
+				if (wallCount < MAX_BEST_WALLS)
+				{
+					walls[wallCount].type = (WallType)type;
+					walls[wallCount].pos.i = i;
+					walls[wallCount].pos.j = j;
+					walls[wallCount].score = gain;
+					wallCount++;
+				}
+			}
+		}
+	}
+
+	if (wallCount > 1)
+		qsort(walls, wallCount, sizeof(QuoridorWall), compareWalls);
+	return wallCount;
+}
+
+/// @brief Évalue une feuille du min-max en prolongeant les échanges de murs en cours
+/// (recherche de quiescence). Le joueur qui doit jouer peut s'en tenir à l'évaluation statique
+/// ou poser un mur forçant, qui allonge le chemin de l'adversaire visé d'au moins
+/// AI_QUIESCENCE_MIN_GAIN de plus que le sien ; seuls ces murs sont explorés.
+/// @param qDepth Nombre de murs forçants pouvant encore être joués.
+/// @return Le score de la position pour playerID, dans la fenêtre [alpha, beta] ou au-delà.
+static float QuoridorCore_quiescence(QuoridorCore* self, int playerID, int currDepth, int qDepth, float alpha, float beta, AIData* data)
+{
+	if (self->state != QUORIDOR_STATE_IN_PROGRESS)
+	{
+		if (self->state - QUORIDOR_STATE_P0_WON == playerID)
+			return 1000.f - currDepth;
+		return -1000.f + currDepth * 10;
+	}
+
+	const float standPat = QuoridorCore_computeScore(self, playerID, data);
+	if (qDepth <= 0 || self->wallCounts[self->playerID] <= 0 || AIData_isStopped(data))
+		return standPat;
+
+	// Le joueur qui doit jouer n'est pas obligé de poser un mur
+	const bool maximizing = (self->playerID == playerID);
+	if (maximizing ? (standPat >= beta) : (standPat <= alpha))
+		return standPat;
+	if (maximizing)
+		alpha = fmaxf(alpha, standPat);
+	else
+		beta = fminf(beta, standPat);
+
+	AIStats* stats = &(data->stats);
+	const int target = maximizing ? QuoridorCore_getWallTarget(self, playerID, stats) : playerID;
+	QuoridorWall walls[MAX_BEST_WALLS];
+	const int wallCount = QuoridorCore_getForcingWalls(self, target, walls, stats);
+
+	float value = standPat;
+	for (int m = 0; m < Int_min(wallCount, AI_QUIESCENCE_MAX_WALLS); m++)
+	{
+		// Les murs sont triés par gain décroissant : si le gain ne peut plus
+		// faire entrer le score dans la fenêtre, les suivants non plus (delta pruning).
+		// Comme pour la futilité, le gain d'un mur ne borne le score que du côté des adversaires
+		const bool bounded = !maximizing || self->playerCount == 2;
+		const float bound = maximizing ?
+			standPat + (float)walls[m].score + AI_FUTILITY_MARGIN :
+			standPat - (float)walls[m].score - AI_FUTILITY_MARGIN;
+		if (bounded && (maximizing ? (bound <= alpha) : (bound >= beta)))
+			break;
+
+		if (AIData_isStopped(data))
+			break;
+
+		QuoridorCore copy = *self;
+		QuoridorCore_playSearchTurn(&copy, QuoridorWall_toTurn(walls[m]), stats);
+		stats->nodeCount++;
+		stats->quiescenceCount++;
+
+		const float tmp = QuoridorCore_quiescence(&copy, playerID, currDepth + 1, qDepth - 1, alpha, beta, data);
+		if (maximizing ? (tmp > value) : (tmp < value))
+			value = tmp;
+
+		if (maximizing ? (value >= beta) : (value <= alpha))
+			return value;
+		if (maximizing)
+			alpha = fmaxf(alpha, value);
+		else
+			beta = fminf(beta, value);
+	}
+	return value;
+}
+
+/// @brief Explore un enfant avec une fenêtre nulle, puis avec la fenêtre [alpha, beta]
+/// si la fenêtre nulle ne suffit pas à prouver qu'il n'est pas meilleur (voir QuoridorCore_minMaxNode()).
+/// L'exploration avec la fenêtre nulle peut être réduite de reduction plies : elle est alors
+/// refaite à pleine profondeur avant la fenêtre complète.
+static float QuoridorCore_searchChild(QuoridorCore* child, int playerID, int currDepth, int maxDepth, float alpha, float beta, bool maximizing, int reduction, QuoridorTurn* childTurn, AIData* data, int isMove)
+{
+	AIStats* stats = AIData_getStats(data);
+	const float nullAlpha = maximizing ? alpha : beta - AI_PVS_EPSILON;
+	const float nullBeta = maximizing ? alpha + AI_PVS_EPSILON : beta;
+	float value = 0.f;
+
+	if (reduction > 0)
+	{
+		if (stats)
+			stats->reductionCount++;
+		value = QuoridorCore_minMax(child, playerID, currDepth + 1, maxDepth - reduction, nullAlpha, nullBeta, childTurn, data, isMove);
+		if (maximizing ? (value <= alpha) : (value >= beta))
+			return value;
+	}
+
+	value = QuoridorCore_minMax(child, playerID, currDepth + 1, maxDepth, nullAlpha, nullBeta, childTurn, data, isMove);
+	if (value > alpha && value < beta)
+	{
+		if (stats)
+			stats->researchCount++;
+		value = QuoridorCore_minMax(child, playerID, currDepth + 1, maxDepth, alpha, beta, childTurn, data, isMove);
+	}
+	return value;
+}
+
+/// @brief Explore les actions du joueur courant (voir QuoridorCore_minMax()).
+/// Seule la première action est explorée avec la fenêtre [alpha, beta] : les suivantes
+/// le sont avec une fenêtre nulle, qui suffit à prouver qu'elles ne sont pas meilleures,
+/// et ne sont explorées à nouveau avec la fenêtre complète que si ce n'est pas le cas
+/// (Principal Variation Search).
+/// Les noeuds explorés avec une fenêtre nulle sont élagués selon AIData::searchSettings.
+static float QuoridorCore_minMaxNode(QuoridorCore* self, int playerID, int currDepth, int maxDepth, float alpha, float beta, QuoridorTurn* turn, void* aiData, int isAMoveTo)
+{
+	AIData* data = (AIData*)aiData;
+	AIStats* stats = AIData_getStats(aiData);
+	const bool afterNullMove = data && data->afterNullMove;
+
+	// La valeur renvoyée après un arrêt n'est pas utilisée
+	if (AIData_isStopped(data))
+		return 0.f;
+
+	if (data)
+	{
+		stats->nodeCount++;
+		data->pvLength[currDepth] = currDepth;
+		data->afterNullMove = false;
+	}
+
+	if (self->state != QUORIDOR_STATE_IN_PROGRESS) //si un des joueurs a gagné
+	{
+		if (self->state - QUORIDOR_STATE_P0_WON == playerID)
+			return 1000.f - currDepth;
+		return -1000.f + currDepth * 10;
+	}
+
+	if (currDepth >= maxDepth) //si on atteint la profondeur max
+	{
+		if (data && data->searchSettings.quiescence)
+			return QuoridorCore_quiescence(self, playerID, currDepth, AI_QUIESCENCE_MAX_DEPTH, alpha, beta, data);
+
+		float score = QuoridorCore_computeScore(self, playerID, (AIData*)aiData);
+		//if (isAMoveTo)
+		//    score += isTheMoveWorth(self->positions[playerID].i, self->positions[playerID].j, aiData);
+		return score;
+	}
+
+	// Recherche paranoïaque : tous les adversaires jouent contre playerID
+	const bool maximizing = (self->playerID == playerID);
+	const int remaining = maxDepth - currDepth;
+	const bool nullWindow = data && currDepth > 0 && (beta - alpha) < 2.f * AI_PVS_EPSILON;
+	const AISearchSettings settings = data ? data->searchSettings : (AISearchSettings) { 0 };
+	QuoridorTurn childTurn = { 0 };
+
+	// Table des bornes de l'analyse multi-PV : hors de la variation principale, une position
+	// déjà explorée assez profondément n'est pas explorée à nouveau si son score suffit à conclure.
+	// La racine, dont les actions exclues changent d'une ligne à l'autre, n'y est pas gardée
+	const float alphaOrig = alpha, betaOrig = beta;
+	const Uint64 boundKey = (data && data->boundTable && currDepth > 0) ? AIData_getBoundKey(self) : 0;
+	QuoridorTurn boundTurn = { 0 };
+	if (boundKey)
+	{
+		const AIBoundEntry* entry = AIData_probeBound(data, boundKey);
+		if (entry)
+		{
+			boundTurn = (QuoridorTurn) { (QuoridorAction)entry->action, entry->i, entry->j };
+			const bool isUsable = nullWindow && entry->depth >= remaining && (entry->type == AI_BOUND_EXACT
+				|| (entry->type == AI_BOUND_LOWER && entry->score >= beta)
+				|| (entry->type == AI_BOUND_UPPER && entry->score <= alpha));
+			if (isUsable)
+			{
+				stats->ttHits++;
+				return entry->score;
+			}
+		}
+	}
+
+	// Coup nul : si la position reste hors de la fenêtre quand le joueur passe son tour,
+	// elle le restera avec son meilleur coup
+	if (nullWindow && settings.nullMove && !afterNullMove && remaining >= AI_NULL_MOVE_MIN_DEPTH)
+	{
+		QuoridorCore copy = *self;
+		QuoridorCore_passTurn(&copy);
+		const bool followPV = data->followPV;
+		data->followPV = false;
+		data->afterNullMove = true;
+		const float tmp = QuoridorCore_minMax(&copy, playerID, currDepth + 1, maxDepth - AI_NULL_MOVE_REDUCTION, alpha, beta, &childTurn, aiData, 0);
+		data->followPV = followPV;
+		data->afterNullMove = false;
+		if (maximizing ? (tmp >= beta) : (tmp <= alpha))
+		{
+			stats->nullMoveCutoffs++;
+			return tmp;
+		}
+	}
+
+	const int target = maximizing ? QuoridorCore_getWallTarget(self, playerID, stats) : playerID;
+
+	QuoridorTurn turns[AI_MAX_SEARCH_TURNS];
+	float gains[AI_MAX_SEARCH_TURNS];
+	int turnCount = QuoridorCore_getSearchTurns(self, target, turns, gains, stats);
+	turnCount = AIData_removeExcludedTurns(data, currDepth, turns, gains, turnCount);
+	const bool pvFound = AIData_orderPVTurn(data, currDepth, turns, gains, turnCount);
+	const bool boundFound = !pvFound && boundTurn.action != QUORIDOR_ACTION_UNDEFINED
+		&& QuoridorTurn_moveFirst(turns, gains, turnCount, boundTurn);
+	AIData_orderHistoryWalls(data, self, turns, gains, (pvFound || boundFound) ? 1 : 0, turnCount);
+
+	// Futilité : au dernier ply, l'évaluation d'un enfant est bornée par la différence
+	// des distances du noeud et le gain de l'action. Les murs d'un joueur peuvent allonger
+	// les chemins de plusieurs adversaires : leur gain ne borne le score que du côté des adversaires.
+	// Un joueur proche de l'arrivée peut gagner : le score n'est alors plus borné.
+	bool futility = nullWindow && settings.futility && remaining == 1;
+	float staticScore = 0.f;
+	if (futility)
+	{
+		int distances[8] = { 0 };
+		QuoridorCore_getDistances(self, distances, stats);
+		for (int p = 0; p < self->playerCount; p++)
+			staticScore += (p == playerID) ? -(float)distances[p] : (float)distances[p];
+		futility = distances[self->playerID] > (int)AI_FUTILITY_MOVE_GAIN;
+	}
+
+	float value = maximizing ? -INFINITY : INFINITY;
+	QuoridorTurn bestTurn = { 0 };
+
+	for (int t = 0; t < turnCount; t++)
+	{
+		const int isMove = turns[t].action == QUORIDOR_MOVE_TO;
+		if (futility && (isMove || !maximizing || self->playerCount == 2))
+		{
+			const float bound = maximizing ?
+				staticScore + gains[t] + AI_FUTILITY_MARGIN :
+				staticScore - gains[t] - AI_FUTILITY_MARGIN;
+			if (maximizing ? (bound <= alpha) : (bound >= beta))
+			{
+				stats->futilityCount++;
+				value = maximizing ? fmaxf(value, bound) : fminf(value, bound);
+				continue;
+			}
+		}
+
+		QuoridorCore copy = *self;
+		QuoridorCore_playSearchTurn(&copy, turns[t], stats);
+		if (data)
+			data->followPV = (t == 0) && pvFound;
+
+		// Défaite prouvée par la recherche par nombres de preuve : l'action n'est pas explorée.
+		// La fenêtre nulle n'a de sens qu'une fois une borne finie obtenue
+		float tmp = 0.f;
+		if (currDepth == 0 && data && data->avoidProvenLosses && PNSearch_isProven(data->pnSearch, &copy))
+		{
+			tmp = -AI_PN_WIN_SCORE;
+			data->pvLength[1] = 1;
+		}
+		else if (t == 0 || (maximizing ? isinf(alpha) : isinf(beta)))
+		{
+			tmp = QuoridorCore_minMax(&copy, playerID, currDepth + 1, maxDepth, alpha, beta, &childTurn, aiData, isMove);
+		}
+		else
+		{
+			const bool reduce = settings.lateMoveReductions && !isMove
+				&& t >= AI_LMR_FULL_TURNS && remaining >= AI_LMR_MIN_DEPTH;
+			tmp = QuoridorCore_searchChild(&copy, playerID, currDepth, maxDepth, alpha, beta, maximizing, reduce ? 1 : 0, &childTurn, data, isMove);
+		}
+
+		if (maximizing ? (tmp > value) : (tmp < value))
+		{
+			value = tmp;
+			*turn = turns[t];
+			bestTurn = turns[t];
+			AIData_updatePV(data, currDepth, *turn);
+		}
+
+		// Alpha-beta pruning
+		if (maximizing ? (value >= beta) : (value <= alpha))
+		{
+			if (stats)
+				stats->cutoffs[currDepth]++;
+			AIData_updateHistory(data, self, turns[t], remaining);
+			if (boundKey)
+				AIData_storeBound(data, boundKey, remaining, value, alphaOrig, betaOrig, bestTurn);
+			return value;
+		}
+		if (maximizing)
+			alpha = fmaxf(alpha, value);
+		else
+			beta = fminf(beta, value);
+	}
+
+	// Toutes les actions ont été élaguées ou aucune n'est possible
+	if (isinf(value))
+		return QuoridorCore_computeScore(self, playerID, data);
+	if (boundKey)
+		AIData_storeBound(data, boundKey, remaining, value, alphaOrig, betaOrig, bestTurn);
+	return value;
+}
+
+/// @brief Applique l'algorithme Min-Max (avec élagage alpha-bêta) pour déterminer le coup joué par l'IA.
+/// À plus de deux joueurs, la recherche est paranoïaque : chaque adversaire minimise le score de playerID.
+/// Cette fonction explore récursivement une partie de l'arbre des coups possibles jusqu'à une profondeur maximale donnée.
+/// @param self Instance du jeu Quoridor.
+/// @param playerID Identifiant du joueur pour lequel on cherche le meilleur coup.
+/// @param currDepth Profondeur actuelle dans l'arbre de recherche.
+/// @param maxDepth Profondeur maximale à atteindre dans l'arbre.
+/// @param alpha Meilleure valeur actuellement garantie pour le joueur maximisant.
+/// @param beta Meilleure valeur actuellement garantie pour le joueur minimisant.
+/// @param turn Pointeur vers une variable où sera enregistré le meilleur coup trouvé (à la racine).
+/// @return L'évaluation numérique de la position courante, selon la fonction heuristique.
+static float QuoridorCore_minMax(QuoridorCore* self, int playerID, int currDepth, int maxDepth, float alpha, float beta, QuoridorTurn* turn, void* aiData, int isAMoveTo)
+{
+	AIData* data = (AIData*)aiData;
+	if (data == NULL)
+		return QuoridorCore_minMaxNode(self, playerID, currDepth, maxDepth, alpha, beta, turn, aiData, isAMoveTo);
+
+	// Position déjà vue dans la partie ou dans la branche : elle n'est pas explorée
+	// et le joueur qui y revient est pénalisé, ce qui évite les allers-retours.
+	// Après un arrêt, le noeud n'est pas compté (voir AIData_isStopped())
+	if (currDepth > 0 && !AIData_isStopped(data) && PositionSet_getCount(&(data->positions), self->hash) > 0)
+	{
+		data->stats.nodeCount++;
+		data->stats.repetitionCount++;
+		data->pvLength[currDepth] = currDepth;
+		const int lastPlayerID = (self->playerID + self->playerCount - 1) % self->playerCount;
+		const bool repeatedByMax = (lastPlayerID == playerID);
+		const float score = QuoridorCore_computeScore(self, playerID, data);
+		return repeatedByMax ? score - AI_REPETITION_PENALTY : score + AI_REPETITION_PENALTY;
+	}
+
+	// La position fait partie de la branche explorée le temps de son exploration
+	PositionSet_add(&(data->positions), self->hash);
+	const float value = QuoridorCore_minMaxNode(self, playerID, currDepth, maxDepth, alpha, beta, turn, aiData, isAMoveTo);
+	PositionSet_remove(&(data->positions), self->hash);
+	return value;
+}
+
+static void QuoridorCore_maxN(QuoridorCore* self, int currDepth, int maxDepth, float parentBest, float* values, QuoridorTurn* turn, AIData* data);
+
+/// @brief Explore les actions du joueur courant (voir QuoridorCore_maxN()).
+static void QuoridorCore_maxNNode(QuoridorCore* self, int currDepth, int maxDepth, float parentBest, float* values, QuoridorTurn* turn, AIData* data)
+{
+	AIStats* stats = AIData_getStats(data);
+	const int playerCount = self->playerCount;
+
+	// La valeur renvoyée après un arrêt n'est pas utilisée
+	if (AIData_isStopped(data))
+	{
+		for (int p = 0; p < playerCount; p++)
+			values[p] = 0.f;
+		return;
+	}
+
+	if (data)
+	{
+		stats->nodeCount++;
+		data->pvLength[currDepth] = currDepth;
+	}
+
+	if (currDepth >= maxDepth || self->state != QUORIDOR_STATE_IN_PROGRESS)
+	{
+		QuoridorCore_computeScores(self, values, data);
+
+		// Une victoire proche est préférée à une victoire lointaine
+		if (self->state != QUORIDOR_STATE_IN_PROGRESS)
+			values[self->state - QUORIDOR_STATE_P0_WON] -= 0.001f * currDepth;
+		return;
+	}
+
+	// Chaque joueur maximise sa propre composante ; les composantes sont positives
+	// et leur somme ne dépasse pas 1. Dès que le joueur courant obtient au moins
+	// 1 - parentBest, le joueur précédent ne peut plus dépasser parentBest par
+	// ce noeud : les autres actions ne sont pas explorées (élagage superficiel).
+	const int mover = self->playerID;
+	float childValues[8] = { 0 };
+	QuoridorTurn childTurn = { 0 };
+	bool hasChild = false;
+
+	QuoridorTurn turns[AI_MAX_SEARCH_TURNS];
+	int turnCount = QuoridorCore_getSearchTurns(self, QuoridorCore_getWallTarget(self, mover, stats), turns, NULL, stats);
+	turnCount = AIData_removeExcludedTurns(data, currDepth, turns, NULL, turnCount);
+	const bool pvFound = AIData_orderPVTurn(data, currDepth, turns, NULL, turnCount);
+
+	for (int t = 0; t < turnCount; t++)
+	{
+		QuoridorCore copy = *self;
+		QuoridorCore_playSearchTurn(&copy, turns[t], stats);
+		if (data)
+			data->followPV = (t == 0) && pvFound;
+
+		const float best = hasChild ? values[mover] : -INFINITY;
+		QuoridorCore_maxN(&copy, currDepth + 1, maxDepth, best, childValues, &childTurn, data);
+
+		if (hasChild == false || childValues[mover] > values[mover])
+		{
+			hasChild = true;
+			for (int p = 0; p < playerCount; p++)
+				values[p] = childValues[p];
+			*turn = turns[t];
+			AIData_updatePV(data, currDepth, *turn);
+		}
+
+		if (values[mover] >= 1.f - parentBest)
+		{
+			if (stats)
+				stats->cutoffs[currDepth]++;
+			return;
+		}
+	}
+
+	if (hasChild == false)
+		QuoridorCore_computeScores(self, values, data);
+}
+
+/// @brief Applique l'algorithme max^n (avec élagage superficiel) pour déterminer le coup joué par l'IA.
+/// Chaque joueur choisit l'action qui maximise sa propre composante de l'évaluation
+/// vectorielle (voir QuoridorCore_computeScores()), sans supposer que les adversaires
+/// s'allient contre lui.
+/// @param self Instance du jeu Quoridor.
+/// @param currDepth Profondeur actuelle dans l'arbre de recherche.
+/// @param maxDepth Profondeur maximale à atteindre dans l'arbre.
+/// @param parentBest Meilleure valeur déjà obtenue au noeud parent par le joueur qui y joue
+///     (-INFINITY à la racine).
+/// @param values Tableau (taille playerCount) dans lequel est écrite l'évaluation du noeud.
+/// @param turn Pointeur vers une variable où sera enregistré le meilleur coup trouvé.
+/// @param data Données de l'IA (peut être NULL).
+static void QuoridorCore_maxN(QuoridorCore* self, int currDepth, int maxDepth, float parentBest, float* values, QuoridorTurn* turn, AIData* data)
+{
+	if (data == NULL)
+	{
+		QuoridorCore_maxNNode(self, currDepth, maxDepth, parentBest, values, turn, data);
+		return;
+	}
+
+	// Position déjà vue dans la partie ou dans la branche : elle n'est pas explorée
+	// et le joueur qui y revient voit son score réduit
+	if (currDepth > 0 && !AIData_isStopped(data) && PositionSet_getCount(&(data->positions), self->hash) > 0)
+	{
+		data->stats.nodeCount++;
+		data->stats.repetitionCount++;
+		data->pvLength[currDepth] = currDepth;
+		const int lastPlayerID = (self->playerID + self->playerCount - 1) % self->playerCount;
+		QuoridorCore_computeScores(self, values, data);
+		values[lastPlayerID] *= AI_MAXN_REPETITION_FACTOR;
+		return;
+	}
+
+	PositionSet_add(&(data->positions), self->hash);
+	QuoridorCore_maxNNode(self, currDepth, maxDepth, parentBest, values, turn, data);
+	PositionSet_remove(&(data->positions), self->hash);
+}
+
+/// @brief Calcule le coup d'une course sans mur avec le solveur exact (voir RaceSolver_getBestTurn()).
+/// Le score suit la convention du min-max pour une partie finie et la profondeur
+/// est le nombre de plies jusqu'à la fin ; la variation principale va jusqu'à l'arrivée.
+static QuoridorTurn AIData_solveRace(AIData* self, QuoridorCore* core)
+{
+	if (self->raceSolver == NULL)
+		self->raceSolver = RaceSolver_create();
+
+	RaceEntry entry = { 0 };
+	const QuoridorTurn turn = RaceSolver_getBestTurn(self->raceSolver, core, &entry);
+
+	AIStats* stats = &(self->stats);
+	stats->depth = entry.plies;
+	if (entry.result == RACE_RESULT_WIN)
+		stats->score = 1000.f - entry.plies;
+	else if (entry.result == RACE_RESULT_LOSS)
+		stats->score = -1000.f + entry.plies * 10;
+	else
+		stats->score = 0.f;
+
+	QuoridorCore copy = *core;
+	int length = 0;
+	while (length < AI_MAX_PLY && RaceSolver_canSolve(&copy))
+	{
+		const QuoridorTurn pvTurn = RaceSolver_getBestTurn(self->raceSolver, &copy, NULL);
+		if (pvTurn.action == QUORIDOR_ACTION_UNDEFINED)
+			break;
+		self->pvTable[0][length++] = pvTurn;
+		QuoridorCore_moveTo(&copy, pvTurn.i, pvTurn.j);
+	}
+	self->pvLength[0] = length;
+
+	return turn;
+}
+
+/// @brief Calcule le coup d'une position de la table de fin de partie (voir Tablebase_getBestTurn()),
+/// avec les mêmes conventions que AIData_solveRace().
+static QuoridorTurn AIData_probeTablebase(AIData* self, QuoridorCore* core)
+{
+	RaceEntry entry = { 0 };
+	const QuoridorTurn turn = Tablebase_getBestTurn(self->tablebase, core, &entry);
+
+	AIStats* stats = &(self->stats);
+	stats->depth = entry.plies;
+	if (entry.result == RACE_RESULT_WIN)
+		stats->score = 1000.f - entry.plies;
+	else if (entry.result == RACE_RESULT_LOSS)
+		stats->score = -1000.f + entry.plies * 10;
+	else
+		stats->score = 0.f;
+
+	QuoridorCore copy = *core;
+	int length = 0;
+	while (length < AI_MAX_PLY && Tablebase_canProbe(self->tablebase, &copy))
+	{
+		const QuoridorTurn pvTurn = Tablebase_getBestTurn(self->tablebase, &copy, NULL);
+		if (pvTurn.action == QUORIDOR_ACTION_UNDEFINED)
+			break;
+		self->pvTable[0][length++] = pvTurn;
+		QuoridorCore_playTurn(&copy, pvTurn);
+	}
+	self->pvLength[0] = length;
+
+	return turn;
+}
+
+/// @brief Lit le coup d'une position de la bibliothèque d'ouvertures (voir OpeningBook_chooseTurn()).
+/// Si la position y figure, le coup est écrit dans turn et les statistiques sont remplies.
+/// @return true si le coup vient de la bibliothèque.
+static bool AIData_probeOpeningBook(AIData* self, QuoridorCore* core, QuoridorTurn* turn)
+{
+	if (self->openingBook == NULL)
+		return false;
+
+	const Uint64 start = SDL_GetPerformanceCounter();
+	const OpeningBookEntry* entry = NULL;
+	if (!OpeningBook_chooseTurn(self->openingBook, core, &(self->rng), turn, &entry))
+		return false;
+
+	// Score : part des points gagnés par le coup (une nulle compte pour moitié), entre -1 et 1
+	memset(&(self->stats), 0, sizeof(AIStats));
+	self->stats.fromBook = true;
+	self->pvTable[0][0] = *turn;
+	self->pvLength[0] = 1;
+	AIData_endSearch(self, start, (float)entry->weight / (float)entry->gameCount - 1.f);
+	return true;
+}
+
+/// @brief Cherche une victoire forcée dans une fin de partie avec peu de murs (voir PNSearch_prove()).
+/// Si celle du joueur courant est prouvée, son coup est écrit dans turn et les statistiques sont remplies.
+/// Sinon, tant que celle de l'adversaire n'est pas prouvée depuis la racine, les coups de la racine
+/// menant à une position où elle l'est seront évités (voir AIData::avoidProvenLosses).
+/// @return true si la victoire du joueur courant est prouvée.
+static bool AIData_proveEndgame(AIData* self, QuoridorCore* core, QuoridorTurn* turn)
+{
+	self->avoidProvenLosses = false;
+	const int opponentID = core->playerID ^ 1;
+	const bool canWin = PNSearch_canSearch(core, core->playerID);
+	const bool canLose = PNSearch_canSearch(core, opponentID);
+	if (!self->searchSettings.proofNumber || !(canWin || canLose))
+		return false;
+	if (self->tablebase && Tablebase_canProbe(self->tablebase, core))
+		return false;
+
+	if (self->pnSearch == NULL)
+		self->pnSearch = PNSearch_create();
+
+	const Uint64 start = SDL_GetPerformanceCounter();
+	memset(&(self->stats), 0, sizeof(AIStats));
+
+	if (canWin && PNSearch_prove(self->pnSearch, core, core->playerID, AIData_getProofNodes(self), turn, self) == PN_RESULT_PROVEN
+		&& turn->action != QUORIDOR_ACTION_UNDEFINED)
+	{
+		self->stats.depth = 1;
+		self->pvTable[0][0] = *turn;
+		self->pvLength[0] = 1;
+		AIData_endSearch(self, start, AI_PN_WIN_SCORE);
+		return true;
+	}
+
+	// Si tous les coups perdent, le min-max choisit celui qui retarde le plus la défaite
+	if (canLose && PNSearch_prove(self->pnSearch, core, opponentID, AIData_getProofNodes(self), NULL, self) != PN_RESULT_PROVEN)
+		self->avoidProvenLosses = true;
+	return false;
+}
+
+/// @brief Calcule le coup de l'IA (voir QuoridorCore_computeTurn()) avec une fenêtre [alpha, beta]
+/// à la racine du min-max. Un score hors de la fenêtre n'est qu'une borne du score exact.
+static QuoridorTurn QuoridorCore_computeTurnWindow(QuoridorCore* self, int depth, float alpha, float beta, void* aiData)
+{
+	TRACE_SCOPE_BEGIN("computeTurn");
+	QuoridorTurn childTurn = { 0 };
+	AIData* data = (AIData*)aiData;
+	const Uint64 start = SDL_GetPerformanceCounter();
+
+	// Les tables de la recherche sont indexées par ply
+	depth = Int_clamp(depth, 1, AI_MAX_PLY - 1);
+
+	if (data)
+	{
+		memset(&(data->stats), 0, sizeof(AIStats));
+		data->pvLength[0] = 0;
+	}
+
+	// Les raccourcis suivants ne connaissent pas les coups exclus de la racine (analyse multi-PV)
+	const bool hasExcludedTurns = data && data->excludedCount > 0;
+
+	// Position de la table de fin de partie : le coup y est lu sans recherche
+	if (data && !hasExcludedTurns && data->tablebase && Tablebase_canProbe(data->tablebase, self))
+	{
+		childTurn = AIData_probeTablebase(data, self);
+		AIData_endSearch(data, start, data->stats.score);
+		TRACE_SCOPE_END();
+		return childTurn;
+	}
+
+	// Course sans mur restant : le coup est lu dans la table exacte du solveur
+	if (data && !hasExcludedTurns && RaceSolver_canSolve(self))
+	{
+		childTurn = AIData_solveRace(data, self);
+		AIData_endSearch(data, start, data->stats.score);
+		TRACE_SCOPE_END();
+		return childTurn;
+	}
+
+	if (data && data->engine == AI_ENGINE_MCTS)
+	{
+		if (data->mcts == NULL)
+			data->mcts = MCTS_create();
+
+		childTurn = MCTS_search(data->mcts, self, data);
+		AIData_endSearch(data, start, data->stats.score);
+		TRACE_SCOPE_END();
+		return childTurn;
+	}
+
+
+
+
+
+	if (!hasExcludedTurns && self->wallCounts[self->playerID] == 0 && self->playerCount == 4)
+	{
+		QuoridorPos path[MAX_PATH_LEN];
+
+
+#ifndef A_STAR 
+		BFS_search2(self, self->playerID, path);
+#else 
+		AStar_search(self, self->playerID, path);
+#endif
+		if (self->isValid[path[1].i][path[1].j])
+		{
+			childTurn.i = path[1].i;
+			childTurn.j = path[1].j;
+			childTurn.action = QUORIDOR_MOVE_TO;
+			if (data)
+			{
+				data->pvTable[0][0] = childTurn;
+				data->pvLength[0] = 1;
+			}
+			AIData_endSearch(data, start, 0.f);
+			TRACE_SCOPE_END();
+			return childTurn;
+		}
+	}
+
+	if (data)
+		data->stats.depth = depth;
+
+	if (data)
+		data->followPV = (data->prevPVLength > 0);
+
+	if (data && data->engine == AI_ENGINE_MAXN)
+	{
+		float values[8] = { 0 };
+		QuoridorCore_maxN(self, 0, depth, -INFINITY, values, &childTurn, data);
+		AIData_endSearch(data, start, values[self->playerID]);
+		TRACE_SCOPE_END();
+		return childTurn;
+	}
+
+	float childValue = QuoridorCore_minMax(self, self->playerID, 0, depth, alpha, beta, &childTurn, aiData, 0);
+	AIData_endSearch(data, start, childValue);
+
+	TRACE_SCOPE_END();
+	return childTurn;
+}
+
+/// @brief Cherche une profondeur (voir QuoridorCore_computeTurnWindow()) avec une fenêtre
+/// d'aspiration autour de center, élargie tant que le score tombe en dehors.
+/// Les noeuds de chaque recherche sont ajoutés à AIData::spentNodeCount.
+/// @param useWindow false pour partir de la fenêtre ]-inf, maxBeta[.
+/// @param maxBeta Borne supérieure de la fenêtre de départ (INFINITY si aucune).
+/// @param failCount Compteur des échecs de la fenêtre.
+static QuoridorTurn QuoridorCore_searchDepth(
+	QuoridorCore* self, int depth, bool useWindow, float center, float maxBeta, AIData* aiData, Uint64* failCount)
+{
+	float delta = AI_ASPIRATION_WINDOW;
+	float alpha = useWindow ? center - delta : -INFINITY;
+	float beta = useWindow ? fminf(center + delta, maxBeta) : maxBeta;
+	if (alpha >= beta)
+		alpha = -INFINITY;
+
+	while (true)
+	{
+		const QuoridorTurn turn = QuoridorCore_computeTurnWindow(self, depth, alpha, beta, aiData);
+		aiData->spentNodeCount += aiData->stats.nodeCount;
+
+		const float score = aiData->stats.score;
+		if (aiData->stats.aborted || (score > alpha && score < beta))
+			return turn;
+
+		(*failCount)++;
+		delta *= 4.f;
+		if (score <= alpha)
+			alpha = (delta > AI_ASPIRATION_MAX_WINDOW) ? -INFINITY : score - delta;
+		else
+			beta = (delta > AI_ASPIRATION_MAX_WINDOW) ? INFINITY : score + delta;
+	}
+}
+
+QuoridorTurn QuoridorCore_computeTurn(QuoridorCore* self, int depth, void* aiData)
+{
+	AIData* data = (AIData*)aiData;
+
+	// Les itérations aux profondeurs inférieures coûtent moins que ce qu'elles
+	// économisent : leur variation principale ordonne les coups de la PVS
+	if (data && data->engine != AI_ENGINE_MCTS)
+		return QuoridorCore_computeIterativeTurn(self, depth, data, NULL, NULL);
+
+	QuoridorTurn bookTurn = { 0 };
+	if (data && AIData_probeOpeningBook(data, self, &bookTurn))
+		return bookTurn;
+
+	if (data)
+		data->prevPVLength = 0;
+	return QuoridorCore_computeTurnWindow(self, depth, -INFINITY, INFINITY, aiData);
+}
+
+QuoridorTurn QuoridorCore_computeIterativeTurn(
+	QuoridorCore* self, int maxDepth, AIData* aiData, AISearchCallback callback, void* userData)
+{
+	assert(aiData && "The AIData must be created");
+
+	const Uint64 start = SDL_GetPerformanceCounter();
+	QuoridorTurn bestTurn = { 0 };
+	AIStats bestStats = { 0 };
+	Uint64 nodeCount = 0;
+
+	bestStats.aborted = true;
+	maxDepth = Int_clamp(maxDepth, 1, AI_MAX_PLY - 1);
+
+	aiData->prevPVLength = 0;
+	aiData->spentNodeCount = 0;
+	Uint64 aspirationFailCount = 0;
+	AIData_ageHistory(aiData);
+
+	// Ouverture connue : le coup est lu dans la bibliothèque
+	QuoridorTurn bookTurn = { 0 };
+	if (AIData_probeOpeningBook(aiData, self, &bookTurn))
+	{
+		if (callback)
+			callback(&(aiData->stats), userData);
+		return bookTurn;
+	}
+
+	// Fin de partie avec peu de murs : une victoire prouvée est jouée sans min-max
+	QuoridorTurn proofTurn = { 0 };
+	if (AIData_proveEndgame(aiData, self, &proofTurn))
+	{
+		if (callback)
+			callback(&(aiData->stats), userData);
+		return proofTurn;
+	}
+	const Uint64 proofNodeCount = aiData->stats.proofNodeCount;
+
+	for (int depth = 1; depth <= maxDepth; depth++)
+	{
+		// Fenêtre d'aspiration autour du score de l'itération précédente.
+		// Les noeuds des itérations précédentes sont comptés dans la limite de noeuds
+		const bool useWindow = (aiData->engine == AI_ENGINE_MINMAX)
+			&& (depth >= AI_ASPIRATION_MIN_DEPTH) && (bestStats.depth > 0);
+		// La profondeur 1 se termine toujours, même si la limite de noeuds est atteinte
+		aiData->spentNodeCount = proofNodeCount + nodeCount;
+		aiData->nodeLimitDeferred = (depth == 1);
+		const QuoridorTurn turn = QuoridorCore_searchDepth(
+			self, depth, useWindow, bestStats.score, INFINITY, aiData, &aspirationFailCount);
+		aiData->nodeLimitDeferred = false;
+		nodeCount = aiData->spentNodeCount - proofNodeCount;
+
+		// Le résultat d'une itération interrompue ne sert que si aucune n'a abouti
+		if (aiData->stats.aborted)
+		{
+			if (bestTurn.action == QUORIDOR_ACTION_UNDEFINED && QuoridorCore_canPlayTurn(self, turn))
+				bestTurn = turn;
+			break;
+		}
+
+		// La profondeur n'augmente plus (raccourci sans recherche de QuoridorCore_computeTurn())
+		if (depth > 1 && aiData->stats.depth <= bestStats.depth)
+			break;
+
+		bestTurn = turn;
+		bestStats = aiData->stats;
+		bestStats.nodeCount = nodeCount;
+		bestStats.aspirationFailCount = aspirationFailCount;
+		bestStats.proofNodeCount = proofNodeCount;
+		bestStats.elapsed = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+		bestStats.nodesPerSecond = bestStats.elapsed > 0.0 ? (double)nodeCount / bestStats.elapsed : 0.0;
+
+		// Les coups de la variation principale sont explorés en premier à l'itération suivante
+		aiData->prevPVLength = bestStats.pvLength;
+		for (int k = 0; k < bestStats.pvLength; k++)
+			aiData->prevPV[k] = bestStats.pv[k];
+
+		if (callback)
+			callback(&bestStats, userData);
+	}
+
+	// Arrêt pendant la profondeur 1 (demande d'arrêt ou limite de temps) :
+	// le coup vient d'une recherche à la profondeur 1 sans limite
+	if (QuoridorCore_canPlayTurn(self, bestTurn) == false)
+		bestTurn = QuoridorCore_computeTurnWindow(self, 1, -INFINITY, INFINITY, NULL);
+
+	bestStats.nodeCount = nodeCount;
+	bestStats.proofNodeCount = proofNodeCount;
+	bestStats.elapsed = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+	bestStats.nodesPerSecond = bestStats.elapsed > 0.0 ? (double)nodeCount / bestStats.elapsed : 0.0;
+	aiData->stats = bestStats;
+	aiData->avoidProvenLosses = false;
+	aiData->spentNodeCount = 0;
+
+	return bestTurn;
+}
+
+/// @brief Compare deux lignes pour les trier par score décroissant (qsort).
+static int AIPVLine_compare(const void* a, const void* b)
+{
+	const float scoreA = ((const AIPVLine*)a)->score;
+	const float scoreB = ((const AIPVLine*)b)->score;
+	return (scoreA < scoreB) - (scoreA > scoreB);
+}
+
+int QuoridorCore_computeMultiPV(
+	QuoridorCore* self, int maxDepth, int lineCount, AIData* aiData, AIPVLine* lines,
+	AISearchCallback callback, void* userData)
+{
+	assert(aiData && lines && "The AIData must be created");
+
+	const Uint64 start = SDL_GetPerformanceCounter();
+	const AIEngine engine = aiData->engine;
+	AIPVLine depthLines[AI_MAX_MULTI_PV];
+	AIStats bestStats = { 0 };
+	Uint64 aspirationFailCount = 0;
+	int count = 0;
+
+	bestStats.aborted = true;
+	maxDepth = Int_clamp(maxDepth, 1, AI_MAX_PLY - 1);
+	lineCount = Int_clamp(lineCount, 1, AI_MAX_MULTI_PV);
+
+	if (engine == AI_ENGINE_MCTS)
+		aiData->engine = AI_ENGINE_MINMAX;
+	aiData->spentNodeCount = 0;
+	aiData->avoidProvenLosses = false;
+	AIData_ageHistory(aiData);
+
+	// Les lignes et les profondeurs partagent la table des bornes du min-max
+	AIBoundEntry* boundTable = (AIBoundEntry*)calloc(AI_BOUND_TABLE_SIZE, sizeof(AIBoundEntry));
+	AssertNew(boundTable);
+	aiData->boundTable = boundTable;
+
+	for (int depth = 1; depth <= maxDepth; depth++)
+	{
+		AIStats depthStats = { 0 };
+		int depthCount = 0;
+		bool isDeeper = (depth == 1);
+		aiData->excludedCount = 0;
+
+		// Les lignes de la profondeur 1 se terminent toujours, même si la limite de noeuds est atteinte
+		aiData->nodeLimitDeferred = (depth == 1);
+
+		while (depthCount < lineCount)
+		{
+			// La ligne part de la meilleure ligne de la profondeur précédente
+			// dont le coup n'est pas encore exclu
+			const AIPVLine* prevLine = NULL;
+			for (int k = 0; k < count && prevLine == NULL; k++)
+			{
+				if (!AIData_isExcludedTurn(aiData, lines[k].pv[0]))
+					prevLine = &lines[k];
+			}
+			aiData->prevPVLength = prevLine ? prevLine->pvLength : 0;
+			for (int k = 0; k < aiData->prevPVLength; k++)
+				aiData->prevPV[k] = prevLine->pv[k];
+
+			// Aucun coup restant ne peut dépasser le score de la ligne précédente
+			const bool isMinMax = (aiData->engine == AI_ENGINE_MINMAX);
+			const bool useWindow = isMinMax && prevLine && depth >= AI_ASPIRATION_MIN_DEPTH;
+			const float maxBeta = (isMinMax && depthCount > 0) ? depthLines[depthCount - 1].score + AI_PVS_EPSILON : INFINITY;
+			const QuoridorTurn turn = QuoridorCore_searchDepth(
+				self, depth, useWindow, prevLine ? prevLine->score : 0.f, maxBeta, aiData, &aspirationFailCount);
+
+			// Tous les coups sont exclus
+			if (aiData->stats.aborted || turn.action == QUORIDOR_ACTION_UNDEFINED)
+				break;
+
+			AIPVLine* line = &depthLines[depthCount];
+			line->score = aiData->stats.score;
+			line->depth = aiData->stats.depth;
+			line->pvLength = Int_max(1, aiData->stats.pvLength);
+			line->pv[0] = turn;
+			for (int k = 1; k < line->pvLength; k++)
+				line->pv[k] = aiData->stats.pv[k];
+
+			if (depthCount == 0)
+				depthStats = aiData->stats;
+			isDeeper = isDeeper || depthCount >= count || line->depth > lines[depthCount].depth;
+			aiData->excludedTurns[aiData->excludedCount++] = turn;
+			depthCount++;
+		}
+		aiData->nodeLimitDeferred = false;
+
+		// Les lignes d'une profondeur interrompue ne sont pas gardées
+		if (aiData->stats.aborted)
+			break;
+
+		qsort(depthLines, depthCount, sizeof(AIPVLine), AIPVLine_compare);
+		for (int k = 0; k < depthCount; k++)
+			lines[k] = depthLines[k];
+		count = depthCount;
+
+		bestStats = depthStats;
+		bestStats.score = lines[0].score;
+		bestStats.depth = lines[0].depth;
+		bestStats.pvLength = lines[0].pvLength;
+		for (int k = 0; k < lines[0].pvLength; k++)
+			bestStats.pv[k] = lines[0].pv[k];
+		bestStats.nodeCount = aiData->spentNodeCount;
+		bestStats.aspirationFailCount = aspirationFailCount;
+		bestStats.elapsed = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+		bestStats.nodesPerSecond = bestStats.elapsed > 0.0 ? (double)bestStats.nodeCount / bestStats.elapsed : 0.0;
+
+		if (callback)
+			callback(&bestStats, userData);
+
+		// La profondeur n'augmente plus (raccourcis sans recherche de QuoridorCore_computeTurnWindow())
+		if (count == 0 || !isDeeper)
+			break;
+	}
+
+	bestStats.nodeCount = aiData->spentNodeCount;
+	bestStats.elapsed = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+	bestStats.nodesPerSecond = bestStats.elapsed > 0.0 ? (double)bestStats.nodeCount / bestStats.elapsed : 0.0;
+	aiData->stats = bestStats;
+	aiData->engine = engine;
+	aiData->excludedCount = 0;
+	aiData->prevPVLength = 0;
+	aiData->spentNodeCount = 0;
+	aiData->boundTable = NULL;
+	free(boundTable);
+
+	return count;
 }
 	
 
@@ -775,7 +2169,7 @@ QuoridorTurn QuoridorCore_computeTurn(QuoridorCore* self, int depth, void* aiDat
 	}
 
 
-	void getBestWall(QuoridorCore * self, int player, int tolerance, QuoridorWall * bestWalls, int* wallCount)
+	void getBestWall(QuoridorCore * self, int player, int target, int tolerance, QuoridorWall * bestWalls, int* wallCount, AIStats * stats)
 	{
 
 		if (self->wallCounts[player] == 0) // si le joueur n'a plus de mur
@@ -784,7 +2178,7 @@ QuoridorTurn QuoridorCore_computeTurn(QuoridorCore* self, int depth, void* aiDat
 
 
 		const int gridSize = self->gridSize;
-		const int otherPlayer = player ^ 1;
+		const int otherPlayer = target;
 
 
 		int longestEnemyWaySize = 0, longesPlayerWaySize = -1;
@@ -814,6 +2208,8 @@ QuoridorTurn QuoridorCore_computeTurn(QuoridorCore* self, int depth, void* aiDat
 		actualPlayerSize = AStar_search(self, player, playerPath);
 		actualEnemySize = AStar_search(self, otherPlayer, enemyPath);
 #endif
+		if (stats)
+			stats->pathCount += 2;
 
 		// ==> reupere les murs autour du chemin ennemi
 
@@ -838,6 +2234,8 @@ QuoridorTurn QuoridorCore_computeTurn(QuoridorCore* self, int depth, void* aiDat
 			int j = attemptingWalls[walls].pos.j;
 			int type = attemptingWalls[walls].type;
 
+			if (stats)
+				stats->wallCheckCount++;
 			if (!QuoridorCore_canPlayWall(self, type, i, j))
 				continue;
 
@@ -861,6 +2259,8 @@ QuoridorTurn QuoridorCore_computeTurn(QuoridorCore* self, int depth, void* aiDat
 			playerSize = AStar_search(&copy, player, playerPath);
 			enemySize = AStar_search(&copy, otherPlayer, enemyPath);
 #endif
+			if (stats)
+				stats->pathCount += 2;
 
 
 
@@ -9,15 +9,96 @@
 #include "settings.h"
 #include "core/quoridor_core.h"
 #include "core/utils.h"
-#include "core/listData.h" 
+#include "core/move_history.h"
+#include "core/position_set.h"
+#include "core/mcts.h"
+#include "core/race_solver.h"
+#include "core/pn_search.h"
+#include "core/tablebase.h"
+#include "core/opening_book.h"
 
 
 
 #define MAX_BEST_WALLS 500
+
+/// @brief Nombre maximal d'actions explorées à un noeud (déplacements et meilleurs murs).
+#define AI_MAX_SEARCH_TURNS (MAX_BEST_WALLS + 16)
 #define RAND_VALUE 0.25
 #define ALL_WALLS 
 #define MAX_CANDIDATES 500
 
+/// @brief Pénalité appliquée à l'évaluation d'une position répétée,
+/// contre le joueur dont le coup y revient.
+#define AI_REPETITION_PENALTY 2.f
+
+/// @brief Largeur de la fenêtre nulle de la Principal Variation Search.
+/// Les évaluations sont des nombres de pas bruités : l'écart ne peut pas être un entier.
+#define AI_PVS_EPSILON 0.001f
+
+/// @brief Demi-largeur initiale de la fenêtre d'aspiration autour du score de l'itération précédente.
+#define AI_ASPIRATION_WINDOW 1.f
+
+/// @brief Profondeur à partir de laquelle l'approfondissement itératif utilise une fenêtre d'aspiration.
+#define AI_ASPIRATION_MIN_DEPTH 3
+
+/// @brief Demi-largeur au-delà de laquelle une fenêtre d'aspiration en échec devient infinie.
+#define AI_ASPIRATION_MAX_WINDOW 16.f
+
+/// @brief Nombre de premières actions d'un noeud jamais réduites (late move reductions).
+#define AI_LMR_FULL_TURNS 4
+
+/// @brief Profondeur restante à partir de laquelle les actions tardives sont réduites.
+#define AI_LMR_MIN_DEPTH 3
+
+/// @brief Réduction de profondeur de la recherche après un coup nul.
+#define AI_NULL_MOVE_REDUCTION 2
+
+/// @brief Profondeur restante à partir de laquelle le coup nul est essayé.
+#define AI_NULL_MOVE_MIN_DEPTH 3
+
+/// @brief Variation maximale de la différence des distances après un déplacement (saut compris).
+#define AI_FUTILITY_MOVE_GAIN 2.f
+
+/// @brief Marge de l'élagage de futilité, qui couvre le bruit des évaluations.
+#define AI_FUTILITY_MARGIN 1.f
+
+/// @brief Nombre maximal de murs forçants joués après les feuilles du min-max (recherche de quiescence).
+#define AI_QUIESCENCE_MAX_DEPTH 4
+
+/// @brief Gain minimal d'un mur, sur la différence des distances, pour qu'il soit forçant.
+#define AI_QUIESCENCE_MIN_GAIN 2
+
+/// @brief Nombre maximal de murs forçants explorés par noeud de la recherche de quiescence.
+#define AI_QUIESCENCE_MAX_WALLS 3
+
+/// @brief Score d'historique au-delà duquel les scores d'un joueur sont divisés par deux
+/// (voir AIData::historyTable), pour que les coupures récentes comptent davantage.
+#define AI_HISTORY_MAX_SCORE (1u << 24)
+
+/// @brief Décalage appliqué aux scores d'historique au début de chaque recherche (division par 4).
+#define AI_HISTORY_AGING_SHIFT 2
+
+/// @brief Version du format des fichiers de connaissances (voir AIData_saveKnowledge()).
+#define AI_KNOWLEDGE_VERSION 1
+
+/// @brief Nombre maximal de noeuds de chaque recherche par nombres de preuve avant le min-max.
+#define AI_PN_MAX_NODES 1000
+
+/// @brief Avec une limite de noeuds, les recherches par nombres de preuve avant le min-max
+/// en utilisent au plus 1 / AI_PN_NODE_SHARE : le reste revient au min-max.
+#define AI_PN_NODE_SHARE 4
+
+/// @brief Score d'une victoire prouvée par la recherche par nombres de preuve (longueur inconnue),
+/// entre les évaluations heuristiques et les fins de partie atteintes par le min-max.
+#define AI_PN_WIN_SCORE 900.f
+
+/// @brief Facteur appliqué au score (max^n) du joueur dont le coup revient à une position répétée.
+#define AI_MAXN_REPETITION_FACTOR 0.5f
+
+/// @brief Pente de l'évaluation vectorielle (voir QuoridorCore_computeScores()) :
+/// un pas d'avance multiplie le poids d'un joueur par exp(AI_SCORES_SHARPNESS).
+#define AI_SCORES_SHARPNESS 0.5f
+
 
   
   
@@ -48,10 +129,376 @@ typedef struct Node
 } node ;
 
 
+/// @brief Profondeur maximale d'une recherche (taille des tables indexées par ply).
+#define AI_MAX_PLY 16
+
+/// @brief Statistiques de la dernière recherche d'une IA.
+/// Remplies par QuoridorCore_computeTurn() pour savoir où part le temps de calcul.
+typedef struct AIStats
+{
+    /// @brief Profondeur effective de la recherche.
+    int depth;
+
+    /// @brief Évaluation du coup choisi, du point de vue du joueur qui joue.
+    float score;
+
+    /// @brief Nombre de noeuds visités.
+    Uint64 nodeCount;
+
+    /// @brief Nombre d'évaluations statiques (feuilles de l'arbre).
+    Uint64 leafCount;
+
+    /// @brief Nombre de calculs de plus court chemin (BFS ou A*).
+    Uint64 pathCount;
+
+    /// @brief Nombre d'appels à QuoridorCore_canPlayWall().
+    Uint64 wallCheckCount;
+
+    /// @brief Nombre de coupures alpha-bêta à chaque ply.
+    Uint64 cutoffs[AI_MAX_PLY];
+
+    /// @brief Nombre de positions retrouvées dans une table de transposition.
+    Uint64 ttHits;
+
+    /// @brief Nombre de positions répétées (déjà vues dans la partie ou la branche explorée).
+    Uint64 repetitionCount;
+
+    /// @brief Nombre d'actions explorées à nouveau avec la fenêtre complète
+    /// après l'échec de la fenêtre nulle (Principal Variation Search).
+    Uint64 researchCount;
+
+    /// @brief Nombre d'échecs de la fenêtre d'aspiration (recherches refaites avec une fenêtre plus large).
+    Uint64 aspirationFailCount;
+
+    /// @brief Nombre d'actions explorées à profondeur réduite (late move reductions).
+    Uint64 reductionCount;
+
+    /// @brief Nombre de coupures obtenues par un coup nul.
+    Uint64 nullMoveCutoffs;
+
+    /// @brief Nombre d'actions non explorées par l'élagage de futilité.
+    Uint64 futilityCount;
+
+    /// @brief Nombre de murs forçants explorés après les feuilles (recherche de quiescence).
+    Uint64 quiescenceCount;
+
+    /// @brief Nombre de noeuds développés par la recherche par nombres de preuve.
+    Uint64 proofNodeCount;
+
+    /// @brief Durée de la recherche en secondes.
+    double elapsed;
+
+    /// @brief Nombre de noeuds visités par seconde.
+    double nodesPerSecond;
+
+    /// @brief Booléen indiquant si la recherche a été interrompue
+    /// (AIData_stop(), limite de temps ou de noeuds). Le coup renvoyé n'est alors pas fiable.
+    bool aborted;
+
+    /// @brief Booléen indiquant si le coup a été lu dans la bibliothèque d'ouvertures, sans recherche.
+    bool fromBook;
+
+    /// @brief Variation principale (suite de coups attendue).
+    QuoridorTurn pv[AI_MAX_PLY];
+
+    /// @brief Nombre de coups de la variation principale.
+    int pvLength;
+} AIStats;
+
+/// @brief Nombre maximal de lignes d'une analyse multi-PV (voir QuoridorCore_computeMultiPV()).
+#define AI_MAX_MULTI_PV 8
+
+/// @brief Ligne d'une analyse multi-PV : un coup de la racine, son score et sa variation principale.
+typedef struct AIPVLine
+{
+    /// @brief Évaluation du coup, du point de vue du joueur qui joue.
+    float score;
+
+    /// @brief Profondeur de la recherche dont la ligne est issue.
+    int depth;
+
+    /// @brief Variation principale, qui commence par le coup.
+    QuoridorTurn pv[AI_MAX_PLY];
+
+    /// @brief Nombre de coups de la variation principale.
+    int pvLength;
+} AIPVLine;
+
+/// @brief Nombre d'entrées de la table des bornes de l'analyse multi-PV (puissance de deux).
+#define AI_BOUND_TABLE_SIZE (1 << 16)
+
+/// @brief Score au-delà duquel une position n'est pas gardée dans la table des bornes :
+/// le score d'une fin de partie dépend du ply auquel elle est atteinte.
+#define AI_BOUND_MAX_SCORE 800.f
+
+/// @brief Nature du score d'une entrée de la table des bornes.
+typedef enum AIBoundType
+{
+    /// @brief Score exact, obtenu dans la fenêtre de la recherche.
+    AI_BOUND_EXACT,
+
+    /// @brief Borne inférieure (coupure bêta).
+    AI_BOUND_LOWER,
+
+    /// @brief Borne supérieure (aucune action n'a dépassé alpha).
+    AI_BOUND_UPPER
+} AIBoundType;
+
+/// @brief Entrée de la table des bornes (voir AIData::boundTable).
+typedef struct AIBoundEntry
+{
+    /// @brief Clé de la position (voir QuoridorCore::hash), complétée par les murs restants.
+    Uint64 key;
+
+    /// @brief Score de la position pour le joueur de la racine.
+    float score;
+
+    /// @brief Profondeur restante de la recherche qui a donné le score.
+    Uint8 depth;
+
+    /// @brief Nature du score (AIBoundType).
+    Uint8 type;
+
+    /// @brief Meilleure action trouvée (action, ligne, colonne), explorée en premier.
+    Uint8 action, i, j;
+} AIBoundEntry;
+
+/// @brief Algorithme de recherche utilisé par QuoridorCore_computeTurn().
+typedef enum AIEngine
+{
+    /// @brief Min-max avec élagage alpha-bêta, à profondeur fixe.
+    /// À plus de deux joueurs, la recherche est paranoïaque : tous les adversaires
+    /// jouent contre le joueur qui cherche son coup.
+    AI_ENGINE_MINMAX,
+
+    /// @brief Max^n avec élagage superficiel, à profondeur fixe : chaque joueur
+    /// maximise sa propre composante de l'évaluation vectorielle.
+    AI_ENGINE_MAXN,
+
+    /// @brief Monte Carlo Tree Search, à durée fixe (voir MCTS_search()).
+    AI_ENGINE_MCTS,
+} AIEngine;
+
+/// @brief Renvoie le nom d'un algorithme ("minmax", "maxn" ou "mcts").
+const char *AIEngine_getName(AIEngine engine);
+
+/// @brief Renvoie l'algorithme correspondant à un nom (voir AIEngine_getName()).
+/// @return L'algorithme, AI_ENGINE_MINMAX si le nom est inconnu.
+AIEngine AIEngine_fromName(const char *name);
+
+/// @brief Niveau de difficulté de l'IA, défini par un nombre maximal de noeuds par coup
+/// (voir AIData_setNodeLimit()) : le coût d'un coup ne dépend ni de la machine ni de sa charge.
+typedef enum AILevel
+{
+    AI_LEVEL_EASY,
+    AI_LEVEL_MEDIUM,
+    AI_LEVEL_HARD,
+    AI_LEVEL_COUNT
+} AILevel;
+
+/// @brief Renvoie le nom d'un niveau ("easy", "medium" ou "hard").
+const char *AILevel_getName(AILevel level);
+
+/// @brief Renvoie le niveau correspondant à un nom (voir AILevel_getName()).
+/// @return Le niveau, AI_LEVEL_COUNT si le nom est inconnu.
+AILevel AILevel_fromName(const char *name);
+
+/// @brief Renvoie le nombre maximal de noeuds par coup d'un niveau.
+/// Un noeud du min-max et une itération MCTS n'ayant pas le même coût,
+/// le budget dépend de l'algorithme.
+/// @param level Le niveau.
+/// @param engine L'algorithme de recherche.
+/// @return Le nombre maximal de noeuds.
+Uint64 AILevel_getNodeLimit(AILevel level, AIEngine engine);
+
+/// @brief Renvoie le nombre d'arbres MCTS (un par thread) d'un niveau.
+/// MCTS partage la limite de noeuds entre ses arbres : ce nombre est fixé par le niveau,
+/// et non par le nombre de coeurs de la machine, pour que le coup joué n'en dépende pas.
+/// @param level Le niveau.
+/// @return Le nombre de threads de MCTS.
+int AILevel_getMCTSThreadCount(AILevel level);
+
+/// @brief Options de la recherche sélective du min-max (voir QuoridorCore_minMax()).
+/// Elles ne s'appliquent qu'aux noeuds explorés avec une fenêtre nulle.
+typedef struct AISearchSettings
+{
+    /// @brief Explore les actions ordonnées tard (murs au-delà des AI_LMR_FULL_TURNS
+    /// premières actions) un ply moins profond, puis à pleine profondeur si elles
+    /// semblent meilleures que la fenêtre.
+    bool lateMoveReductions;
+
+    /// @brief Laisse passer le joueur courant et explore la position AI_NULL_MOVE_REDUCTION
+    /// plies moins profond : si passer suffit déjà à sortir de la fenêtre, le noeud est coupé.
+    /// Le zugzwang est rare au Quoridor, où un déplacement ne peut pas allonger son propre chemin.
+    bool nullMove;
+
+    /// @brief Au dernier ply avant les feuilles, n'explore pas les actions dont le gain
+    /// maximal sur la différence des distances (AI_FUTILITY_MOVE_GAIN pour un déplacement,
+    /// gain calculé par getBestWall() pour un mur) ne peut pas faire entrer le score dans la fenêtre.
+    bool futility;
+
+    /// @brief Aux feuilles, tant que le joueur qui doit jouer a un mur forçant (qui allonge
+    /// le chemin de l'adversaire visé d'au moins AI_QUIESCENCE_MIN_GAIN de plus que le sien),
+    /// explore ces murs plutôt que d'évaluer une position au milieu d'un échange de murs.
+    /// Contrairement aux autres options, elle s'applique à tous les noeuds.
+    bool quiescence;
+
+    /// @brief Dans les fins de partie à deux joueurs avec peu de murs (voir PNSearch_canSearch()),
+    /// cherche avant le min-max une victoire forcée du joueur, jouée immédiatement si elle est prouvée,
+    /// puis une victoire forcée de l'adversaire : les coups qui y mènent ne sont pas explorés.
+    /// Elle ne s'applique qu'à la racine.
+    bool proofNumber;
+} AISearchSettings;
+
+/// @brief Active les options de la recherche sélective utilisées par défaut.
+/// @param self Les options.
+void AISearchSettings_setDefault(AISearchSettings *self);
+
+/// @brief Données propres à une IA (une par joueur).
+/// Deux recherches peuvent s'exécuter en parallèle sur des threads différents
+/// tant qu'elles n'utilisent pas les mêmes données.
+typedef struct AIData
+{
+    /// @brief Derniers coups joués par le joueur (utilisés pour l'annulation).
+    MoveHistory history;
+
+    /// @brief Positions de la partie en cours, complétées pendant la recherche
+    /// par celles de la branche explorée, pour détecter les répétitions.
+    PositionSet positions;
+
+    /// @brief Statistiques de la dernière recherche.
+    AIStats stats;
+
+    /// @brief Table triangulaire des variations principales, remplie pendant la recherche.
+    QuoridorTurn pvTable[AI_MAX_PLY][AI_MAX_PLY];
+
+    /// @brief Longueur des variations de pvTable à chaque ply.
+    int pvLength[AI_MAX_PLY];
+
+    /// @brief Variation principale de l'itération précédente de l'approfondissement itératif,
+    /// dont les coups sont explorés en premier.
+    QuoridorTurn prevPV[AI_MAX_PLY];
+
+    /// @brief Nombre de coups de prevPV (0 en dehors de l'approfondissement itératif).
+    int prevPVLength;
+
+    /// @brief Booléen indiquant si le noeud exploré se trouve sur prevPV.
+    bool followPV;
+
+    /// @brief Booléen indiquant si le noeud exploré suit un coup nul.
+    bool afterNullMove;
+
+    /// @brief Actions de la racine qui ne sont pas explorées : coups des lignes déjà trouvées
+    /// par QuoridorCore_computeMultiPV() à la profondeur en cours.
+    QuoridorTurn excludedTurns[AI_MAX_MULTI_PV];
+    int excludedCount;
+
+    /// @brief Table des bornes partagée par les recherches de QuoridorCore_computeMultiPV()
+    /// (AI_BOUND_TABLE_SIZE entrées indexées par la clé de la position), NULL en dehors.
+    /// Les lignes suivantes y retrouvent les sous-arbres déjà explorés par les précédentes
+    /// et par les profondeurs inférieures.
+    AIBoundEntry *boundTable;
+
+    /// @brief Historique des coupures (history heuristic) : score de chaque mur de chaque joueur,
+    /// augmenté du carré de la profondeur restante à chaque coupure alpha-bêta qu'il provoque
+    /// et divisé au début de chaque recherche (AI_HISTORY_AGING_SHIFT).
+    /// Les murs de même gain sont explorés par score décroissant. La table est gardée
+    /// d'une partie à l'autre (voir AIData_saveKnowledge()).
+    Uint32 historyTable[8][2][MAX_GRID_SIZE - 1][MAX_GRID_SIZE - 1];
+
+    /// @brief Options de la recherche sélective du min-max.
+    AISearchSettings searchSettings;
+
+    /// @brief Générateur du bruit ajouté aux évaluations.
+    Rng rng;
+
+    /// @brief Graine du générateur, voir AIData_setSeed().
+    Uint64 seed;
+
+    /// @brief Demande d'arrêt de la recherche, pouvant venir d'un autre thread.
+    SDL_AtomicInt stopRequested;
+
+    /// @brief Compteur de performance au-delà duquel la recherche s'arrête (0 si aucune limite).
+    Uint64 deadline;
+
+    /// @brief Nombre maximal de noeuds de chaque recherche (0 si aucune limite), voir AIData_setNodeLimit().
+    Uint64 nodeLimit;
+
+    /// @brief Noeuds de la recherche en cours déjà comptés dans nodeLimit en dehors de stats.nodeCount
+    /// (itérations précédentes de l'approfondissement itératif, recherche par nombres de preuve).
+    Uint64 spentNodeCount;
+
+    /// @brief Si true, la limite de noeuds n'arrête pas la recherche en cours : la première
+    /// itération de l'approfondissement itératif se termine toujours et donne un coup.
+    bool nodeLimitDeferred;
+
+    /// @brief Algorithme de recherche (min-max par défaut).
+    AIEngine engine;
+
+    /// @brief Paramètres de la recherche MCTS.
+    MCTSSettings mctsSettings;
+
+    /// @brief Arbres MCTS conservés d'un coup à l'autre (créés à la première recherche MCTS).
+    MCTS *mcts;
+
+    /// @brief Solveur des courses sans mur, dont la table est conservée tant que les murs
+    /// ne changent pas (créé à la première course).
+    RaceSolver *raceSolver;
+
+    /// @brief Recherche par nombres de preuve, dont la table est conservée d'un coup à l'autre
+    /// (créée à la première fin de partie).
+    PNSearch *pnSearch;
+
+    /// @brief Booléen indiquant si les coups de la racine menant à une position où pnSearch
+    /// a prouvé la victoire de l'adversaire sont comptés comme perdus sans être explorés.
+    bool avoidProvenLosses;
+
+    /// @brief Table de fin de partie des petites grilles (NULL si aucune), lue à la place
+    /// de la recherche pour les positions qu'elle contient. Partagée en lecture seule,
+    /// elle n'est pas fermée avec les données de l'IA.
+    Tablebase *tablebase;
+
+    /// @brief Bibliothèque d'ouvertures (NULL si aucune), dont un coup est joué sans recherche
+    /// tant que la position y figure. Partagée en lecture seule, elle n'est pas fermée
+    /// avec les données de l'IA.
+    OpeningBook *openingBook;
+} AIData;
+
 /// @brief Crée les données utilisées par l'IA.
-/// @param core Instance du jeu Quoridor.
 /// @return Pointeur vers les données de l'IA créées.
-ListData* AIData_create();
+AIData* AIData_create();
+
+/// @brief Redémarre le générateur aléatoire de l'IA à partir d'une graine.
+/// Deux recherches lancées sur la même position avec la même graine
+/// renvoient exactement le même résultat.
+/// @param self Pointeur vers les données de l'IA.
+/// @param seed Graine du générateur.
+void AIData_setSeed(AIData* self, Uint64 seed);
+
+/// @brief Demande l'arrêt de la recherche en cours.
+/// Peut être appelée depuis un autre thread que celui de la recherche.
+/// La demande reste active jusqu'à l'appel de AIData_clearStop().
+/// @param self Pointeur vers les données de l'IA.
+void AIData_stop(AIData* self);
+
+/// @brief Annule une demande d'arrêt et retire la limite de temps.
+/// @param self Pointeur vers les données de l'IA.
+void AIData_clearStop(AIData* self);
+
+/// @brief Limite la durée des prochaines recherches.
+/// @param self Pointeur vers les données de l'IA.
+/// @param timeMS Durée maximale en millisecondes, à partir de maintenant.
+void AIData_setTimeLimit(AIData* self, Uint64 timeMS);
+
+/// @brief Limite le nombre de noeuds de chaque recherche, jusqu'au prochain appel.
+/// Le min-max compte ses noeuds et ceux de la recherche par nombres de preuve, MCTS ses itérations
+/// (tous threads confondus). Une recherche n'en visite jamais plus ; sans limite de temps
+/// ni demande d'arrêt, elle visite donc les mêmes noeuds et renvoie le même coup sur toute machine,
+/// pourvu que MCTS garde le même nombre de threads (voir AILevel_getMCTSThreadCount()).
+/// L'approfondissement itératif renvoie le coup de la dernière profondeur terminée dans ce budget.
+/// @param self Pointeur vers les données de l'IA.
+/// @param nodeCount Nombre maximal de noeuds (0 pour retirer la limite).
+void AIData_setNodeLimit(AIData* self, Uint64 nodeCount);
 
 /// @brief Détruit les données de l'IA.
 /// @param self Pointeur vers les données de l'IA à détruire.
@@ -65,13 +512,84 @@ void AIData_reset(void* database);
 
 
 
-/// @brief Calcule le coup joué par l'IA selon un algorithme de type min-max.
+/// @brief Oublie les connaissances que l'IA garde d'une partie à l'autre : historique des coupures
+/// (AIData::historyTable) et table de la recherche par nombres de preuve.
+/// @param self Pointeur vers les données de l'IA.
+void AIData_clearKnowledge(AIData* self);
+
+/// @brief Enregistre les connaissances que l'IA garde d'une partie à l'autre dans un fichier :
+/// un en-tête ("QKNW", AI_KNOWLEDGE_VERSION, MAX_GRID_SIZE et nombre de positions résolues),
+/// l'historique des coupures, puis les positions résolues par la recherche par nombres de preuve
+/// (voir PNSearch_getSolvedEntries()), seules exactes d'une partie à l'autre.
+/// @param self Pointeur vers les données de l'IA.
+/// @param path Chemin du fichier.
+/// @return false si le fichier ne peut pas être écrit.
+bool AIData_saveKnowledge(AIData* self, const char* path);
+
+/// @brief Remplace les connaissances de l'IA par celles d'un fichier écrit par AIData_saveKnowledge(),
+/// pour que la première recherche ne parte pas de zéro.
+/// @param self Pointeur vers les données de l'IA.
+/// @param path Chemin du fichier.
+/// @return false si le fichier ne peut pas être lu ou n'a pas le format attendu (les connaissances sont alors inchangées).
+bool AIData_loadKnowledge(AIData* self, const char* path);
+
+/// @brief Calcule le coup joué par l'IA selon un algorithme de type min-max,
+/// ou par MCTS si aiData->engine vaut AI_ENGINE_MCTS.
+/// Si aiData n'est pas NULL, les statistiques de la recherche sont écrites dans aiData->stats
+/// et la profondeur est atteinte par approfondissement itératif (voir QuoridorCore_computeIterativeTurn()).
+/// Une position de aiData->openingBook est jouée sans recherche.
 /// @param self Instance du jeu Quoridor.
-/// @param depth Profondeur de la recherche dans l'arbre de jeu.
+/// @param depth Profondeur de la recherche dans l'arbre de jeu (ignorée par MCTS).
 /// @param aiData Pointeur vers les données de l'IA.
 /// @return Le tour choisi par l'IA.
 QuoridorTurn QuoridorCore_computeTurn(QuoridorCore *self, int depth, void *aiData);
 
+/// @brief Fonction appelée après chaque profondeur terminée par QuoridorCore_computeIterativeTurn().
+/// @param stats Statistiques cumulées depuis le début de la recherche.
+/// @param userData Pointeur transmis à QuoridorCore_computeIterativeTurn().
+typedef void (*AISearchCallback)(const AIStats *stats, void *userData);
+
+/// @brief Calcule le coup joué par l'IA par approfondissement itératif.
+/// Les profondeurs 1, 2, ..., maxDepth sont cherchées successivement jusqu'à un arrêt
+/// (AIData_stop() ou AIData_setTimeLimit()). Le coup renvoyé est celui de la dernière
+/// profondeur terminée ; il est toujours jouable si la partie n'est pas finie.
+/// Chaque itération explore d'abord la variation principale de la précédente et,
+/// avec le min-max, part d'une fenêtre d'aspiration autour de son score.
+/// En fin de recherche, aiData->stats contient les statistiques cumulées.
+/// Une position de aiData->openingBook est jouée sans recherche (callback est appelée une fois).
+/// @param self Instance du jeu Quoridor.
+/// @param maxDepth Profondeur maximale.
+/// @param aiData Pointeur vers les données de l'IA (obligatoire).
+/// @param callback Fonction appelée après chaque profondeur terminée (peut être NULL).
+/// @param userData Pointeur transmis à callback.
+/// @return Le tour choisi par l'IA.
+QuoridorTurn QuoridorCore_computeIterativeTurn(
+    QuoridorCore *self, int maxDepth, AIData *aiData, AISearchCallback callback, void *userData);
+
+/// @brief Calcule les meilleurs coups du joueur courant (analyse multi-PV), avec leur score
+/// et leur variation principale, par approfondissement itératif avec le min-max ou max^n
+/// (MCTS est remplacé par le min-max ; la bibliothèque d'ouvertures n'est pas lue).
+/// À chaque profondeur, la ligne k est cherchée en excluant de la racine les coups
+/// des lignes précédentes. Elle commence par la variation de la ligne k de la profondeur
+/// précédente et, avec le min-max, sa fenêtre est bornée par le score de la ligne k - 1,
+/// qu'aucun coup restant ne peut dépasser. Avec le min-max, les lignes et les profondeurs
+/// partagent aussi une table des bornes (voir AIData::boundTable) : les lignes suivantes
+/// reprennent les sous-arbres déjà explorés et coûtent moins que la première.
+/// Les limites de temps et de noeuds portent sur l'ensemble des lignes. En fin de recherche,
+/// aiData->stats contient les statistiques cumulées et la variation de la meilleure ligne.
+/// @param self Instance du jeu Quoridor.
+/// @param maxDepth Profondeur maximale.
+/// @param lineCount Nombre de lignes demandées (au plus AI_MAX_MULTI_PV).
+/// @param aiData Pointeur vers les données de l'IA (obligatoire).
+/// @param lines Tableau (taille lineCount) où sont écrites les lignes de la dernière profondeur
+///     terminée, par score décroissant. Il est à jour à chaque appel de callback.
+/// @param callback Fonction appelée après chaque profondeur terminée (peut être NULL).
+/// @param userData Pointeur transmis à callback.
+/// @return Le nombre de lignes écrites, inférieur à lineCount s'il y a moins de coups.
+int QuoridorCore_computeMultiPV(
+    QuoridorCore *self, int maxDepth, int lineCount, AIData *aiData, AIPVLine *lines,
+    AISearchCallback callback, void *userData);
+
 /// @brief prend au + 4 mur *taille du chemin
 void collectAllWallsNearPath(QuoridorCore* self, QuoridorPos* path, int pathSize, QuoridorWall* candidat, int* candidatCount);
 
@@ -79,16 +597,39 @@ void collectAllWallsNearPath(QuoridorCore* self, QuoridorPos* path, int pathSize
 //void collectFewWallsInFrontOfPath(QuoridorCore* self, QuoridorPos* path, int pathSize, QuoridorWall* candidat, int* candidatCount);
 
 
+/// @brief Compare deux murs pour les trier par score décroissant (qsort).
+int compareWalls(const void* a, const void* b);
+
 /// @brief Calcule les meilleurs mur à jouer.
+/// @param player Joueur qui pose le mur.
+/// @param target Adversaire dont le chemin est allongé.
 
-void getBestWall(QuoridorCore* self, int player, int tolerance, QuoridorWall* bestWalls,int *wallCount);
+void getBestWall(QuoridorCore* self, int player, int target, int tolerance, QuoridorWall* bestWalls,int *wallCount, AIStats* stats);
 
 
 /// @brief MInMax
-static float QuoridorCore_minMax(QuoridorCore* self, int playerID, int currDepth, int maxDepth, float alpha, float beta, QuoridorTurn* turn, void* aiData);
+static float QuoridorCore_minMax(QuoridorCore* self, int playerID, int currDepth, int maxDepth, float alpha, float beta, QuoridorTurn* turn, void* aiData, int isAMoveTo);
 
 /// computeScore
-static float QuoridorCore_computeScore(QuoridorCore* self, int playerID);
+static float QuoridorCore_computeScore(QuoridorCore* self, int playerID, AIData* aiData);
+
+/// @brief Calcule la distance (nombre de pas) de chaque joueur à sa zone d'arrivée.
+/// @param self Instance du jeu Quoridor.
+/// @param distances Tableau (taille playerCount) dans lequel sont écrites les distances
+///     (MAX_PATH_LEN pour un joueur sans chemin).
+/// @param stats Statistiques où compter les calculs de plus court chemin (peut être NULL).
+void QuoridorCore_getDistances(QuoridorCore* self, int* distances, AIStats* stats);
+
+/// @brief Évaluation vectorielle de la position : une estimation de la probabilité
+/// de victoire de chaque joueur, d'après les distances de tous les joueurs.
+/// Le poids d'un joueur décroît exponentiellement (AI_SCORES_SHARPNESS) avec le nombre
+/// de coups qu'il lui reste à jouer, en tenant compte de l'ordre de jeu ; les scores
+/// sont les poids normalisés. Une partie finie vaut 1 pour le vainqueur et 0 pour les autres.
+/// Les scores sont positifs et leur somme vaut 1, ce qui permet l'élagage superficiel de max^n.
+/// @param self Instance du jeu Quoridor.
+/// @param scores Tableau (taille playerCount) dans lequel sont écrits les scores.
+/// @param aiData Données de l'IA dont le générateur fournit le bruit (aucun bruit si NULL).
+void QuoridorCore_computeScores(QuoridorCore* self, float* scores, AIData* aiData);
 
 
 /// @brief Calcule le plus court chemin entre la position du joueur et sa zone d'arrivée.
@@ -117,9 +658,45 @@ INLINE QuoridorTurn QuoridorCore_computeMoodleTurn(QuoridorCore* self, void* aiD
 int BFS_search2(QuoridorCore* self, int playerID, QuoridorPos* tab);
 
 
-INLINE void* AIData_add(ListData* database, QuoridorData data)
+/// @brief Renvoie les statistiques de l'IA, ou NULL s'il n'y a pas de données.
+/// @param aiData Pointeur vers les données de l'IA (peut être NULL).
+/// @return Les statistiques de la dernière recherche.
+INLINE AIStats* AIData_getStats(void* aiData)
+{
+    return aiData ? &(((AIData*)aiData)->stats) : NULL;
+}
+
+/// @brief Ajoute un coup joué à l'historique de l'IA.
+/// @param self Pointeur vers les données de l'IA.
+/// @param data Coup joué.
+INLINE void AIData_add(AIData* self, QuoridorData data)
+{
+    MoveHistory_push(&(self->history), data);
+}
+
+/// @brief Ajoute une position de la partie en cours à celles connues de l'IA.
+/// Une position déjà vue est pénalisée par la recherche (AI_REPETITION_PENALTY)
+/// pour le joueur qui y revient.
+/// @param self Pointeur vers les données de l'IA.
+/// @param core La position.
+INLINE void AIData_addPosition(AIData* self, const QuoridorCore* core)
+{
+    PositionSet_add(&(self->positions), core->hash);
+}
+
+/// @brief Retire une position ajoutée avec AIData_addPosition() (par exemple après une annulation).
+/// @param self Pointeur vers les données de l'IA.
+/// @param core La position.
+INLINE void AIData_removePosition(AIData* self, const QuoridorCore* core)
+{
+    PositionSet_remove(&(self->positions), core->hash);
+}
+
+/// @brief Oublie les positions de la partie en cours.
+/// @param self Pointeur vers les données de l'IA.
+INLINE void AIData_clearPositions(AIData* self)
 {
-    ListData_insertFirstPopLast(database, data);
+    PositionSet_clear(&(self->positions));
 }
 
 void collectAllWall(QuoridorCore* self, QuoridorPos* path, int pathSize, QuoridorWall* candidat, int* candidatCount);
@@ -5,13 +5,54 @@
 */
 
 #include "core/quoridor_core.h"
-#include "game/ui_quoridor.h"
 #include "core/quoridor_ai.h" 
 
 
 void QuoridorCore_updateValidMoves(QuoridorCore* self);
 bool QuoridorCore_isFeasible(QuoridorCore* self);
 
+// Les clés de Zobrist sont dérivées de leur indice, sans table à initialiser
+#define ZOBRIST_PAWNS 0
+#define ZOBRIST_H_WALLS (ZOBRIST_PAWNS + 8 * MAX_GRID_SIZE * MAX_GRID_SIZE)
+#define ZOBRIST_V_WALLS (ZOBRIST_H_WALLS + MAX_GRID_SIZE * MAX_GRID_SIZE)
+#define ZOBRIST_PLAYERS (ZOBRIST_V_WALLS + MAX_GRID_SIZE * MAX_GRID_SIZE)
+
+INLINE Uint64 QuoridorCore_pawnKey(int playerID, int i, int j)
+{
+	return Rng_mix(ZOBRIST_PAWNS + (playerID * MAX_GRID_SIZE + i) * MAX_GRID_SIZE + j);
+}
+
+INLINE Uint64 QuoridorCore_wallKey(QuoridorAction action, int i, int j)
+{
+	const int base = (action == QUORIDOR_PLAY_HORIZONTAL_WALL) ? ZOBRIST_H_WALLS : ZOBRIST_V_WALLS;
+	return Rng_mix(base + i * MAX_GRID_SIZE + j);
+}
+
+INLINE Uint64 QuoridorCore_playerKey(int playerID)
+{
+	return Rng_mix(ZOBRIST_PLAYERS + playerID);
+}
+
+Uint64 QuoridorCore_computeHash(QuoridorCore* self)
+{
+	Uint64 hash = QuoridorCore_playerKey(self->playerID);
+	for (int p = 0; p < 8; p++)
+	{
+		hash ^= QuoridorCore_pawnKey(p, self->positions[p].i, self->positions[p].j);
+	}
+	for (int i = 0; i < self->gridSize - 1; i++)
+	{
+		for (int j = 0; j < self->gridSize - 1; j++)
+		{
+			if (self->hWalls[i][j] == WALL_STATE_START)
+				hash ^= QuoridorCore_wallKey(QUORIDOR_PLAY_HORIZONTAL_WALL, i, j);
+			if (self->vWalls[i][j] == WALL_STATE_START)
+				hash ^= QuoridorCore_wallKey(QUORIDOR_PLAY_VERTICAL_WALL, i, j);
+		}
+	}
+	return hash;
+}
+
 QuoridorCore* QuoridorCore_create()
 {
 	QuoridorCore* self = (QuoridorCore*)calloc(1, sizeof(QuoridorCore));
@@ -102,6 +143,7 @@ void QuoridorCore_reset(QuoridorCore* self, int gridSize, int wallCount, int fir
 
     }
 
+	self->hash = QuoridorCore_computeHash(self);
 	QuoridorCore_updateValidMoves(self);
 }
 
@@ -1205,7 +1247,6 @@ bool QuoridorCore_isFeasible(QuoridorCore* self)
         && QuoridorCore_isFeasibleRec2(self, explored2, self->positions[2].i, self->positions[2].j)
         && QuoridorCore_isFeasibleRec3(self, explored3, self->positions[3].i, self->positions[3].j))
     {
-        printf("aaaa");
         return true;
     }
 
@@ -1273,24 +1314,26 @@ void QuoridorCore_playWall(QuoridorCore* self, WallType type, int i, int j)
 		self->vWalls[i][j] = WALL_STATE_START;
 		self->vWalls[i + 1][j] = WALL_STATE_END;
 	}
+	self->hash ^= QuoridorCore_wallKey(
+		type == WALL_TYPE_HORIZONTAL ? QUORIDOR_PLAY_HORIZONTAL_WALL : QUORIDOR_PLAY_VERTICAL_WALL, i, j);
 
 
+    self->hash ^= QuoridorCore_playerKey(self->playerID);
     self->playerID = (self->playerID + 1) % self->playerCount; // xor on change de joueur
+    self->hash ^= QuoridorCore_playerKey(self->playerID);
 
 
     QuoridorCore_updateValidMoves(self);
 
 }
 
-void QuoridorCore_moveTo(QuoridorCore* self, int i, int j)
+/// @brief Met à jour l'état de la partie si le joueur courant vient
+/// d'atteindre sa zone d'arrivée.
+static void QuoridorCore_updateState(QuoridorCore* self)
 {
-	assert(0 <= i && i < self->gridSize);
-	assert(0 <= j && j < self->gridSize);
+    const int i = self->positions[self->playerID].i;
+    const int j = self->positions[self->playerID].j;
 
-	if (QuoridorCore_canMoveTo(self, i, j) == false) return;
-
-	self->positions[self->playerID].i = i;
-	self->positions[self->playerID].j = j;
     if (self->playerCount != 8)
     {
         if (self->playerID == 0 && j == self->gridSize - 1) // joueur 0 a gagné   
@@ -1334,18 +1377,41 @@ void QuoridorCore_moveTo(QuoridorCore* self, int i, int j)
         if (i < 5 && j == 11 && self->playerID == 6)
                 self->state = QUORIDOR_STATE_P6_WON;
     }
+}
+
+void QuoridorCore_moveTo(QuoridorCore* self, int i, int j)
+{
+	assert(0 <= i && i < self->gridSize);
+	assert(0 <= j && j < self->gridSize);
+
+	if (QuoridorCore_canMoveTo(self, i, j) == false) return;
+
+	const QuoridorPos prevPos = self->positions[self->playerID];
+	self->hash ^= QuoridorCore_pawnKey(self->playerID, prevPos.i, prevPos.j);
+	self->hash ^= QuoridorCore_pawnKey(self->playerID, i, j);
 
-    // TODO
-    // Déplacez le pion.
-    // Changez l'état de la partie si le joueur vient de gagner.
+	self->positions[self->playerID].i = i;
+	self->positions[self->playerID].j = j;
+    QuoridorCore_updateState(self);
 
+    self->hash ^= QuoridorCore_playerKey(self->playerID);
     self->playerID = (self->playerID + 1) % self->playerCount; // xor on change de joueur
+    self->hash ^= QuoridorCore_playerKey(self->playerID);
 
 
     QuoridorCore_updateValidMoves(self);
 
 }
 
+void QuoridorCore_passTurn(QuoridorCore* self)
+{
+	self->hash ^= QuoridorCore_playerKey(self->playerID);
+	self->playerID = (self->playerID + 1) % self->playerCount;
+	self->hash ^= QuoridorCore_playerKey(self->playerID);
+
+	QuoridorCore_updateValidMoves(self);
+}
+
 void QuoridorCore_playTurn(QuoridorCore* self, QuoridorTurn turn)
 {
 	if (turn.action == QUORIDOR_MOVE_TO)
@@ -1366,6 +1432,352 @@ void QuoridorCore_playTurn(QuoridorCore* self, QuoridorTurn turn)
 
 }
 
+int QuoridorCore_getTurns(QuoridorCore* self, QuoridorTurn* turns)
+{
+    const int gridSize = self->gridSize;
+    int count = 0;
+
+    if (self->state != QUORIDOR_STATE_IN_PROGRESS) return 0;
+
+    for (int i = 0; i < gridSize; i++)
+    {
+        for (int j = 0; j < gridSize; j++)
+        {
+            if (self->isValid[i][j] == false) continue;
+
+            turns[count].action = QUORIDOR_MOVE_TO;
+            turns[count].i = i;
+            turns[count].j = j;
+            count++;
+        }
+    }
+
+    if (self->wallCounts[self->playerID] <= 0) return count;
+
+    for (int i = 0; i < gridSize - 1; i++)
+    {
+        for (int j = 0; j < gridSize - 1; j++)
+        {
+            if (QuoridorCore_canPlayWall(self, WALL_TYPE_HORIZONTAL, i, j))
+            {
+                turns[count].action = QUORIDOR_PLAY_HORIZONTAL_WALL;
+                turns[count].i = i;
+                turns[count].j = j;
+                count++;
+            }
+            if (QuoridorCore_canPlayWall(self, WALL_TYPE_VERTICAL, i, j))
+            {
+                turns[count].action = QUORIDOR_PLAY_VERTICAL_WALL;
+                turns[count].i = i;
+                turns[count].j = j;
+                count++;
+            }
+        }
+    }
+    assert(count <= MAX_TURN_COUNT);
+
+    return count;
+}
+
+void QuoridorCore_makeTurn(QuoridorCore* self, QuoridorTurn turn, QuoridorUndo* undo)
+{
+    const int i = turn.i;
+    const int j = turn.j;
+
+    undo->turn = turn;
+    undo->prevPos = self->positions[self->playerID];
+    undo->prevState = self->state;
+    undo->prevPlayerID = self->playerID;
+    undo->prevHash = self->hash;
+
+    switch (turn.action)
+    {
+    case QUORIDOR_MOVE_TO:
+        self->hash ^= QuoridorCore_pawnKey(self->playerID, undo->prevPos.i, undo->prevPos.j);
+        self->hash ^= QuoridorCore_pawnKey(self->playerID, i, j);
+        self->positions[self->playerID].i = i;
+        self->positions[self->playerID].j = j;
+        QuoridorCore_updateState(self);
+        break;
+
+    case QUORIDOR_PLAY_HORIZONTAL_WALL:
+        self->wallCounts[self->playerID]--;
+        self->hWalls[i][j] = WALL_STATE_START;
+        self->hWalls[i][j + 1] = WALL_STATE_END;
+        self->hash ^= QuoridorCore_wallKey(turn.action, i, j);
+        break;
+
+    case QUORIDOR_PLAY_VERTICAL_WALL:
+        self->wallCounts[self->playerID]--;
+        self->vWalls[i][j] = WALL_STATE_START;
+        self->vWalls[i + 1][j] = WALL_STATE_END;
+        self->hash ^= QuoridorCore_wallKey(turn.action, i, j);
+        break;
+
+    default:
+        assert(false);
+        return;
+    }
+
+    self->hash ^= QuoridorCore_playerKey(self->playerID);
+    self->playerID = (self->playerID + 1) % self->playerCount;
+    self->hash ^= QuoridorCore_playerKey(self->playerID);
+    QuoridorCore_updateValidMoves(self);
+}
+
+void QuoridorCore_unmakeTurn(QuoridorCore* self, const QuoridorUndo* undo)
+{
+    const int i = undo->turn.i;
+    const int j = undo->turn.j;
+
+    self->playerID = undo->prevPlayerID;
+    self->state = undo->prevState;
+    self->hash = undo->prevHash;
+    self->positions[self->playerID] = undo->prevPos;
+
+    if (undo->turn.action == QUORIDOR_PLAY_HORIZONTAL_WALL)
+    {
+        self->wallCounts[self->playerID]++;
+        self->hWalls[i][j] = WALL_STATE_NONE;
+        self->hWalls[i][j + 1] = WALL_STATE_NONE;
+    }
+    else if (undo->turn.action == QUORIDOR_PLAY_VERTICAL_WALL)
+    {
+        self->wallCounts[self->playerID]++;
+        self->vWalls[i][j] = WALL_STATE_NONE;
+        self->vWalls[i + 1][j] = WALL_STATE_NONE;
+    }
+
+    QuoridorCore_updateValidMoves(self);
+}
+
+int QuoridorTurn_toString(QuoridorTurn turn, char* buffer, int size)
+{
+    const char* suffix = "";
+    if (turn.action == QUORIDOR_PLAY_HORIZONTAL_WALL) suffix = "h";
+    else if (turn.action == QUORIDOR_PLAY_VERTICAL_WALL) suffix = "v";
+    else if (turn.action != QUORIDOR_MOVE_TO) return snprintf(buffer, size, "-");
+
+    return snprintf(buffer, size, "%c%d%s", 'a' + turn.j, turn.i + 1, suffix);
+}
+
+int QuoridorTurn_fromString(const char* str, QuoridorTurn* turn)
+{
+    int count = 0;
+    if (str[count] < 'a' || str[count] >= 'a' + MAX_GRID_SIZE) return 0;
+    const int j = str[count++] - 'a';
+
+    if (str[count] < '1' || str[count] > '9') return 0;
+    int i = 0;
+    while (str[count] >= '0' && str[count] <= '9' && i <= MAX_GRID_SIZE)
+    {
+        i = 10 * i + (str[count++] - '0');
+    }
+    if (i < 1 || i > MAX_GRID_SIZE) return 0;
+
+    turn->action = QUORIDOR_MOVE_TO;
+    turn->i = i - 1;
+    turn->j = j;
+    if (str[count] == 'h')
+    {
+        turn->action = QUORIDOR_PLAY_HORIZONTAL_WALL;
+        count++;
+    }
+    else if (str[count] == 'v')
+    {
+        turn->action = QUORIDOR_PLAY_VERTICAL_WALL;
+        count++;
+    }
+    return count;
+}
+
+int QuoridorCore_toString(QuoridorCore* self, char* buffer, int size)
+{
+    const int gridSize = self->gridSize;
+    char str[MAX_POSITION_STRING] = { 0 };
+    int length = sprintf(str, "%d ", gridSize);
+
+    for (int p = 0; p < self->playerCount; p++)
+    {
+        QuoridorTurn pawn = { 0 };
+        pawn.action = QUORIDOR_MOVE_TO;
+        pawn.i = self->positions[p].i;
+        pawn.j = self->positions[p].j;
+        if (p > 0) str[length++] = ',';
+        length += QuoridorTurn_toString(pawn, str + length, MAX_POSITION_STRING - length);
+    }
+    str[length++] = ' ';
+
+    int wallCount = 0;
+    for (int i = 0; i < gridSize - 1; i++)
+    {
+        for (int j = 0; j < gridSize - 1; j++)
+        {
+            for (int type = 0; type < 2; type++)
+            {
+                WallState state = type == 0 ? self->hWalls[i][j] : self->vWalls[i][j];
+                if (state != WALL_STATE_START) continue;
+
+                QuoridorTurn wall = { 0 };
+                wall.action = type == 0 ? QUORIDOR_PLAY_HORIZONTAL_WALL : QUORIDOR_PLAY_VERTICAL_WALL;
+                wall.i = i;
+                wall.j = j;
+                if (wallCount++ > 0) str[length++] = ',';
+                length += QuoridorTurn_toString(wall, str + length, MAX_POSITION_STRING - length);
+            }
+        }
+    }
+    if (wallCount == 0) str[length++] = '-';
+    str[length++] = ' ';
+
+    for (int p = 0; p < self->playerCount; p++)
+    {
+        length += sprintf(str + length, p > 0 ? ",%d" : "%d", self->wallCounts[p]);
+    }
+    length += sprintf(str + length, " %d", self->playerID);
+
+    return snprintf(buffer, size, "%s", str);
+}
+
+int QuoridorCore_fromString(QuoridorCore* self, const char* str)
+{
+    QuoridorCore core = { 0 };
+    int count = 0;
+    int value = 0, read = 0;
+
+    // Taille de la grille
+    while (str[count] == ' ') count++;
+    if (sscanf(str + count, "%d%n", &value, &read) != 1) return 0;
+    if (value < 3 || value > MAX_GRID_SIZE) return 0;
+    count += read;
+    const int gridSize = value;
+
+    // Pions
+    QuoridorPos positions[8] = { 0 };
+    int playerCount = 0;
+    while (str[count] == ' ') count++;
+    do
+    {
+        if (playerCount > 0) count++;
+        QuoridorTurn pawn = { 0 };
+        read = QuoridorTurn_fromString(str + count, &pawn);
+        if (read == 0 || playerCount >= 8 || pawn.action != QUORIDOR_MOVE_TO) return 0;
+        if (pawn.i >= gridSize || pawn.j >= gridSize) return 0;
+        positions[playerCount].i = pawn.i;
+        positions[playerCount].j = pawn.j;
+        playerCount++;
+        count += read;
+    } while (str[count] == ',');
+
+    if (playerCount != 2 && playerCount != 4 && playerCount != 8) return 0;
+    if (playerCount == 8 && gridSize != 17) return 0;
+
+    // Deux pions ne peuvent pas occuper la même case
+    for (int p = 0; p < playerCount; p++)
+    {
+        for (int q = p + 1; q < playerCount; q++)
+        {
+            if (positions[p].i == positions[q].i && positions[p].j == positions[q].j) return 0;
+        }
+    }
+
+    QuoridorCore_reset(&core, gridSize, 0, 0, playerCount == 8);
+    core.playerCount = playerCount;
+    for (int p = 0; p < playerCount; p++)
+    {
+        core.positions[p] = positions[p];
+    }
+
+    // Murs
+    while (str[count] == ' ') count++;
+    if (str[count] == '-')
+    {
+        count++;
+    }
+    else
+    {
+        do
+        {
+            if (str[count] == ',') count++;
+            QuoridorTurn wall = { 0 };
+            read = QuoridorTurn_fromString(str + count, &wall);
+            if (read == 0 || wall.i >= gridSize - 1 || wall.j >= gridSize - 1) return 0;
+
+            // Un mur ne peut ni en chevaucher un autre ni croiser le mur perpendiculaire de même centre
+            const int i = wall.i, j = wall.j;
+            if (wall.action == QUORIDOR_PLAY_HORIZONTAL_WALL)
+            {
+                if (core.hWalls[i][j] != WALL_STATE_NONE || core.hWalls[i][j + 1] != WALL_STATE_NONE) return 0;
+                if (core.vWalls[i][j] == WALL_STATE_START) return 0;
+                core.hWalls[i][j] = WALL_STATE_START;
+                core.hWalls[i][j + 1] = WALL_STATE_END;
+            }
+            else if (wall.action == QUORIDOR_PLAY_VERTICAL_WALL)
+            {
+                if (core.vWalls[i][j] != WALL_STATE_NONE || core.vWalls[i + 1][j] != WALL_STATE_NONE) return 0;
+                if (core.hWalls[i][j] == WALL_STATE_START) return 0;
+                core.vWalls[i][j] = WALL_STATE_START;
+                core.vWalls[i + 1][j] = WALL_STATE_END;
+            }
+            else return 0;
+            count += read;
+        } while (str[count] == ',');
+    }
+
+    // Murs restants
+    for (int p = 0; p < playerCount; p++)
+    {
+        if (p > 0 && str[count++] != ',') return 0;
+        if (sscanf(str + count, "%d%n", &value, &read) != 1 || value < 0) return 0;
+        core.wallCounts[p] = value;
+        count += read;
+    }
+
+    // Joueur courant
+    if (sscanf(str + count, "%d%n", &value, &read) != 1) return 0;
+    if (value < 0 || value >= playerCount) return 0;
+    count += read;
+
+    // Seuls des espaces peuvent suivre le joueur courant
+    for (int k = count; str[k] != '\0'; k++)
+    {
+        if (str[k] != ' ' && str[k] != '\t' && str[k] != '\r' && str[k] != '\n') return 0;
+    }
+
+    // Chaque pion doit pouvoir atteindre son objectif
+    if (!QuoridorCore_isFeasible(&core)) return 0;
+
+    // La partie peut déjà être terminée
+    for (int p = 0; p < playerCount && core.state == QUORIDOR_STATE_IN_PROGRESS; p++)
+    {
+        core.playerID = p;
+        QuoridorCore_updateState(&core);
+    }
+    core.playerID = value;
+    core.hash = QuoridorCore_computeHash(&core);
+    QuoridorCore_updateValidMoves(&core);
+
+    *self = core;
+    return count;
+}
+
+bool QuoridorCore_canPlayTurn(QuoridorCore* self, QuoridorTurn turn)
+{
+    if (self->state != QUORIDOR_STATE_IN_PROGRESS) return false;
+
+    switch (turn.action)
+    {
+    case QUORIDOR_MOVE_TO:
+        return QuoridorCore_canMoveTo(self, turn.i, turn.j);
+    case QUORIDOR_PLAY_HORIZONTAL_WALL:
+        return QuoridorCore_canPlayWall(self, WALL_TYPE_HORIZONTAL, turn.i, turn.j);
+    case QUORIDOR_PLAY_VERTICAL_WALL:
+        return QuoridorCore_canPlayWall(self, WALL_TYPE_VERTICAL, turn.i, turn.j);
+    default:
+        return false;
+    }
+}
+
 void QuoridorCore_print(QuoridorCore* self)
 {
 	const int gridSize = self->gridSize;
@@ -1412,62 +1824,3 @@ void QuoridorCore_print(QuoridorCore* self)
 	printf("\n");
 }
 
-void QuoridorCore_Undo(QuoridorCore* self, UIQuoridor* uiSelf)
-{
-
-int previousPlayer = (self->playerID + (self->playerCount - 1 )) % self->playerCount;
- 
- 
-
-
-	ListData* playerData = (ListData*)uiSelf->m_aiData[previousPlayer];
-
-
-	if (playerData == NULL || playerData->head == NULL)
-	{
-		return;//probleme d'init
-	}
-
-
-
-	QuoridorData last = ListData_popFirst(playerData);
-	if (last.action == 0)
-	{
-		return; //pas de coups en arriere
-	}
-
-
-
-
-	self->playerID = previousPlayer; //  vers le joueur qui avait jouer
-
-
-	if (last.action == QUORIDOR_PLAY_HORIZONTAL_WALL || last.action == QUORIDOR_PLAY_VERTICAL_WALL)
-	{
-
-		self->wallCounts[self->playerID]++;
-		if (last.action == QUORIDOR_PLAY_HORIZONTAL_WALL)
-		{
-			self->hWalls[last.destPos.i][last.destPos.j] = WALL_STATE_NONE;
-			self->hWalls[last.destPos.i][last.destPos.j + 1] = WALL_STATE_NONE;
-		}
-		else if (last.action == QUORIDOR_PLAY_VERTICAL_WALL)
-		{
-			self->vWalls[last.destPos.i][last.destPos.j] = WALL_STATE_NONE;
-			self->vWalls[last.destPos.i + 1][last.destPos.j] = WALL_STATE_NONE;
-		}
-	}
-	else if (last.action == QUORIDOR_MOVE_TO)
-	{
-		// Remettre le joueur à sa position d'origine
-		self->positions[self->playerID] = last.originPos;
-	}
-
-	// Réinitialiser l'état du jeu
-	self->state = QUORIDOR_STATE_IN_PROGRESS;
-
-	// Mettre à jour les mouvements valides
-	QuoridorCore_updateValidMoves(self);
-	;
-}
-
@@ -106,6 +106,10 @@ typedef struct QuoridorCore
     clock_t startTime;
     int playerCount;
 
+    /// @brief Clé de Zobrist de la position (pions, murs et joueur courant),
+    /// mise à jour à chaque action.
+    Uint64 hash;
+
 } QuoridorCore;
 
 /// @brief Crée une instance du jeu Quoridor.
@@ -160,6 +164,17 @@ void QuoridorCore_playWall(QuoridorCore *self, WallType type, int i, int j);
 /// @param j Colonne cible.
 void QuoridorCore_moveTo(QuoridorCore *self, int i, int j);
 
+/// @brief Passe le tour du joueur courant (coup nul).
+/// Interdit par les règles, ce coup ne sert qu'à la recherche de l'IA.
+/// @param self Instance du jeu Quoridor.
+void QuoridorCore_passTurn(QuoridorCore *self);
+
+/// @brief Recalcule les cases accessibles (isValid) pour le joueur courant.
+/// À appeler après une modification directe des membres du plateau
+/// (par exemple de playerCount).
+/// @param self Instance du jeu Quoridor.
+void QuoridorCore_updateValidMoves(QuoridorCore *self);
+
 /// @brief Affiche le plateau sur la sortie standard.
 /// @param self Instance du jeu Quoridor.
 void QuoridorCore_print(QuoridorCore *self);
@@ -199,6 +214,108 @@ typedef struct QuoridorTurn
 /// @param turn Action à effectuer.
 void QuoridorCore_playTurn(QuoridorCore *self, QuoridorTurn turn);
 
+/// @brief Calcule entièrement la clé de Zobrist d'une position.
+/// La clé est normalement tenue à jour dans QuoridorCore::hash ; cette fonction
+/// sert après une modification directe des champs de la partie.
+/// @param self Instance du jeu Quoridor.
+/// @return La clé de la position.
+Uint64 QuoridorCore_computeHash(QuoridorCore *self);
+
+/// @brief Nombre maximal d'actions possibles pour le joueur courant
+/// (tous les murs du plateau plus les déplacements à distance 2 au plus).
+#define MAX_TURN_COUNT (2 * (MAX_GRID_SIZE - 1) * (MAX_GRID_SIZE - 1) + 16)
+
+/// @brief Informations nécessaires pour annuler une action jouée avec
+/// QuoridorCore_makeTurn().
+typedef struct QuoridorUndo
+{
+    /// @brief Action jouée.
+    QuoridorTurn turn;
+
+    /// @brief Position du pion du joueur avant l'action.
+    QuoridorPos prevPos;
+
+    /// @brief État de la partie avant l'action.
+    QuoridorState prevState;
+
+    /// @brief Identifiant du joueur ayant joué l'action.
+    int prevPlayerID;
+
+    /// @brief Clé de la position avant l'action.
+    Uint64 prevHash;
+} QuoridorUndo;
+
+/// @brief Génère toutes les actions légales du joueur courant.
+/// Les déplacements sont listés en premier (ligne par ligne),
+/// puis les murs par ligne, colonne et type (horizontal puis vertical).
+/// @param self Instance du jeu Quoridor.
+/// @param turns Tableau (préalloué, taille MAX_TURN_COUNT) dans lequel sont écrites les actions.
+/// @return Le nombre d'actions générées (0 si la partie est terminée).
+int QuoridorCore_getTurns(QuoridorCore *self, QuoridorTurn *turns);
+
+/// @brief Joue une action sur place et enregistre de quoi l'annuler.
+/// Contrairement à QuoridorCore_playTurn(), cette fonction ne vérifie pas
+/// la validité du coup : l'action doit provenir de QuoridorCore_getTurns().
+/// @param self Instance du jeu Quoridor.
+/// @param turn Action à effectuer.
+/// @param undo Adresse où sont écrites les informations d'annulation.
+void QuoridorCore_makeTurn(QuoridorCore *self, QuoridorTurn turn, QuoridorUndo *undo);
+
+/// @brief Annule une action jouée avec QuoridorCore_makeTurn().
+/// Les actions doivent être annulées dans l'ordre inverse où elles ont été jouées.
+/// @param self Instance du jeu Quoridor.
+/// @param undo Informations d'annulation remplies par QuoridorCore_makeTurn().
+void QuoridorCore_unmakeTurn(QuoridorCore *self, const QuoridorUndo *undo);
+
+/// @brief Écrit une action en notation compacte.
+/// Un déplacement s'écrit avec la colonne (lettre à partir de 'a') et la ligne
+/// (nombre à partir de 1), par exemple "e5". Un mur ajoute le suffixe 'h' ou 'v',
+/// par exemple "c3h".
+/// @param turn Action à écrire.
+/// @param buffer Tampon de destination.
+/// @param size Taille du tampon.
+/// @return Le nombre de caractères écrits.
+int QuoridorTurn_toString(QuoridorTurn turn, char *buffer, int size);
+
+/// @brief Lit une action écrite en notation compacte (voir QuoridorTurn_toString()).
+/// La validité de l'action sur le plateau n'est pas vérifiée,
+/// utiliser QuoridorCore_canPlayTurn().
+/// @param str Chaîne à lire.
+/// @param turn Adresse où est écrite l'action lue.
+/// @return Le nombre de caractères lus, ou 0 si la chaîne n'est pas une action.
+int QuoridorTurn_fromString(const char *str, QuoridorTurn *turn);
+
+/// @brief Taille suffisante pour écrire n'importe quelle position avec QuoridorCore_toString().
+#define MAX_POSITION_STRING 4096
+
+/// @brief Écrit la position en notation compacte, sur une ligne.
+/// La notation contient cinq champs séparés par des espaces :
+/// la taille de la grille, les cases des pions (une par joueur),
+/// les murs posés ('-' s'il n'y en a aucun), les murs restants de chaque joueur
+/// et l'indice du joueur qui doit jouer (à partir de 0).
+/// Par exemple "9 c5,i5 c3h,f4v 9,10 1".
+/// @param self Instance du jeu Quoridor.
+/// @param buffer Tampon de destination.
+/// @param size Taille du tampon (MAX_POSITION_STRING suffit toujours).
+/// @return Le nombre de caractères écrits.
+int QuoridorCore_toString(QuoridorCore *self, char *buffer, int size);
+
+/// @brief Lit une position écrite avec QuoridorCore_toString().
+/// Le nombre de joueurs est déduit du nombre de pions.
+/// La position est refusée si deux pions occupent la même case, si des murs se chevauchent
+/// ou se croisent, si un pion ne peut plus atteindre son objectif ou si autre chose que des
+/// espaces suit le joueur courant. En cas d'échec, la partie n'est pas modifiée.
+/// @param self Instance du jeu Quoridor.
+/// @param str Chaîne à lire.
+/// @return Le nombre de caractères lus, ou 0 si la chaîne n'est pas une position valide.
+int QuoridorCore_fromString(QuoridorCore *self, const char *str);
+
+/// @brief Vérifie si le joueur courant peut jouer une action.
+/// @param self Instance du jeu Quoridor.
+/// @param turn Action à vérifier.
+/// @return true si l'action est possible, false sinon.
+bool QuoridorCore_canPlayTurn(QuoridorCore *self, QuoridorTurn turn);
+
 
 /// @brief Vérifie s'il y a un mur horizontal au-dessus de [i,j].
 /// Le bord supérieur est considéré comme un mur.
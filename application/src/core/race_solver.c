@@ -0,0 +1,254 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/race_solver.h"
+#include "core/utils.h"
+#include "core/trace.h"
+
+RaceSolver *RaceSolver_create()
+{
+    RaceSolver *self = (RaceSolver *)calloc(1, sizeof(RaceSolver));
+    AssertNew(self);
+    return self;
+}
+
+void RaceSolver_destroy(RaceSolver *self)
+{
+    if (!self) return;
+    free(self->entries);
+    free(self);
+}
+
+bool RaceSolver_canSolve(QuoridorCore *core)
+{
+    if (core->playerCount != 2 || core->state != QUORIDOR_STATE_IN_PROGRESS)
+        return false;
+    return core->wallCounts[0] == 0 && core->wallCounts[1] == 0;
+}
+
+/// @brief Renvoie l'indice d'une position : joueur qui doit jouer, puis case de chaque pion.
+static int RaceSolver_getState(int gridSize, int playerID, int cell0, int cell1)
+{
+    const int cellCount = gridSize * gridSize;
+    return (playerID * cellCount + cell0) * cellCount + cell1;
+}
+
+/// @brief Indique si une case est dans la zone d'arrivée d'un joueur (partie à deux joueurs).
+static bool RaceSolver_isGoal(int gridSize, int playerID, int cell)
+{
+    const int j = cell % gridSize;
+    return (playerID == 0) ? (j == gridSize - 1) : (j == 0);
+}
+
+/// @brief Indique si la table résolue correspond aux murs d'une position.
+static bool RaceSolver_isSolved(RaceSolver *self, QuoridorCore *core)
+{
+    return self->gridSize == core->gridSize
+        && memcmp(self->vWalls, core->vWalls, sizeof(self->vWalls)) == 0
+        && memcmp(self->hWalls, core->hWalls, sizeof(self->hWalls)) == 0;
+}
+
+/// @brief Résout toutes les positions de course avec les murs d'une position.
+/// Les positions perdues (l'adversaire vient d'arriver) sont propagées vers leurs
+/// prédécesseurs dans l'ordre croissant du nombre de plies : un prédécesseur d'une
+/// position perdue est gagné, un prédécesseur dont toutes les actions mènent à une
+/// position gagnée est perdu. Les positions jamais atteintes sont nulles.
+static void RaceSolver_solve(RaceSolver *self, QuoridorCore *core)
+{
+    TRACE_SCOPE_BEGIN("RaceSolver_solve");
+
+    const int gridSize = core->gridSize;
+    const int cellCount = gridSize * gridSize;
+    const int stateCount = 2 * cellCount * cellCount;
+
+    if (self->capacity < stateCount)
+    {
+        free(self->entries);
+        self->entries = (RaceEntry *)calloc(stateCount, sizeof(RaceEntry));
+        AssertNew(self->entries);
+        self->capacity = stateCount;
+    }
+    RaceEntry *entries = self->entries;
+
+    // Actions de chaque position, dans un tableau unique (au plus 5 par position)
+    int *childStart = (int *)calloc(stateCount + 1, sizeof(int));
+    int *children = (int *)calloc((size_t)stateCount * 5, sizeof(int));
+    Uint8 *remaining = (Uint8 *)calloc(stateCount, sizeof(Uint8));
+    AssertNew(childStart);
+    AssertNew(children);
+    AssertNew(remaining);
+
+    QuoridorCore scratch = *core;
+    scratch.state = QUORIDOR_STATE_IN_PROGRESS;
+    int childCount = 0;
+
+    for (int state = 0; state < stateCount; state++)
+    {
+        const int cell1 = state % cellCount;
+        const int cell0 = (state / cellCount) % cellCount;
+        const int playerID = state / (cellCount * cellCount);
+        const int cells[2] = { cell0, cell1 };
+
+        entries[state].result = RACE_RESULT_DRAW;
+        entries[state].plies = 0;
+        childStart[state] = childCount;
+
+        // Positions impossibles ou finies : l'adversaire vient d'arriver
+        if (cell0 == cell1 || RaceSolver_isGoal(gridSize, playerID, cells[playerID]))
+            continue;
+        if (RaceSolver_isGoal(gridSize, playerID ^ 1, cells[playerID ^ 1]))
+        {
+            entries[state].result = RACE_RESULT_LOSS;
+            continue;
+        }
+
+        scratch.playerID = playerID;
+        scratch.positions[0].i = cell0 / gridSize;
+        scratch.positions[0].j = cell0 % gridSize;
+        scratch.positions[1].i = cell1 / gridSize;
+        scratch.positions[1].j = cell1 % gridSize;
+        QuoridorCore_updateValidMoves(&scratch);
+
+        for (int i = 0; i < gridSize; i++)
+        {
+            for (int j = 0; j < gridSize; j++)
+            {
+                if (!scratch.isValid[i][j])
+                    continue;
+
+                int next[2] = { cell0, cell1 };
+                next[playerID] = i * gridSize + j;
+                children[childCount++] = RaceSolver_getState(gridSize, playerID ^ 1, next[0], next[1]);
+                remaining[state]++;
+            }
+        }
+    }
+    childStart[stateCount] = childCount;
+
+    // Prédécesseurs de chaque position
+    int *parentStart = (int *)calloc(stateCount + 1, sizeof(int));
+    int *parents = (int *)calloc(Int_max(1, childCount), sizeof(int));
+    int *queue = (int *)calloc(stateCount, sizeof(int));
+    AssertNew(parentStart);
+    AssertNew(parents);
+    AssertNew(queue);
+
+    for (int k = 0; k < childCount; k++)
+        parentStart[children[k] + 1]++;
+    for (int state = 0; state < stateCount; state++)
+        parentStart[state + 1] += parentStart[state];
+
+    // La file sert de curseur d'écriture le temps du remplissage
+    memcpy(queue, parentStart, stateCount * sizeof(int));
+    for (int state = 0; state < stateCount; state++)
+    {
+        for (int k = childStart[state]; k < childStart[state + 1]; k++)
+            parents[queue[children[k]]++] = state;
+    }
+
+    int head = 0, tail = 0;
+    for (int state = 0; state < stateCount; state++)
+    {
+        if (entries[state].result == RACE_RESULT_LOSS)
+            queue[tail++] = state;
+    }
+
+    while (head < tail)
+    {
+        const int state = queue[head++];
+        const RaceEntry entry = entries[state];
+
+        for (int k = parentStart[state]; k < parentStart[state + 1]; k++)
+        {
+            const int parent = parents[k];
+            if (entries[parent].result != RACE_RESULT_DRAW)
+                continue;
+
+            if (entry.result == RACE_RESULT_LOSS)
+            {
+                entries[parent].result = RACE_RESULT_WIN;
+                entries[parent].plies = entry.plies + 1;
+                queue[tail++] = parent;
+            }
+            else if (--remaining[parent] == 0)
+            {
+                entries[parent].result = RACE_RESULT_LOSS;
+                entries[parent].plies = entry.plies + 1;
+                queue[tail++] = parent;
+            }
+        }
+    }
+
+    free(childStart);
+    free(children);
+    free(remaining);
+    free(parentStart);
+    free(parents);
+    free(queue);
+
+    self->gridSize = gridSize;
+    memcpy(self->vWalls, core->vWalls, sizeof(self->vWalls));
+    memcpy(self->hWalls, core->hWalls, sizeof(self->hWalls));
+    self->solveCount++;
+
+    TRACE_SCOPE_END();
+}
+
+bool RaceSolver_isBetter(RaceEntry a, RaceEntry b)
+{
+    // Rang du résultat pour le joueur qui choisit : victoire, nulle, défaite
+    const int rankA = (a.result == RACE_RESULT_LOSS) ? 2 : (a.result == RACE_RESULT_DRAW) ? 1 : 0;
+    const int rankB = (b.result == RACE_RESULT_LOSS) ? 2 : (b.result == RACE_RESULT_DRAW) ? 1 : 0;
+    if (rankA != rankB)
+        return rankA > rankB;
+
+    // Victoire au plus vite, défaite au plus tard
+    if (a.result == RACE_RESULT_LOSS)
+        return a.plies < b.plies;
+    return a.plies > b.plies;
+}
+
+QuoridorTurn RaceSolver_getBestTurn(RaceSolver *self, QuoridorCore *core, RaceEntry *entry)
+{
+    assert(RaceSolver_canSolve(core));
+
+    if (RaceSolver_isSolved(self, core) == false)
+        RaceSolver_solve(self, core);
+
+    const int gridSize = core->gridSize;
+    const int playerID = core->playerID;
+    const int cells[2] = {
+        core->positions[0].i * gridSize + core->positions[0].j,
+        core->positions[1].i * gridSize + core->positions[1].j
+    };
+
+    QuoridorTurn bestTurn = { 0 };
+    RaceEntry bestEntry = { 0 };
+    for (int i = 0; i < gridSize; i++)
+    {
+        for (int j = 0; j < gridSize; j++)
+        {
+            if (!core->isValid[i][j])
+                continue;
+
+            int next[2] = { cells[0], cells[1] };
+            next[playerID] = i * gridSize + j;
+            const RaceEntry childEntry = self->entries[RaceSolver_getState(gridSize, playerID ^ 1, next[0], next[1])];
+
+            if (bestTurn.action == QUORIDOR_ACTION_UNDEFINED || RaceSolver_isBetter(childEntry, bestEntry))
+            {
+                bestTurn.action = QUORIDOR_MOVE_TO;
+                bestTurn.i = i;
+                bestTurn.j = j;
+                bestEntry = childEntry;
+            }
+        }
+    }
+
+    if (entry)
+        *entry = self->entries[RaceSolver_getState(gridSize, playerID, cells[0], cells[1])];
+    return bestTurn;
+}
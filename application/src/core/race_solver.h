@@ -0,0 +1,89 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+
+/// @brief Résultat exact d'une course pour le joueur qui doit jouer.
+typedef enum RaceResult
+{
+    /// @brief Aucun joueur ne peut forcer la victoire (les pions se bloquent indéfiniment).
+    RACE_RESULT_DRAW,
+
+    /// @brief Le joueur qui doit jouer gagne.
+    RACE_RESULT_WIN,
+
+    /// @brief Le joueur qui doit jouer perd.
+    RACE_RESULT_LOSS,
+} RaceResult;
+
+/// @brief Valeur exacte d'une position de course.
+typedef struct RaceEntry
+{
+    /// @brief Résultat pour le joueur qui doit jouer (RaceResult).
+    Uint8 result;
+
+    /// @brief Nombre de plies avant la fin de la partie, quand les deux joueurs
+    /// jouent au mieux (le gagnant au plus court, le perdant au plus long).
+    Uint16 plies;
+} RaceEntry;
+
+/// @brief Solveur exact des fins de partie à deux joueurs sans mur restant.
+/// Les murs ne bougent plus : une position ne dépend que des deux pions et du joueur
+/// qui doit jouer. Toutes ces positions sont résolues par analyse rétrograde, en tenant
+/// compte des sauts et des blocages entre les pions, puis la table est conservée
+/// tant que les murs du plateau restent les mêmes : les coups suivants sont de simples lectures.
+typedef struct RaceSolver
+{
+    /// @brief Taille de la grille de la table résolue (0 si aucune).
+    int gridSize;
+
+    /// @brief Murs de la table résolue.
+    WallState vWalls[MAX_GRID_SIZE][MAX_GRID_SIZE];
+    WallState hWalls[MAX_GRID_SIZE][MAX_GRID_SIZE];
+
+    /// @brief Valeur de chaque position, indexée par RaceSolver_getState().
+    RaceEntry *entries;
+
+    /// @brief Nombre de positions allouées.
+    int capacity;
+
+    /// @brief Nombre de résolutions complètes (une par disposition des murs).
+    int solveCount;
+} RaceSolver;
+
+/// @brief Crée un solveur sans table.
+/// @return Le solveur créé.
+RaceSolver *RaceSolver_create();
+
+/// @brief Détruit un solveur.
+/// @param self Le solveur.
+void RaceSolver_destroy(RaceSolver *self);
+
+/// @brief Indique si une position est une course que le solveur sait résoudre :
+/// partie à deux joueurs en cours, sans mur restant à aucun joueur.
+/// @param core La position.
+bool RaceSolver_canSolve(QuoridorCore *core);
+
+/// @brief Renvoie le meilleur coup d'une course (voir RaceSolver_canSolve()).
+/// Le gagnant choisit la victoire la plus rapide, le perdant la défaite la plus lente
+/// et, dans une position nulle, le joueur évite les coups perdants.
+/// La table est recalculée si les murs ont changé depuis la dernière résolution.
+/// @param self Le solveur.
+/// @param core La position.
+/// @param entry Valeur exacte de la position pour le joueur qui doit jouer (peut être NULL).
+/// @return Le meilleur coup.
+QuoridorTurn RaceSolver_getBestTurn(RaceSolver *self, QuoridorCore *core, RaceEntry *entry);
+
+/// @brief Compare deux actions du point de vue du joueur qui les choisit,
+/// d'après la valeur des positions atteintes (pour l'adversaire) : victoire au plus vite,
+/// puis nulle, puis défaite au plus tard.
+/// @param a Valeur de la position atteinte par la première action.
+/// @param b Valeur de la position atteinte par la seconde action.
+/// @return true si l'action menant à a est meilleure que celle menant à b.
+bool RaceSolver_isBetter(RaceEntry a, RaceEntry b);
@@ -0,0 +1,767 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/tablebase.h"
+#include "core/utils.h"
+#include "core/trace.h"
+
+static const char g_tablebaseMagic[4] = { 'Q', 'T', 'B', 'L' };
+
+/// @brief Nombre maximal d'emplacements de murs.
+#define TABLEBASE_MAX_SLOTS (2 * (TABLEBASE_MAX_GRID_SIZE - 1) * (TABLEBASE_MAX_GRID_SIZE - 1))
+
+/// @brief Nombre maximal de déplacements d'un pion, sauts compris.
+#define TABLEBASE_MAX_MOVES 5
+
+/// @brief Nombre maximal de plies stocké dans un octet.
+#define TABLEBASE_MAX_PLIES 254
+
+/// @brief Renvoie l'indice d'une position dans les positions d'une disposition de murs
+/// et de murs restants : joueur qui doit jouer, puis case de chaque pion.
+static int Tablebase_getState(int cellCount, int playerID, int cell0, int cell1)
+{
+    return (playerID * cellCount + cell0) * cellCount + cell1;
+}
+
+/// @brief Indique si une case est dans la zone d'arrivée d'un joueur (partie à deux joueurs).
+static bool Tablebase_isGoal(int gridSize, int playerID, int cell)
+{
+    const int j = cell % gridSize;
+    return (playerID == 0) ? (j == gridSize - 1) : (j == 0);
+}
+
+/// @brief Renvoie le nombre de murs d'un masque.
+static int Tablebase_countWalls(Uint32 mask)
+{
+    int count = 0;
+    for (; mask; mask &= mask - 1)
+        count++;
+    return count;
+}
+
+/// @brief Renvoie l'indice d'un groupe de positions parmi ceux d'une disposition de murs.
+/// Chaque joueur a au plus wallCount murs restants, et les murs posés et restants
+/// ne dépassent pas ceux du début de la partie.
+static int Tablebase_getSliceIndex(int wallCount, int placed, int wallCount0, int wallCount1)
+{
+    int index = 0;
+    for (int w0 = 0; w0 < wallCount0; w0++)
+        index += Int_max(0, Int_min(wallCount, 2 * wallCount - placed - w0) + 1);
+    return index + wallCount1;
+}
+
+/// @brief Renvoie le nombre de groupes de positions d'une disposition de murs.
+static int Tablebase_getSliceCount(int wallCount, int placed)
+{
+    return Tablebase_getSliceIndex(wallCount, placed, wallCount + 1, 0);
+}
+
+/// @brief Renvoie le début des positions d'une disposition de murs et de murs restants.
+static size_t Tablebase_getSliceOffset(int gridSize, int wallCount, TablebaseMask mask, int wallCount0, int wallCount1)
+{
+    const size_t cellCount = (size_t)gridSize * gridSize;
+    const int placed = Tablebase_countWalls(mask.walls);
+    const size_t slice = (size_t)mask.firstSlice + Tablebase_getSliceIndex(wallCount, placed, wallCount0, wallCount1);
+    return slice * 2 * cellCount * cellCount;
+}
+
+/// @brief Place les murs d'un masque sur le plateau (les autres murs sont retirés).
+static void Tablebase_setWalls(QuoridorCore *core, Uint32 mask)
+{
+    const int n = core->gridSize - 1;
+    memset(core->hWalls, 0, sizeof(core->hWalls));
+    memset(core->vWalls, 0, sizeof(core->vWalls));
+
+    for (int slot = 0; slot < 2 * n * n; slot++)
+    {
+        if ((mask & (1u << slot)) == 0)
+            continue;
+
+        const int i = (slot % (n * n)) / n;
+        const int j = slot % n;
+        if (slot < n * n)
+        {
+            core->hWalls[i][j] = WALL_STATE_START;
+            core->hWalls[i][j + 1] = WALL_STATE_END;
+        }
+        else
+        {
+            core->vWalls[i][j] = WALL_STATE_START;
+            core->vWalls[i + 1][j] = WALL_STATE_END;
+        }
+    }
+}
+
+/// @brief Renvoie le masque des murs posés sur le plateau.
+static Uint32 Tablebase_getMask(QuoridorCore *core)
+{
+    const int n = core->gridSize - 1;
+    Uint32 mask = 0;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            if (core->hWalls[i][j] == WALL_STATE_START)
+                mask |= 1u << (i * n + j);
+            if (core->vWalls[i][j] == WALL_STATE_START)
+                mask |= 1u << (n * n + i * n + j);
+        }
+    }
+    return mask;
+}
+
+/// @brief Renvoie l'indice d'une disposition de murs dans un tableau trié, ou -1 si elle n'y est pas.
+static int Tablebase_findMask(const TablebaseMask *masks, int maskCount, Uint32 walls)
+{
+    int lo = 0, hi = maskCount - 1;
+    while (lo <= hi)
+    {
+        const int mid = (lo + hi) / 2;
+        if (masks[mid].walls == walls)
+            return mid;
+        if (masks[mid].walls < walls)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return -1;
+}
+
+/// @brief Renvoie l'ensemble des cases (un bit par case) depuis lesquelles un joueur
+/// peut atteindre son arrivée avec les murs du plateau, sans tenir compte des pions
+/// comme QuoridorCore_isFeasible().
+static Uint32 Tablebase_getReach(QuoridorCore *core, int playerID)
+{
+    const int gridSize = core->gridSize;
+    int queue[TABLEBASE_MAX_GRID_SIZE * TABLEBASE_MAX_GRID_SIZE] = { 0 };
+    int head = 0, tail = 0;
+    Uint32 reach = 0;
+
+    for (int cell = 0; cell < gridSize * gridSize; cell++)
+    {
+        if (Tablebase_isGoal(gridSize, playerID, cell))
+        {
+            reach |= 1u << cell;
+            queue[tail++] = cell;
+        }
+    }
+
+    while (head < tail)
+    {
+        const int cell = queue[head++];
+        const int i = cell / gridSize;
+        const int j = cell % gridSize;
+
+        int next[4] = { -1, -1, -1, -1 };
+        if (!QuoridorCore_hasWallAbove(core, i, j)) next[0] = cell - gridSize;
+        if (!QuoridorCore_hasWallBelow(core, i, j)) next[1] = cell + gridSize;
+        if (!QuoridorCore_hasWallLeft(core, i, j)) next[2] = cell - 1;
+        if (!QuoridorCore_hasWallRight(core, i, j)) next[3] = cell + 1;
+
+        for (int k = 0; k < 4; k++)
+        {
+            if (next[k] < 0 || (reach & (1u << next[k])))
+                continue;
+            reach |= 1u << next[k];
+            queue[tail++] = next[k];
+        }
+    }
+    return reach;
+}
+
+//------------------------------------------------------------------------------
+// Génération
+
+typedef struct TablebaseBuilder
+{
+    int gridSize;
+    int wallCount;
+    int cellCount;
+    int slotCount;
+
+    /// @brief Nombre de positions d'une disposition de murs et de murs restants.
+    int sliceSize;
+
+    /// @brief Emplacements incompatibles avec chaque emplacement (lui compris),
+    /// comme dans QuoridorCore_canPlayWall().
+    Uint32 conflicts[TABLEBASE_MAX_SLOTS];
+
+    /// @brief Dispositions de murs, triées.
+    TablebaseMask *masks;
+    int maskCount;
+    int maskCapacity;
+
+    /// @brief Nombre de groupes de positions.
+    int sliceCount;
+
+    /// @brief Cases depuis lesquelles chaque joueur peut arriver (deux par disposition).
+    Uint32 *reach;
+
+    /// @brief Valeur de chaque position, au format du fichier.
+    Uint8 *entries;
+
+    /// @brief Nombre total de murs restants des positions en cours de résolution.
+    int remainingWalls;
+
+    /// @brief Prochaine disposition de murs à résoudre.
+    SDL_AtomicInt nextMask;
+} TablebaseBuilder;
+
+typedef struct TablebaseWorker
+{
+    TablebaseBuilder *builder;
+
+    /// @brief Plateau servant à générer les déplacements.
+    QuoridorCore core;
+
+    /// @brief Déplacements de chaque position et leurs prédécesseurs.
+    int *childStart;
+    int *children;
+    int *parentStart;
+    int *parents;
+
+    /// @brief Nombre d'actions de chaque position qui ne mènent pas encore à une victoire de l'adversaire.
+    Uint8 *remaining;
+
+    /// @brief Positions résolues, par nombre de plies croissant.
+    int *queue;
+
+    /// @brief Positions dont un mur mène à une position résolue, triées par nombre de plies.
+    int *events;
+    int *eventStates;
+    Uint8 *eventPlies;
+    int eventStart[TABLEBASE_MAX_PLIES + 2];
+    int eventCursor[TABLEBASE_MAX_PLIES + 2];
+
+    /// @brief Indice de la disposition obtenue avec chaque mur (-1 si le mur est impossible).
+    int childMasks[TABLEBASE_MAX_SLOTS];
+} TablebaseWorker;
+
+static void TablebaseBuilder_addMask(TablebaseBuilder *self, Uint32 walls)
+{
+    if (self->maskCount == self->maskCapacity)
+    {
+        self->maskCapacity = Int_max(1024, 2 * self->maskCapacity);
+        self->masks = (TablebaseMask *)realloc(self->masks, self->maskCapacity * sizeof(TablebaseMask));
+        AssertNew(self->masks);
+    }
+    self->masks[self->maskCount].walls = walls;
+    self->masks[self->maskCount].firstSlice = 0;
+    self->maskCount++;
+}
+
+/// @brief Ajoute toutes les dispositions compatibles obtenues en ajoutant
+/// au plus wallLeft murs d'emplacement au moins firstSlot.
+static void TablebaseBuilder_addMasks(TablebaseBuilder *self, Uint32 walls, int firstSlot, int wallLeft)
+{
+    TablebaseBuilder_addMask(self, walls);
+    if (wallLeft == 0)
+        return;
+
+    for (int slot = firstSlot; slot < self->slotCount; slot++)
+    {
+        if ((walls & self->conflicts[slot]) == 0)
+            TablebaseBuilder_addMasks(self, walls | (1u << slot), slot + 1, wallLeft - 1);
+    }
+}
+
+static int TablebaseBuilder_compareMasks(const void *a, const void *b)
+{
+    const Uint32 wallsA = ((const TablebaseMask *)a)->walls;
+    const Uint32 wallsB = ((const TablebaseMask *)b)->walls;
+    return (wallsA > wallsB) - (wallsA < wallsB);
+}
+
+static void TablebaseBuilder_init(TablebaseBuilder *self, int gridSize, int wallCount)
+{
+    const int n = gridSize - 1;
+    self->gridSize = gridSize;
+    self->wallCount = wallCount;
+    self->cellCount = gridSize * gridSize;
+    self->slotCount = 2 * n * n;
+    self->sliceSize = 2 * self->cellCount * self->cellCount;
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            const int h = i * n + j;
+            const int v = n * n + h;
+            self->conflicts[h] = (1u << h) | (1u << v);
+            self->conflicts[v] = (1u << v) | (1u << h);
+            if (j > 0) self->conflicts[h] |= 1u << (h - 1);
+            if (j < n - 1) self->conflicts[h] |= 1u << (h + 1);
+            if (i > 0) self->conflicts[v] |= 1u << (v - n);
+            if (i < n - 1) self->conflicts[v] |= 1u << (v + n);
+        }
+    }
+
+    TablebaseBuilder_addMasks(self, 0, 0, 2 * wallCount);
+    qsort(self->masks, self->maskCount, sizeof(TablebaseMask), TablebaseBuilder_compareMasks);
+
+    // Retire les dispositions qui ferment l'arrivée d'un joueur
+    self->reach = (Uint32 *)calloc(2 * (size_t)self->maskCount, sizeof(Uint32));
+    AssertNew(self->reach);
+
+    QuoridorCore core = { 0 };
+    core.gridSize = gridSize;
+    int count = 0;
+    for (int m = 0; m < self->maskCount; m++)
+    {
+        const Uint32 walls = self->masks[m].walls;
+        Tablebase_setWalls(&core, walls);
+        const Uint32 reach0 = Tablebase_getReach(&core, 0);
+        const Uint32 reach1 = Tablebase_getReach(&core, 1);
+        if (reach0 == 0 || reach1 == 0)
+            continue;
+
+        self->masks[count].walls = walls;
+        self->masks[count].firstSlice = self->sliceCount;
+        self->sliceCount += Tablebase_getSliceCount(wallCount, Tablebase_countWalls(walls));
+        self->reach[2 * count] = reach0;
+        self->reach[2 * count + 1] = reach1;
+        count++;
+    }
+    self->maskCount = count;
+
+    const size_t entryCount = (size_t)self->sliceCount * self->sliceSize;
+    self->entries = (Uint8 *)calloc(entryCount, sizeof(Uint8));
+    AssertNew(self->entries);
+}
+
+static void TablebaseWorker_init(TablebaseWorker *self, TablebaseBuilder *builder)
+{
+    const int sliceSize = builder->sliceSize;
+    self->builder = builder;
+
+    QuoridorCore_reset(&(self->core), builder->gridSize, 0, 0, 0);
+    self->core.playerCount = 2;
+    self->core.state = QUORIDOR_STATE_IN_PROGRESS;
+
+    self->childStart = (int *)calloc(sliceSize + 1, sizeof(int));
+    self->children = (int *)calloc((size_t)sliceSize * TABLEBASE_MAX_MOVES, sizeof(int));
+    self->parentStart = (int *)calloc(sliceSize + 1, sizeof(int));
+    self->parents = (int *)calloc((size_t)sliceSize * TABLEBASE_MAX_MOVES, sizeof(int));
+    self->remaining = (Uint8 *)calloc(sliceSize, sizeof(Uint8));
+    self->queue = (int *)calloc(sliceSize, sizeof(int));
+    self->events = (int *)calloc((size_t)sliceSize * builder->slotCount, sizeof(int));
+    self->eventStates = (int *)calloc((size_t)sliceSize * builder->slotCount, sizeof(int));
+    self->eventPlies = (Uint8 *)calloc((size_t)sliceSize * builder->slotCount, sizeof(Uint8));
+    AssertNew(self->childStart);
+    AssertNew(self->children);
+    AssertNew(self->parentStart);
+    AssertNew(self->parents);
+    AssertNew(self->remaining);
+    AssertNew(self->queue);
+    AssertNew(self->events);
+    AssertNew(self->eventStates);
+    AssertNew(self->eventPlies);
+}
+
+static void TablebaseWorker_quit(TablebaseWorker *self)
+{
+    free(self->childStart);
+    free(self->children);
+    free(self->parentStart);
+    free(self->parents);
+    free(self->remaining);
+    free(self->queue);
+    free(self->events);
+    free(self->eventStates);
+    free(self->eventPlies);
+}
+
+/// @brief Indique si une position est en cours : pions sur des cases différentes
+/// et aucun pion sur son arrivée.
+static bool TablebaseWorker_isActive(int gridSize, int cell0, int cell1)
+{
+    return cell0 != cell1 && !Tablebase_isGoal(gridSize, 0, cell0) && !Tablebase_isGoal(gridSize, 1, cell1);
+}
+
+/// @brief Calcule les déplacements de toutes les positions d'une disposition de murs
+/// (avec sauts et blocages entre les pions) et les murs possibles.
+static void TablebaseWorker_prepareMask(TablebaseWorker *self, int maskIndex)
+{
+    TablebaseBuilder *builder = self->builder;
+    const int gridSize = builder->gridSize;
+    const int cellCount = builder->cellCount;
+    const int sliceSize = builder->sliceSize;
+    const Uint32 mask = builder->masks[maskIndex].walls;
+    QuoridorCore *core = &(self->core);
+
+    Tablebase_setWalls(core, mask);
+
+    int childCount = 0;
+    for (int state = 0; state < sliceSize; state++)
+    {
+        const int cell1 = state % cellCount;
+        const int cell0 = (state / cellCount) % cellCount;
+        const int playerID = state / (cellCount * cellCount);
+
+        self->childStart[state] = childCount;
+        if (!TablebaseWorker_isActive(gridSize, cell0, cell1))
+            continue;
+
+        core->playerID = playerID;
+        core->positions[0].i = cell0 / gridSize;
+        core->positions[0].j = cell0 % gridSize;
+        core->positions[1].i = cell1 / gridSize;
+        core->positions[1].j = cell1 % gridSize;
+        QuoridorCore_updateValidMoves(core);
+
+        for (int i = 0; i < gridSize; i++)
+        {
+            for (int j = 0; j < gridSize; j++)
+            {
+                if (!core->isValid[i][j])
+                    continue;
+
+                int next[2] = { cell0, cell1 };
+                next[playerID] = i * gridSize + j;
+                assert(childCount < sliceSize * TABLEBASE_MAX_MOVES);
+                self->children[childCount++] = Tablebase_getState(cellCount, playerID ^ 1, next[0], next[1]);
+            }
+        }
+    }
+    self->childStart[sliceSize] = childCount;
+
+    memset(self->parentStart, 0, (sliceSize + 1) * sizeof(int));
+    for (int k = 0; k < childCount; k++)
+        self->parentStart[self->children[k] + 1]++;
+    for (int state = 0; state < sliceSize; state++)
+        self->parentStart[state + 1] += self->parentStart[state];
+
+    // La file sert de curseur d'écriture le temps du remplissage
+    memcpy(self->queue, self->parentStart, sliceSize * sizeof(int));
+    for (int state = 0; state < sliceSize; state++)
+    {
+        for (int k = self->childStart[state]; k < self->childStart[state + 1]; k++)
+            self->parents[self->queue[self->children[k]]++] = state;
+    }
+
+    for (int slot = 0; slot < builder->slotCount; slot++)
+    {
+        self->childMasks[slot] = -1;
+        if ((mask & builder->conflicts[slot]) == 0)
+            self->childMasks[slot] = Tablebase_findMask(builder->masks, builder->maskCount, mask | (1u << slot));
+    }
+}
+
+/// @brief Résout une position d'après une action menant à une position résolue.
+static void TablebaseWorker_update(TablebaseWorker *self, Uint8 *entries, int *tail, int state, int childPlies)
+{
+    if (entries[state] != 0)
+        return;
+
+    // La position atteinte est perdue pour l'adversaire (nombre de plies pair) : victoire.
+    // Sinon, la position est perdue quand toutes ses actions mènent à une victoire de l'adversaire.
+    if (childPlies % 2 == 0 || --self->remaining[state] == 0)
+    {
+        assert(childPlies + 1 <= TABLEBASE_MAX_PLIES);
+        entries[state] = (Uint8)(childPlies + 2);
+        self->queue[(*tail)++] = state;
+    }
+}
+
+/// @brief Résout les positions d'une disposition de murs et de murs restants.
+/// Les murs mènent à des positions déjà résolues (un mur restant de moins) :
+/// leurs valeurs sont des événements triés par nombre de plies, traités dans l'ordre
+/// avec les positions résolues par les déplacements.
+static void TablebaseWorker_solveSlice(TablebaseWorker *self, int maskIndex, int wallCount0, int wallCount1)
+{
+    TablebaseBuilder *builder = self->builder;
+    const int gridSize = builder->gridSize;
+    const int cellCount = builder->cellCount;
+    const int sliceSize = builder->sliceSize;
+    const int wallCounts[2] = { wallCount0, wallCount1 };
+    Uint8 *entries = builder->entries + Tablebase_getSliceOffset(
+        gridSize, builder->wallCount, builder->masks[maskIndex], wallCount0, wallCount1);
+
+    int head = 0, tail = 0, eventCount = 0;
+    memset(self->eventStart, 0, sizeof(self->eventStart));
+
+    for (int state = 0; state < sliceSize; state++)
+    {
+        const int cell1 = state % cellCount;
+        const int cell0 = (state / cellCount) % cellCount;
+        const int playerID = state / (cellCount * cellCount);
+
+        entries[state] = 0;
+        self->remaining[state] = (Uint8)(self->childStart[state + 1] - self->childStart[state]);
+
+        if (!TablebaseWorker_isActive(gridSize, cell0, cell1))
+        {
+            // L'adversaire du joueur qui doit jouer vient d'arriver
+            const int cells[2] = { cell0, cell1 };
+            if (cell0 != cell1 && !Tablebase_isGoal(gridSize, playerID, cells[playerID]))
+            {
+                entries[state] = 1;
+                self->queue[tail++] = state;
+            }
+            continue;
+        }
+        if (wallCounts[playerID] == 0)
+            continue;
+
+        for (int slot = 0; slot < builder->slotCount; slot++)
+        {
+            const int childMask = self->childMasks[slot];
+            if (childMask < 0 ||
+                (builder->reach[2 * childMask] & (1u << cell0)) == 0 ||
+                (builder->reach[2 * childMask + 1] & (1u << cell1)) == 0)
+                continue;
+
+            self->remaining[state]++;
+            const size_t childOffset = Tablebase_getSliceOffset(
+                gridSize, builder->wallCount, builder->masks[childMask],
+                wallCount0 - (playerID == 0), wallCount1 - (playerID == 1));
+            const Uint8 value = builder->entries[childOffset + Tablebase_getState(cellCount, playerID ^ 1, cell0, cell1)];
+            if (value == 0)
+                continue;
+
+            self->eventStates[eventCount] = state;
+            self->eventPlies[eventCount] = value - 1;
+            self->eventStart[value]++;
+            eventCount++;
+        }
+    }
+
+    // Tri des événements par nombre de plies
+    for (int plies = 0; plies <= TABLEBASE_MAX_PLIES; plies++)
+        self->eventStart[plies + 1] += self->eventStart[plies];
+    memcpy(self->eventCursor, self->eventStart, sizeof(self->eventStart));
+    for (int k = 0; k < eventCount; k++)
+        self->events[self->eventCursor[self->eventPlies[k]]++] = self->eventStates[k];
+
+    for (int plies = 0; plies < TABLEBASE_MAX_PLIES; plies++)
+    {
+        for (int k = self->eventStart[plies]; k < self->eventStart[plies + 1]; k++)
+            TablebaseWorker_update(self, entries, &tail, self->events[k], plies);
+
+        while (head < tail && entries[self->queue[head]] - 1 == plies)
+        {
+            const int state = self->queue[head++];
+            for (int k = self->parentStart[state]; k < self->parentStart[state + 1]; k++)
+                TablebaseWorker_update(self, entries, &tail, self->parents[k], plies);
+        }
+    }
+}
+
+static int TablebaseWorker_main(void *data)
+{
+    TablebaseWorker *self = (TablebaseWorker *)data;
+    TablebaseBuilder *builder = self->builder;
+    const int wallCount = builder->wallCount;
+    const int remainingWalls = builder->remainingWalls;
+
+    while (true)
+    {
+        const int maskIndex = SDL_AddAtomicInt(&(builder->nextMask), 1);
+        if (maskIndex >= builder->maskCount)
+            break;
+
+        // Les murs posés et restants ne dépassent pas ceux du début de la partie
+        const int placed = Tablebase_countWalls(builder->masks[maskIndex].walls);
+        if (placed + remainingWalls > 2 * wallCount)
+            continue;
+
+        TablebaseWorker_prepareMask(self, maskIndex);
+        for (int w0 = Int_max(0, remainingWalls - wallCount); w0 <= Int_min(wallCount, remainingWalls); w0++)
+            TablebaseWorker_solveSlice(self, maskIndex, w0, remainingWalls - w0);
+    }
+    return 0;
+}
+
+bool Tablebase_build(const char *path, int gridSize, int wallCount, int threadCount)
+{
+    assert(3 <= gridSize && gridSize <= TABLEBASE_MAX_GRID_SIZE);
+    assert(0 <= wallCount && wallCount <= TABLEBASE_MAX_WALLS);
+    TRACE_SCOPE_BEGIN("Tablebase_build");
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        TRACE_SCOPE_END();
+        return false;
+    }
+
+    TablebaseBuilder *builder = (TablebaseBuilder *)calloc(1, sizeof(TablebaseBuilder));
+    AssertNew(builder);
+    TablebaseBuilder_init(builder, gridSize, wallCount);
+
+    threadCount = Int_clamp(threadCount, 1, TABLEBASE_MAX_THREADS);
+    TablebaseWorker *workers = (TablebaseWorker *)calloc(threadCount, sizeof(TablebaseWorker));
+    AssertNew(workers);
+    for (int t = 0; t < threadCount; t++)
+        TablebaseWorker_init(&workers[t], builder);
+
+    // Un mur mène à une position avec un mur restant de moins, résolue au niveau précédent
+    for (int remainingWalls = 0; remainingWalls <= 2 * wallCount; remainingWalls++)
+    {
+        builder->remainingWalls = remainingWalls;
+        SDL_SetAtomicInt(&(builder->nextMask), 0);
+
+        SDL_Thread *threads[TABLEBASE_MAX_THREADS] = { 0 };
+        for (int t = 1; t < threadCount; t++)
+            threads[t] = SDL_CreateThread(TablebaseWorker_main, "tablebase", &workers[t]);
+
+        // Les dispositions sont réparties à la demande : un thread non créé ne bloque rien
+        TablebaseWorker_main(&workers[0]);
+        for (int t = 1; t < threadCount; t++)
+        {
+            if (threads[t])
+                SDL_WaitThread(threads[t], NULL);
+        }
+    }
+
+    TablebaseHeader header = { 0 };
+    memcpy(header.magic, g_tablebaseMagic, sizeof(header.magic));
+    header.version = TABLEBASE_VERSION;
+    header.gridSize = gridSize;
+    header.wallCount = wallCount;
+    header.maskCount = builder->maskCount;
+    header.sliceCount = builder->sliceCount;
+
+    const size_t entryCount = (size_t)builder->sliceCount * builder->sliceSize;
+    bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+    success = success && fwrite(builder->masks, sizeof(TablebaseMask), builder->maskCount, file) == (size_t)builder->maskCount;
+    success = success && fwrite(builder->entries, 1, entryCount, file) == entryCount;
+    success = (fclose(file) == 0) && success;
+
+    for (int t = 0; t < threadCount; t++)
+        TablebaseWorker_quit(&workers[t]);
+    free(workers);
+    free(builder->masks);
+    free(builder->reach);
+    free(builder->entries);
+    free(builder);
+
+    TRACE_SCOPE_END();
+    return success;
+}
+
+//------------------------------------------------------------------------------
+// Lecture
+
+Tablebase *Tablebase_open(const char *path)
+{
+    MappedFile *file = MappedFile_open(path);
+    if (file == NULL)
+        return NULL;
+
+    const TablebaseHeader *header = (const TablebaseHeader *)file->data;
+    if (file->size < sizeof(TablebaseHeader) ||
+        memcmp(header->magic, g_tablebaseMagic, sizeof(header->magic)) != 0 ||
+        header->version != TABLEBASE_VERSION ||
+        header->gridSize < 3 || header->gridSize > TABLEBASE_MAX_GRID_SIZE ||
+        header->wallCount > TABLEBASE_MAX_WALLS)
+    {
+        MappedFile_close(file);
+        return NULL;
+    }
+
+    const int gridSize = (int)header->gridSize;
+    const int wallCount = (int)header->wallCount;
+    const int maskCount = (int)header->maskCount;
+    const size_t masksSize = (size_t)maskCount * sizeof(TablebaseMask);
+    const size_t entryCount = (size_t)header->sliceCount * 2 * gridSize * gridSize * gridSize * gridSize;
+    if (file->size != sizeof(TablebaseHeader) + masksSize + entryCount)
+    {
+        MappedFile_close(file);
+        return NULL;
+    }
+
+    Tablebase *self = (Tablebase *)calloc(1, sizeof(Tablebase));
+    AssertNew(self);
+
+    self->file = file;
+    self->gridSize = gridSize;
+    self->wallCount = wallCount;
+    self->maskCount = maskCount;
+    self->masks = (const TablebaseMask *)(file->data + sizeof(TablebaseHeader));
+    self->entries = file->data + sizeof(TablebaseHeader) + masksSize;
+    return self;
+}
+
+void Tablebase_close(Tablebase *self)
+{
+    if (!self) return;
+    MappedFile_close(self->file);
+    free(self);
+}
+
+bool Tablebase_canProbe(Tablebase *self, QuoridorCore *core)
+{
+    if (core->playerCount != 2 || core->state != QUORIDOR_STATE_IN_PROGRESS || core->gridSize != self->gridSize)
+        return false;
+
+    const int wallCount0 = core->wallCounts[0];
+    const int wallCount1 = core->wallCounts[1];
+    if (wallCount0 < 0 || wallCount0 > self->wallCount || wallCount1 < 0 || wallCount1 > self->wallCount)
+        return false;
+
+    const Uint32 mask = Tablebase_getMask(core);
+    if (Tablebase_countWalls(mask) + wallCount0 + wallCount1 > 2 * self->wallCount)
+        return false;
+
+    return Tablebase_findMask(self->masks, self->maskCount, mask) >= 0;
+}
+
+RaceEntry Tablebase_probe(Tablebase *self, QuoridorCore *core)
+{
+    assert(Tablebase_canProbe(self, core));
+
+    const int gridSize = self->gridSize;
+    const int cellCount = gridSize * gridSize;
+    const int maskIndex = Tablebase_findMask(self->masks, self->maskCount, Tablebase_getMask(core));
+    const size_t offset = Tablebase_getSliceOffset(
+        gridSize, self->wallCount, self->masks[maskIndex], core->wallCounts[0], core->wallCounts[1]);
+    const int state = Tablebase_getState(
+        cellCount, core->playerID,
+        core->positions[0].i * gridSize + core->positions[0].j,
+        core->positions[1].i * gridSize + core->positions[1].j);
+
+    const Uint8 value = self->entries[offset + state];
+    RaceEntry entry = { 0 };
+    if (value > 0)
+    {
+        entry.plies = value - 1;
+        entry.result = (entry.plies % 2 == 0) ? RACE_RESULT_LOSS : RACE_RESULT_WIN;
+    }
+    return entry;
+}
+
+QuoridorTurn Tablebase_getBestTurn(Tablebase *self, QuoridorCore *core, RaceEntry *entry)
+{
+    assert(Tablebase_canProbe(self, core));
+
+    QuoridorTurn turns[MAX_TURN_COUNT];
+    const int turnCount = QuoridorCore_getTurns(core, turns);
+
+    QuoridorTurn bestTurn = { 0 };
+    RaceEntry bestEntry = { 0 };
+    for (int k = 0; k < turnCount; k++)
+    {
+        QuoridorUndo undo;
+        QuoridorCore_makeTurn(core, turns[k], &undo);
+
+        // Le joueur vient d'arriver : la position est perdue pour l'adversaire
+        RaceEntry childEntry = { RACE_RESULT_LOSS, 0 };
+        if (core->state == QUORIDOR_STATE_IN_PROGRESS)
+            childEntry = Tablebase_probe(self, core);
+        QuoridorCore_unmakeTurn(core, &undo);
+
+        if (bestTurn.action == QUORIDOR_ACTION_UNDEFINED || RaceSolver_isBetter(childEntry, bestEntry))
+        {
+            bestTurn = turns[k];
+            bestEntry = childEntry;
+        }
+    }
+
+    if (entry)
+        *entry = Tablebase_probe(self, core);
+    return bestTurn;
+}
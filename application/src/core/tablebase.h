@@ -0,0 +1,133 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+#include "core/race_solver.h"
+#include "core/mapped_file.h"
+
+// Format du fichier de table de fin de partie.
+//
+// Un fichier commence par un en-tête TablebaseHeader, suivi des dispositions de murs
+// (maskCount TablebaseMask triés par murs), puis d'un octet par position.
+// Un masque a un bit par emplacement de mur : les murs horizontaux ligne par ligne,
+// puis les murs verticaux. Les positions d'une disposition de murs sont regroupées
+// par murs restants possibles de chaque joueur (au plus wallCount chacun, et au plus
+// 2 * wallCount murs posés et restants), puis indexées comme dans RaceSolver
+// (joueur qui doit jouer, case du pion 0, case du pion 1). Un octet vaut 0 si la position
+// est nulle ou impossible, et 1 + le nombre de plies avant la fin sinon : ce nombre est
+// pair si le joueur qui doit jouer perd et impair s'il gagne.
+// Le fichier est projeté en mémoire tel quel, sans lecture ni décodage à l'ouverture.
+
+/// @brief Version du format écrite dans l'en-tête.
+#define TABLEBASE_VERSION 1
+
+/// @brief Taille maximale de la grille : les emplacements de murs tiennent sur 32 bits.
+#define TABLEBASE_MAX_GRID_SIZE 5
+
+/// @brief Nombre maximal de murs par joueur (au-delà, la table dépasse plusieurs Go).
+#define TABLEBASE_MAX_WALLS 3
+
+/// @brief Nombre maximal de threads de la génération.
+#define TABLEBASE_MAX_THREADS 64
+
+/// @brief En-tête du fichier.
+typedef struct TablebaseHeader
+{
+    /// @brief "QTBL".
+    char magic[4];
+
+    /// @brief TABLEBASE_VERSION.
+    Uint32 version;
+
+    /// @brief Taille de la grille.
+    Uint32 gridSize;
+
+    /// @brief Nombre de murs de chaque joueur au début de la partie.
+    Uint32 wallCount;
+
+    /// @brief Nombre de dispositions de murs.
+    Uint32 maskCount;
+
+    /// @brief Nombre de groupes de positions (une disposition de murs et des murs restants).
+    Uint32 sliceCount;
+} TablebaseHeader;
+
+/// @brief Disposition de murs du fichier.
+typedef struct TablebaseMask
+{
+    /// @brief Murs posés, un bit par emplacement.
+    Uint32 walls;
+
+    /// @brief Indice du premier groupe de positions de la disposition.
+    Uint32 firstSlice;
+} TablebaseMask;
+
+/// @brief Table de fin de partie exacte des petites grilles à deux joueurs :
+/// valeur (victoire, défaite ou nulle et nombre de plies) de toutes les positions
+/// d'une partie commencée avec au plus wallCount murs par joueur.
+/// La table est lue dans un fichier projeté en mémoire, partagé en lecture seule
+/// par toutes les IA et tous les threads.
+typedef struct Tablebase
+{
+    /// @brief Fichier projeté.
+    MappedFile *file;
+
+    /// @brief Taille de la grille et nombre de murs de chaque joueur au début de la partie.
+    int gridSize;
+    int wallCount;
+
+    /// @brief Dispositions de murs, triées.
+    const TablebaseMask *masks;
+    int maskCount;
+
+    /// @brief Valeur de chaque position.
+    const Uint8 *entries;
+} Tablebase;
+
+/// @brief Génère une table par analyse rétrograde et l'écrit dans un fichier.
+/// Les dispositions de murs sans chemin possible pour un joueur sont ignorées.
+/// Les positions sont résolues par nombre de murs restants croissant (un mur mène
+/// à une position déjà résolue), les dispositions de murs étant réparties entre les threads,
+/// puis, pour chaque disposition, par nombre de plies croissant comme dans RaceSolver.
+/// @param path Chemin du fichier.
+/// @param gridSize Taille de la grille (au plus TABLEBASE_MAX_GRID_SIZE).
+/// @param wallCount Nombre de murs de chaque joueur au début de la partie (au plus TABLEBASE_MAX_WALLS).
+/// @param threadCount Nombre de threads.
+/// @return false si le fichier ne peut pas être écrit.
+bool Tablebase_build(const char *path, int gridSize, int wallCount, int threadCount);
+
+/// @brief Ouvre une table.
+/// @param path Chemin du fichier.
+/// @return La table, ou NULL si le fichier ne peut pas être ouvert ou n'est pas une table.
+Tablebase *Tablebase_open(const char *path);
+
+/// @brief Ferme une table.
+/// @param self La table.
+void Tablebase_close(Tablebase *self);
+
+/// @brief Indique si une position est dans la table : partie à deux joueurs en cours
+/// sur la grille de la table, et murs posés et restants possibles dans une partie
+/// commencée avec wallCount murs par joueur.
+/// @param self La table.
+/// @param core La position.
+bool Tablebase_canProbe(Tablebase *self, QuoridorCore *core);
+
+/// @brief Renvoie la valeur exacte d'une position de la table (voir Tablebase_canProbe()).
+/// @param self La table.
+/// @param core La position.
+/// @return La valeur pour le joueur qui doit jouer.
+RaceEntry Tablebase_probe(Tablebase *self, QuoridorCore *core);
+
+/// @brief Renvoie le meilleur coup d'une position de la table (voir Tablebase_canProbe()),
+/// avec les mêmes préférences que RaceSolver_getBestTurn().
+/// @param self La table.
+/// @param core La position.
+/// @param entry Valeur exacte de la position pour le joueur qui doit jouer (peut être NULL).
+/// @return Le meilleur coup.
+QuoridorTurn Tablebase_getBestTurn(Tablebase *self, QuoridorCore *core, RaceEntry *entry);
@@ -0,0 +1,126 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/timeline.h"
+#include "core/utils.h"
+
+Timeline *Timeline_create()
+{
+    Timeline *self = (Timeline *)calloc(1, sizeof(Timeline));
+    AssertNew(self);
+
+    self->turnCapacity = 256;
+    self->turns = (QuoridorTurn *)calloc(self->turnCapacity, sizeof(QuoridorTurn));
+    AssertNew(self->turns);
+
+    self->keyframeCapacity = 16;
+    self->keyframes = (QuoridorCore *)calloc(self->keyframeCapacity, sizeof(QuoridorCore));
+    AssertNew(self->keyframes);
+
+    return self;
+}
+
+void Timeline_destroy(Timeline *self)
+{
+    if (!self) return;
+    free(self->turns);
+    free(self->keyframes);
+    free(self);
+}
+
+void Timeline_reset(Timeline *self, const QuoridorCore *start)
+{
+    assert(self && "The Timeline must be created");
+    self->keyframes[0] = *start;
+    self->keyframeCount = 1;
+    self->turnCount = 0;
+    self->ply = 0;
+}
+
+void Timeline_push(Timeline *self, const QuoridorCore *core, QuoridorTurn turn)
+{
+    assert(self && "The Timeline must be created");
+
+    // Les coups annulés ne peuvent plus être rétablis
+    self->turnCount = self->ply;
+    self->keyframeCount = self->ply / TIMELINE_KEYFRAME_INTERVAL + 1;
+
+    if (self->turnCount == self->turnCapacity)
+    {
+        self->turnCapacity *= 2;
+        self->turns = (QuoridorTurn *)realloc(self->turns, self->turnCapacity * sizeof(QuoridorTurn));
+        AssertNew(self->turns);
+    }
+    self->turns[self->turnCount++] = turn;
+    self->ply = self->turnCount;
+
+    if (self->ply % TIMELINE_KEYFRAME_INTERVAL == 0)
+    {
+        if (self->keyframeCount == self->keyframeCapacity)
+        {
+            self->keyframeCapacity *= 2;
+            self->keyframes = (QuoridorCore *)realloc(self->keyframes, self->keyframeCapacity * sizeof(QuoridorCore));
+            AssertNew(self->keyframes);
+        }
+        self->keyframes[self->keyframeCount++] = *core;
+    }
+}
+
+void Timeline_seek(Timeline *self, QuoridorCore *core, int ply)
+{
+    assert(self && "The Timeline must be created");
+    ply = Int_clamp(ply, 0, self->turnCount);
+
+    // Repart de la dernière copie avant le coup demandé
+    const int keyframe = ply / TIMELINE_KEYFRAME_INTERVAL;
+    assert(keyframe < self->keyframeCount);
+
+    *core = self->keyframes[keyframe];
+    for (int k = keyframe * TIMELINE_KEYFRAME_INTERVAL; k < ply; k++)
+    {
+        QuoridorCore_playTurn(core, self->turns[k]);
+    }
+    self->ply = ply;
+}
+
+void Timeline_writeGame(const Timeline *self, GameRecordWriter *writer, QuoridorState state)
+{
+    assert(self && "The Timeline must be created");
+
+    GameRecordWriter_beginGame(writer, (QuoridorCore *)&(self->keyframes[0]));
+    for (int k = 0; k < self->ply; k++)
+    {
+        GameRecordWriter_addTurn(writer, self->turns[k]);
+    }
+    GameRecordWriter_endGame(writer, state);
+}
+
+bool Timeline_readGame(Timeline *self, GameRecordReader *reader, QuoridorCore *core)
+{
+    assert(self && "The Timeline must be created");
+    if (GameRecordReader_beginGame(reader, core) == false)
+        return false;
+
+    Timeline_reset(self, core);
+
+    // La partie est lue jusqu'au bout même si un coup est illégal,
+    // pour que le lecteur soit placé au début de la partie suivante
+    bool isValid = true;
+    QuoridorTurn turn = { 0 };
+    while (GameRecordReader_nextTurn(reader, &turn))
+    {
+        if (isValid && QuoridorCore_canPlayTurn(core, turn) == false)
+            isValid = false;
+        if (isValid == false)
+            continue;
+
+        QuoridorCore_playTurn(core, turn);
+        Timeline_push(self, core, turn);
+    }
+
+    Timeline_seek(self, core, 0);
+    return isValid && reader->hasError == false;
+}
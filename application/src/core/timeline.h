@@ -0,0 +1,118 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+#include "core/game_record.h"
+
+/// @brief Nombre de coups entre deux copies complètes de la partie.
+#define TIMELINE_KEYFRAME_INTERVAL 16
+
+/// @brief Historique complet d'une partie, permettant d'annuler et de rétablir
+/// n'importe quel nombre de coups.
+/// Tous les coups joués sont conservés, ainsi qu'une copie de la partie
+/// tous les TIMELINE_KEYFRAME_INTERVAL coups : aller à un coup quelconque
+/// demande de rejouer au plus TIMELINE_KEYFRAME_INTERVAL - 1 coups.
+typedef struct Timeline
+{
+    /// @brief Coups joués depuis le début de la partie, y compris ceux annulés
+    /// qui peuvent encore être rétablis.
+    QuoridorTurn *turns;
+    int turnCount;
+    int turnCapacity;
+
+    /// @brief Copies de la partie : keyframes[k] est la partie après k * TIMELINE_KEYFRAME_INTERVAL coups.
+    QuoridorCore *keyframes;
+    int keyframeCount;
+    int keyframeCapacity;
+
+    /// @brief Nombre de coups joués dans la position courante.
+    int ply;
+} Timeline;
+
+/// @brief Crée un historique vide.
+/// @return L'historique créé.
+Timeline *Timeline_create();
+
+/// @brief Détruit un historique.
+/// @param self L'historique.
+void Timeline_destroy(Timeline *self);
+
+/// @brief Vide l'historique et fixe la position de départ de la partie.
+/// @param self L'historique.
+/// @param start Position de départ.
+void Timeline_reset(Timeline *self, const QuoridorCore *start);
+
+/// @brief Enregistre un coup qui vient d'être joué.
+/// Les coups annulés qui suivaient la position courante sont oubliés.
+/// @param self L'historique.
+/// @param core La partie, après le coup.
+/// @param turn Le coup joué.
+void Timeline_push(Timeline *self, const QuoridorCore *core, QuoridorTurn turn);
+
+/// @brief Place la partie après un nombre donné de coups.
+/// @param self L'historique.
+/// @param core La partie à modifier.
+/// @param ply Nombre de coups, borné entre 0 et Timeline_getTurnCount().
+void Timeline_seek(Timeline *self, QuoridorCore *core, int ply);
+
+/// @brief Annule des coups.
+/// @param self L'historique.
+/// @param core La partie à modifier.
+/// @param count Nombre de coups à annuler.
+INLINE void Timeline_undo(Timeline *self, QuoridorCore *core, int count)
+{
+    Timeline_seek(self, core, self->ply - count);
+}
+
+/// @brief Rétablit des coups annulés.
+/// @param self L'historique.
+/// @param core La partie à modifier.
+/// @param count Nombre de coups à rétablir.
+INLINE void Timeline_redo(Timeline *self, QuoridorCore *core, int count)
+{
+    Timeline_seek(self, core, self->ply + count);
+}
+
+/// @brief Indique s'il reste des coups à annuler.
+INLINE bool Timeline_canUndo(const Timeline *self)
+{
+    return self->ply > 0;
+}
+
+/// @brief Indique s'il reste des coups à rétablir.
+INLINE bool Timeline_canRedo(const Timeline *self)
+{
+    return self->ply < self->turnCount;
+}
+
+/// @brief Renvoie le nombre de coups joués dans la position courante.
+INLINE int Timeline_getPly(const Timeline *self)
+{
+    return self->ply;
+}
+
+/// @brief Renvoie le nombre de coups de l'historique (y compris ceux annulés).
+INLINE int Timeline_getTurnCount(const Timeline *self)
+{
+    return self->turnCount;
+}
+
+/// @brief Écrit la partie jusqu'à la position courante dans un enregistrement.
+/// @param self L'historique.
+/// @param writer L'enregistreur.
+/// @param state État de la partie dans la position courante.
+void Timeline_writeGame(const Timeline *self, GameRecordWriter *writer, QuoridorState state);
+
+/// @brief Charge la partie suivante d'un enregistrement.
+/// La partie est placée dans sa position de départ ; ses coups peuvent être rétablis.
+/// @param self L'historique.
+/// @param reader Le lecteur.
+/// @param core La partie à modifier.
+/// @return false s'il n'y a plus de partie ou si l'enregistrement est invalide.
+bool Timeline_readGame(Timeline *self, GameRecordReader *reader, QuoridorCore *core);
@@ -0,0 +1,182 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/trace.h"
+#include "core/utils.h"
+
+/// @brief Bloc mesuré.
+typedef struct TraceEvent
+{
+    const char *name;
+    Uint64 start;
+    Uint64 end;
+} TraceEvent;
+
+/// @brief Tampon circulaire d'un thread.
+/// Seul le thread propriétaire écrit dedans ; il n'est lu qu'à la fin de la session.
+/// Quand son thread se termine, le tampon est rendu et repris par le prochain thread créé :
+/// ses évènements restent jusqu'à ce que le nouveau propriétaire les écrase.
+typedef struct TraceBuffer
+{
+    /// @brief Identifiant du dernier thread propriétaire.
+    SDL_ThreadID threadID;
+
+    /// @brief Indique si un thread en cours d'exécution écrit dans le tampon.
+    bool inUse;
+
+    /// @brief Nombre total d'évènements écrits depuis le début de la session.
+    SDL_AtomicInt count;
+
+    TraceEvent events[TRACE_BUFFER_SIZE];
+} TraceBuffer;
+
+static TraceBuffer *g_traceBuffers[TRACE_MAX_THREADS];
+static int g_traceBufferCount;
+static SDL_Mutex *g_traceMutex;
+static SDL_AtomicInt g_traceEnabled;
+static SDL_AtomicInt g_traceOverflow;
+static SDL_TLSID g_traceTLS;
+static Uint64 g_traceStart;
+static char g_tracePath[256];
+
+/// @brief Rend le tampon d'un thread qui se termine (destructeur du stockage local au thread).
+static void Trace_releaseBuffer(void *value)
+{
+    TraceBuffer *buffer = (TraceBuffer *)value;
+    SDL_LockMutex(g_traceMutex);
+    buffer->inUse = false;
+    SDL_UnlockMutex(g_traceMutex);
+}
+
+/// @brief Renvoie le tampon du thread courant. Au premier appel, il reprend le tampon
+/// d'un thread terminé ou en crée un nouveau.
+/// @return NULL si TRACE_MAX_THREADS threads tracés s'exécutent déjà.
+static TraceBuffer *Trace_getBuffer()
+{
+    TraceBuffer *buffer = (TraceBuffer *)SDL_GetTLS(&g_traceTLS);
+    if (buffer) return buffer;
+
+    SDL_LockMutex(g_traceMutex);
+    for (int b = 0; b < g_traceBufferCount && buffer == NULL; b++)
+    {
+        if (g_traceBuffers[b]->inUse == false)
+            buffer = g_traceBuffers[b];
+    }
+    if (buffer == NULL && g_traceBufferCount < TRACE_MAX_THREADS)
+    {
+        buffer = (TraceBuffer *)calloc(1, sizeof(TraceBuffer));
+        AssertNew(buffer);
+        g_traceBuffers[g_traceBufferCount++] = buffer;
+    }
+    if (buffer)
+    {
+        buffer->threadID = SDL_GetCurrentThreadID();
+        buffer->inUse = true;
+    }
+    SDL_UnlockMutex(g_traceMutex);
+
+    if (buffer == NULL)
+    {
+        // Signalé une seule fois par session
+        if (SDL_CompareAndSwapAtomicInt(&g_traceOverflow, 0, 1))
+            printf("ERROR - Trace_getBuffer more than %d threads, events are lost\n", TRACE_MAX_THREADS);
+        return NULL;
+    }
+
+    SDL_SetTLS(&g_traceTLS, buffer, Trace_releaseBuffer);
+    return buffer;
+}
+
+void Trace_init(const char *path)
+{
+    if (path)
+    {
+        snprintf(g_tracePath, sizeof(g_tracePath), "%s", path);
+    }
+    else
+    {
+        const time_t now = time(NULL);
+        strftime(g_tracePath, sizeof(g_tracePath), "trace_%Y%m%d_%H%M%S.json", localtime(&now));
+    }
+
+    SDL_SetAtomicInt(&g_traceOverflow, 0);
+    g_traceMutex = SDL_CreateMutex();
+    AssertNew(g_traceMutex);
+    g_traceStart = SDL_GetPerformanceCounter();
+    SDL_SetAtomicInt(&g_traceEnabled, 1);
+}
+
+void Trace_record(const char *name, Uint64 start, Uint64 end)
+{
+    if (SDL_GetAtomicInt(&g_traceEnabled) == 0) return;
+
+    TraceBuffer *buffer = Trace_getBuffer();
+    if (buffer == NULL) return;
+
+    const int count = SDL_GetAtomicInt(&buffer->count);
+    TraceEvent *event = &(buffer->events[count % TRACE_BUFFER_SIZE]);
+    event->name = name;
+    event->start = start;
+    event->end = end;
+
+    // Publie l'évènement une fois complètement écrit
+    SDL_SetAtomicInt(&buffer->count, count + 1);
+}
+
+void Trace_quit()
+{
+    if (SDL_GetAtomicInt(&g_traceEnabled) == 0) return;
+    SDL_SetAtomicInt(&g_traceEnabled, 0);
+
+    const double toMicro = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+    const int bufferCount = g_traceBufferCount;
+
+    FILE *file = fopen(g_tracePath, "w");
+    if (file == NULL)
+    {
+        printf("ERROR - Trace_quit %s\n", g_tracePath);
+    }
+    else
+    {
+        fprintf(file, "{\"traceEvents\":[\n");
+        bool first = true;
+        for (int b = 0; b < bufferCount; b++)
+        {
+            const TraceBuffer *buffer = g_traceBuffers[b];
+            if (buffer == NULL) continue;
+
+            // Seuls les TRACE_BUFFER_SIZE derniers évènements sont encore présents
+            const int count = SDL_GetAtomicInt((SDL_AtomicInt *)&buffer->count);
+            const int firstIndex = Int_max(0, count - TRACE_BUFFER_SIZE);
+            for (int e = firstIndex; e < count; e++)
+            {
+                const TraceEvent *event = &(buffer->events[e % TRACE_BUFFER_SIZE]);
+                fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    first ? "" : ",\n", event->name, b,
+                    (double)(event->start - g_traceStart) * toMicro,
+                    (double)(event->end - event->start) * toMicro);
+                first = false;
+            }
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"thread %d (last %llu)\"}}",
+                first ? "" : ",\n", b, b, (unsigned long long)buffer->threadID);
+            first = false;
+        }
+        fprintf(file, "\n]}\n");
+        fclose(file);
+        printf("trace written to %s\n", g_tracePath);
+    }
+
+    // Le tampon du thread courant est libéré sans passer par son destructeur
+    SDL_SetTLS(&g_traceTLS, NULL, NULL);
+    for (int b = 0; b < bufferCount; b++)
+    {
+        free(g_traceBuffers[b]);
+        g_traceBuffers[b] = NULL;
+    }
+    g_traceBufferCount = 0;
+    SDL_DestroyMutex(g_traceMutex);
+    g_traceMutex = NULL;
+}
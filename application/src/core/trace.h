@@ -0,0 +1,79 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+
+// Marqueurs de profilage au format "Chrome trace event".
+// Ils ne sont compilés que si TRACE est défini (voir settings.h),
+// sinon les macros ne génèrent aucun code.
+//
+// Chaque thread écrit ses évènements dans son propre tampon circulaire,
+// sans verrou ; le tampon d'un thread terminé est repris par le suivant.
+// Le fichier JSON est écrit par Trace_quit() et peut être ouvert
+// dans chrome://tracing ou https://ui.perfetto.dev.
+//
+// Les marqueurs sont réservés aux blocs longs (image, coup de l'IA) : ceux d'une
+// fonction appelée à chaque noeud de la recherche rempliraient le tampon à eux seuls.
+//
+// Utilisation :
+//     TRACE_SCOPE_BEGIN("Scene_update");
+//     ...
+//     TRACE_SCOPE_END();  // à placer aussi avant chaque return du bloc
+
+/// @brief Nombre d'évènements conservés par thread (les plus anciens sont écrasés).
+#define TRACE_BUFFER_SIZE (1 << 16)
+
+/// @brief Nombre maximal de threads tracés s'exécutant en même temps.
+#define TRACE_MAX_THREADS 64
+
+/// @brief Bloc de code en cours de mesure.
+typedef struct TraceScope
+{
+    /// @brief Nom du bloc (chaîne statique).
+    const char *name;
+
+    /// @brief Compteur de performance au début du bloc.
+    Uint64 start;
+} TraceScope;
+
+/// @brief Démarre la session de profilage (une seule par exécution).
+/// @param path Chemin du fichier JSON à écrire, ou NULL pour un nom horodaté.
+void Trace_init(const char *path);
+
+/// @brief Termine la session et écrit le fichier JSON.
+/// Les threads tracés doivent être terminés (ou inactifs) avant l'appel.
+void Trace_quit();
+
+/// @brief Enregistre un bloc mesuré dans le tampon du thread courant.
+/// @param name Nom du bloc (chaîne statique).
+/// @param start Compteur de performance au début du bloc.
+/// @param end Compteur de performance à la fin du bloc.
+void Trace_record(const char *name, Uint64 start, Uint64 end);
+
+INLINE TraceScope Trace_beginScope(const char *name)
+{
+    TraceScope scope = { name, SDL_GetPerformanceCounter() };
+    return scope;
+}
+
+INLINE void Trace_endScope(const TraceScope *scope)
+{
+    Trace_record(scope->name, scope->start, SDL_GetPerformanceCounter());
+}
+
+#ifdef TRACE
+#  define TRACE_INIT(path) Trace_init(path)
+#  define TRACE_QUIT() Trace_quit()
+#  define TRACE_SCOPE_BEGIN(name) const TraceScope traceScope_ = Trace_beginScope(name)
+#  define TRACE_SCOPE_END() Trace_endScope(&traceScope_)
+#else
+#  define TRACE_INIT(path)
+#  define TRACE_QUIT()
+#  define TRACE_SCOPE_BEGIN(name)
+#  define TRACE_SCOPE_END()
+#endif
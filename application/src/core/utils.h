@@ -80,3 +80,80 @@ INLINE float Float_clamp01(float value)
 {
     return Float_clamp(value, 0.0f, 1.0f);
 }
+
+/// @brief Générateur pseudo-aléatoire PCG32 (O'Neill, 2014).
+/// Contrairement à rand(), son état est local : chaque IA peut posséder
+/// son propre générateur, sans contention entre threads,
+/// et une graine donnée reproduit exactement la même suite de valeurs.
+typedef struct Rng
+{
+    /// @brief État interne.
+    Uint64 state;
+
+    /// @brief Incrément (toujours impair), sélectionne la suite.
+    Uint64 inc;
+} Rng;
+
+/// @brief Mélange les bits d'un entier 64 bits (finaliseur SplitMix64).
+/// Permet de dériver des graines indépendantes à partir d'une graine commune.
+/// @param value Valeur à mélanger.
+/// @return La valeur mélangée.
+INLINE Uint64 Rng_mix(Uint64 value)
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+/// @brief Génère un entier aléatoire sur 32 bits.
+/// @param self Générateur.
+/// @return Un entier aléatoire uniforme sur 32 bits.
+INLINE Uint32 Rng_next(Rng *self)
+{
+    const Uint64 old = self->state;
+    self->state = old * 6364136223846793005ull + self->inc;
+    const Uint32 xorShifted = (Uint32)(((old >> 18u) ^ old) >> 27u);
+    const Uint32 rot = (Uint32)(old >> 59u);
+    return (xorShifted >> rot) | (xorShifted << ((32u - rot) & 31u));
+}
+
+/// @brief Initialise un générateur à partir d'une graine.
+/// @param self Générateur.
+/// @param seed Graine.
+INLINE void Rng_seed(Rng *self, Uint64 seed)
+{
+    self->state = 0;
+    self->inc = (Rng_mix(seed) << 1u) | 1u;
+    Rng_next(self);
+    self->state += seed;
+    Rng_next(self);
+}
+
+/// @brief Génère un entier aléatoire.
+/// @param self Générateur.
+/// @param a Valeur minimale (incluse).
+/// @param b Valeur maximale (exclue).
+/// @return Un entier aléatoire compris entre a (inclus) et b (exclus).
+INLINE int Rng_intAB(Rng *self, int a, int b)
+{
+    return a + (int)(Rng_next(self) % (Uint32)(b - a));
+}
+
+/// @brief Génère un flottant aléatoire entre 0.f (inclus) et 1.f (exclus).
+/// @param self Générateur.
+/// @return Un flottant aléatoire compris entre 0.f et 1.f.
+INLINE float Rng_float01(Rng *self)
+{
+    return (float)(Rng_next(self) >> 8) * (1.0f / 16777216.0f);
+}
+
+/// @brief Génère un flottant aléatoire.
+/// @param self Générateur.
+/// @param a Valeur minimale.
+/// @param b Valeur maximale.
+/// @return Un flottant aléatoire compris entre a et b.
+INLINE float Rng_floatAB(Rng *self, float a, float b)
+{
+    return a + (b - a) * Rng_float01(self);
+}
@@ -46,6 +46,10 @@ void Input_update(Input *self)
 
     self->quitPressed = false;
     self->validatePressed = false;
+    self->gizmosPressed = false;
+    self->undoPressed = false;
+    self->redoPressed = false;
+    self->exportPressed = false;
 
 
     for (int i = 0; i < MAX_PLAYER_COUNT; i++)
@@ -194,8 +198,10 @@ void Input_updateKeyDown(Input *self, PlayerInput *playerInput, bool repeat, int
     case SDL_SCANCODE_DOWN:
         break;
     case SDL_SCANCODE_LEFT:
+        self->undoPressed = true;
         break;
     case SDL_SCANCODE_RIGHT:
+        self->redoPressed = true;
         break;
     case SDL_SCANCODE_SPACE:
         break;
@@ -203,6 +209,12 @@ void Input_updateKeyDown(Input *self, PlayerInput *playerInput, bool repeat, int
         break;
     case SDL_SCANCODE_BACKSPACE:
         break;
+    case SDL_SCANCODE_F3:
+        self->gizmosPressed = true;
+        break;
+    case SDL_SCANCODE_F5:
+        self->exportPressed = true;
+        break;
     default: break;
     }
 }
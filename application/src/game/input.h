@@ -23,6 +23,16 @@ typedef struct Input
 
     bool validatePressed;
 
+    /// @brief Booléen indiquant si le bouton d'affichage des gizmos vient d'être pressé.
+    bool gizmosPressed;
+
+    /// @brief Booléens indiquant si les boutons d'annulation et de rétablissement d'un coup viennent d'être pressés.
+    bool undoPressed;
+    bool redoPressed;
+
+    /// @brief Booléen indiquant si le bouton d'enregistrement de la partie vient d'être pressé.
+    bool exportPressed;
+
     PlayerInput players[MAX_PLAYER_COUNT];
 
     Vec2 mousePos;
@@ -5,14 +5,17 @@
 */
 
 #include "game/scene.h"
+#include "core/trace.h"
 
 Scene *Scene_create(GameConfig *gameConfig)
 {
     Scene *self = (Scene *)calloc(1, sizeof(Scene));
     AssertNew(self);
 
+    TRACE_SCOPE_BEGIN("Game_addAssets");
     self->m_assets = AssetManager_create(SPRITE_COUNT, FONT_COUNT);
     Game_addAssets(self->m_assets);
+    TRACE_SCOPE_END();
 
     self->m_input = Input_create();
 
@@ -61,6 +64,10 @@ void Scene_mainLoop(Scene *self, bool drawGizmos)
             self->m_gameConfig->nextScene = GAME_SCENE_QUIT;
             return;
         }
+        if (input->gizmosPressed)
+        {
+            drawGizmos = !drawGizmos;
+        }
 
         if (self->m_state == SCENE_STATE_FINISHED)
             return;
@@ -78,6 +85,7 @@ void Scene_mainLoop(Scene *self, bool drawGizmos)
 void Scene_update(Scene *self)
 {
     assert(self && "The Scene must be created");
+    TRACE_SCOPE_BEGIN("Scene_update");
     Input_update(self->m_input);
 
     UIQuoridor_update(self->m_quoridorUI);
@@ -98,6 +106,7 @@ void Scene_update(Scene *self)
             self->m_state = SCENE_STATE_FINISHED;
         }
     }
+    TRACE_SCOPE_END();
 }
 
 void Scene_quit(Scene *self)
@@ -114,6 +123,7 @@ void Scene_quit(Scene *self)
 void Scene_render(Scene *self)
 {
     assert(self && "The Scene must be created");
+    TRACE_SCOPE_BEGIN("Scene_render");
 
     // Efface le rendu précédent
     SDL_SetRenderDrawColor(g_renderer, 37, 37, 37, 255);
@@ -135,9 +145,68 @@ void Scene_render(Scene *self)
         SDL_SetRenderDrawColor(g_renderer, 0, 0, 0, opacity);
         SDL_RenderFillRect(g_renderer, NULL);
     }
+    TRACE_SCOPE_END();
 }
 
 void Scene_drawGizmos(Scene *self)
 {
     assert(self && "The Scene must be created");
+
+    // Statistiques de la dernière recherche de l'IA
+    UIQuoridor *ui = self->m_quoridorUI;
+    if (ui->m_lastAIPlayer < 0) return;
+
+    const AIStats *stats = AIData_getStats(ui->m_aiData[ui->m_lastAIPlayer]);
+    if (stats == NULL) return;
+
+    char lines[6][256] = { 0 };
+    const int lineCount = sizeof(lines) / sizeof(lines[0]);
+    if (stats->fromBook)
+        snprintf(lines[0], sizeof(lines[0]), "CPU %d  opening book  score %+.2f  time %.3f ms",
+            ui->m_lastAIPlayer + 1, stats->score, 1000.0 * stats->elapsed);
+    else
+        snprintf(lines[0], sizeof(lines[0]), "CPU %d  depth %d  score %+.2f  time %.1f ms",
+            ui->m_lastAIPlayer + 1, stats->depth, stats->score, 1000.0 * stats->elapsed);
+    snprintf(lines[1], sizeof(lines[1]), "nodes %llu  leaves %llu  %.1f knodes/s  proof %llu",
+        (unsigned long long)stats->nodeCount, (unsigned long long)stats->leafCount,
+        stats->nodesPerSecond / 1000.0, (unsigned long long)stats->proofNodeCount);
+    snprintf(lines[2], sizeof(lines[2]), "reduced %llu  null cuts %llu  futile %llu  quiescence %llu",
+        (unsigned long long)stats->reductionCount, (unsigned long long)stats->nullMoveCutoffs,
+        (unsigned long long)stats->futilityCount, (unsigned long long)stats->quiescenceCount);
+    snprintf(lines[3], sizeof(lines[3]), "paths %llu  wall checks %llu  tt hits %llu  repetitions %llu  re-searches %llu/%llu",
+        (unsigned long long)stats->pathCount, (unsigned long long)stats->wallCheckCount,
+        (unsigned long long)stats->ttHits, (unsigned long long)stats->repetitionCount,
+        (unsigned long long)stats->researchCount, (unsigned long long)stats->aspirationFailCount);
+
+    int length = snprintf(lines[4], sizeof(lines[4]), "cutoffs");
+    for (int ply = 0; ply < stats->depth && length < (int)sizeof(lines[4]); ply++)
+    {
+        length += snprintf(lines[4] + length, sizeof(lines[4]) - length,
+            " %d:%llu", ply, (unsigned long long)stats->cutoffs[ply]);
+    }
+
+    length = snprintf(lines[5], sizeof(lines[5]), "pv");
+    for (int k = 0; k < stats->pvLength && length < (int)sizeof(lines[5]) - 8; k++)
+    {
+        lines[5][length++] = ' ';
+        length += QuoridorTurn_toString(stats->pv[k], lines[5] + length, sizeof(lines[5]) - length);
+    }
+
+    // Le fond couvre la ligne la plus longue
+    int maxLength = 0;
+    for (int i = 0; i < lineCount; i++)
+        maxLength = Int_max(maxLength, (int)strlen(lines[i]));
+
+    const float lineH = 12.f;
+    SDL_FRect rect = { 8.f, 8.f, 0.f, lineCount * lineH + 8.f };
+    rect.w = (float)(maxLength * SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE) + 8.f;
+    SDL_SetRenderDrawBlendMode(g_renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(g_renderer, 0, 0, 0, 192);
+    SDL_RenderFillRect(g_renderer, &rect);
+
+    SDL_SetRenderDrawColor(g_renderer, 255, 255, 255, 255);
+    for (int i = 0; i < lineCount; i++)
+    {
+        SDL_RenderDebugText(g_renderer, rect.x + 4.f, rect.y + 4.f + i * lineH, lines[i]);
+    }
 }
@@ -9,8 +9,9 @@
 #include "game/scene.h"
 #include "core/graph.h"
 #include "core/quoridor_ai.h"
+#include "core/trace.h"
+#include "core/timeline.h"
 #include <time.h>
-#include <core/listData.h>
 
 static bool UIQuoridor_isPlayerTurn(UIQuoridor *self)
 {
@@ -20,6 +21,301 @@ static bool UIQuoridor_isPlayerTurn(UIQuoridor *self)
     return (selectedMode == 0) || ((selectedMode == 1) && core->playerID == 0);
 }
 
+/// @brief Ajoute (ou retire) une position de la partie à celles connues des IA,
+/// qui évitent ainsi de la répéter.
+static void UIQuoridor_addPosition(UIQuoridor *self, QuoridorCore *core, bool add)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        if (add) AIData_addPosition(self->m_aiData[i], core);
+        else AIData_removePosition(self->m_aiData[i], core);
+    }
+}
+
+/// @brief Choisit l'algorithme de l'IA et sa limite de noeuds selon le niveau choisi.
+/// À plus de deux joueurs, les niveaux moyen et difficile utilisent MCTS, avec le nombre
+/// de threads du niveau et non celui des coeurs, pour jouer les mêmes coups sur toute machine.
+/// La profondeur n'est pas limitée : le coût d'un coup est celui du niveau, quels que soient
+/// la grille et le nombre de joueurs.
+static void UIQuoridor_configureAI(UIQuoridor *self, AIData *aiData)
+{
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    const AILevel level = (AILevel)UIList_getSelected(self->m_listLevel);
+
+    aiData->engine = (core->playerCount > 2 && level > AI_LEVEL_EASY) ? AI_ENGINE_MCTS : AI_ENGINE_MINMAX;
+    aiData->mctsSettings.timeMS = 0;
+    aiData->mctsSettings.threadCount = AILevel_getMCTSThreadCount(level);
+    AIData_setNodeLimit(aiData, AILevel_getNodeLimit(level, aiData->engine));
+}
+
+static int UIQuoridor_ponderMain(void *data)
+{
+    UIQuoridor *self = (UIQuoridor *)data;
+    QuoridorCore *core = &(self->m_ponderCore);
+
+    // m_ponderMove est lu par l'interface pendant la recherche : il n'est pas modifié ici
+    if (QuoridorCore_canPlayTurn(core, self->m_ponderMove) == false)
+        return 0;
+
+    QuoridorCore_playTurn(core, self->m_ponderMove);
+    if (core->state != QUORIDOR_STATE_IN_PROGRESS)
+        return 0;
+
+    AIData_addPosition(self->m_ponderData, core);
+    self->m_ponderTurn = QuoridorCore_computeTurn(core, AI_MAX_PLY - 1, self->m_ponderData);
+    return 0;
+}
+
+/// @brief Lance la recherche de l'IA pendant le tour du joueur humain.
+/// Le coup du joueur est prévu à partir de la variation principale de la dernière
+/// recherche de l'IA, puis la réponse de l'IA à ce coup est calculée en arrière-plan.
+static void UIQuoridor_startPonder(UIQuoridor *self)
+{
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    self->m_isPonderStarted = true;
+    if (core->state != QUORIDOR_STATE_IN_PROGRESS) return;
+
+    self->m_ponderMove.action = QUORIDOR_ACTION_UNDEFINED;
+    self->m_ponderTurn.action = QUORIDOR_ACTION_UNDEFINED;
+    if (self->m_lastAIPlayer >= 0)
+    {
+        const AIStats *stats = AIData_getStats(self->m_aiData[self->m_lastAIPlayer]);
+        if (stats->pvLength >= 2 && QuoridorCore_canPlayTurn(core, stats->pv[1]))
+            self->m_ponderMove = stats->pv[1];
+    }
+
+    // Sans variation principale, le coup du joueur est prévu par une recherche rapide,
+    // avant le lancement du thread qui ne fait ensuite que lire ce coup
+    if (self->m_ponderMove.action == QUORIDOR_ACTION_UNDEFINED)
+        self->m_ponderMove = QuoridorCore_computeTurn(core, 1, NULL);
+
+    // La recherche travaille sur des copies : la partie et les données de l'IA
+    // restent utilisables par l'interface pendant ce temps
+    self->m_ponderPlayer = (core->playerID + 1) % core->playerCount;
+    self->m_ponderCore = *core;
+    UIQuoridor_configureAI(self, self->m_aiData[self->m_ponderPlayer]);
+
+    // Les arbres MCTS et les tables des fins de partie ne sont pas copiés : la recherche les fait
+    // progresser pour l'IA. Ils sont créés avant la copie pour ne pas être perdus avec elle
+    AIData *aiData = (AIData *)(self->m_aiData[self->m_ponderPlayer]);
+    if (aiData->mcts == NULL)
+        aiData->mcts = MCTS_create();
+    if (aiData->raceSolver == NULL)
+        aiData->raceSolver = RaceSolver_create();
+    if (aiData->pnSearch == NULL)
+        aiData->pnSearch = PNSearch_create();
+    *(self->m_ponderData) = *aiData;
+    AIData_clearStop(self->m_ponderData);
+
+    self->m_ponderThread = SDL_CreateThread(UIQuoridor_ponderMain, "ponder", self);
+    if (self->m_ponderThread == NULL)
+        printf("ERROR - SDL_CreateThread %s\n", SDL_GetError());
+}
+
+/// @brief Termine la recherche lancée pendant le tour du joueur humain.
+/// @param turn Coup joué par le joueur (QUORIDOR_ACTION_UNDEFINED si la partie a changé autrement).
+/// @return true si le coup était prévu : la recherche est alors menée à son terme
+/// et sa réponse est dans m_ponderTurn.
+static bool UIQuoridor_stopPonder(UIQuoridor *self, QuoridorTurn turn)
+{
+    self->m_isPonderStarted = false;
+    if (self->m_ponderThread == NULL) return false;
+
+    const bool isPredicted =
+        turn.action != QUORIDOR_ACTION_UNDEFINED &&
+        turn.action == self->m_ponderMove.action &&
+        turn.i == self->m_ponderMove.i &&
+        turn.j == self->m_ponderMove.j;
+
+    if (isPredicted == false)
+        AIData_stop(self->m_ponderData);
+
+    SDL_WaitThread(self->m_ponderThread, NULL);
+    self->m_ponderThread = NULL;
+
+    return isPredicted &&
+        self->m_ponderData->stats.aborted == false &&
+        self->m_ponderTurn.action != QUORIDOR_ACTION_UNDEFINED;
+}
+
+/// @brief Publie le meilleur coup de chaque profondeur terminée par la recherche de conseil.
+static void UIQuoridor_hintInfo(const AIStats *stats, void *userData)
+{
+    UIQuoridor *self = (UIQuoridor *)userData;
+    if (stats->pvLength < 1) return;
+
+    SDL_LockMutex(self->m_hintMutex);
+    self->m_hintTurn = stats->pv[0];
+    self->m_hintScore = stats->score;
+    self->m_hintDepth = stats->depth;
+    SDL_UnlockMutex(self->m_hintMutex);
+}
+
+static int UIQuoridor_hintMain(void *data)
+{
+    UIQuoridor *self = (UIQuoridor *)data;
+    QuoridorCore_computeIterativeTurn(&(self->m_hintCore), AI_MAX_PLY - 1, self->m_hintData, UIQuoridor_hintInfo, self);
+    return 0;
+}
+
+/// @brief Lance la recherche du conseil pour le joueur humain qui doit jouer.
+/// Elle s'approfondit sans limite de noeuds jusqu'à UI_HINT_MAX_TIME_MS ou jusqu'à son arrêt.
+static void UIQuoridor_startHint(UIQuoridor *self)
+{
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    self->m_isHintStarted = true;
+    self->m_hintDepth = 0;
+    if (core->state != QUORIDOR_STATE_IN_PROGRESS) return;
+
+    // Comme pour le pondering, la recherche travaille sur des copies et les tables
+    // des fins de partie sont créées avant la copie pour rester à l'IA du joueur
+    AIData *aiData = (AIData *)(self->m_aiData[core->playerID]);
+    if (aiData->raceSolver == NULL)
+        aiData->raceSolver = RaceSolver_create();
+    if (aiData->pnSearch == NULL)
+        aiData->pnSearch = PNSearch_create();
+    *(self->m_hintData) = *aiData;
+    self->m_hintCore = *core;
+
+    // Le conseil vient toujours d'une vraie recherche, qui s'affine à chaque profondeur
+    AIData *hintData = self->m_hintData;
+    hintData->engine = AI_ENGINE_MINMAX;
+    hintData->openingBook = NULL;
+    AIData_setNodeLimit(hintData, 0);
+    AIData_clearStop(hintData);
+    AIData_setTimeLimit(hintData, UI_HINT_MAX_TIME_MS);
+
+    self->m_hintThread = SDL_CreateThread(UIQuoridor_hintMain, "hint", self);
+    if (self->m_hintThread == NULL)
+        printf("ERROR - SDL_CreateThread %s\n", SDL_GetError());
+}
+
+/// @brief Interrompt la recherche du conseil et efface le conseil affiché.
+static void UIQuoridor_stopHint(UIQuoridor *self)
+{
+    self->m_isHintStarted = false;
+    if (self->m_hintThread)
+    {
+        AIData_stop(self->m_hintData);
+        SDL_WaitThread(self->m_hintThread, NULL);
+        self->m_hintThread = NULL;
+    }
+    self->m_hintDepth = 0;
+}
+
+/// @brief Renvoie le conseil courant.
+/// @return La profondeur du conseil, ou 0 s'il n'y en a pas encore.
+static int UIQuoridor_getHint(UIQuoridor *self, QuoridorTurn *turn, float *score)
+{
+    SDL_LockMutex(self->m_hintMutex);
+    const int depth = self->m_hintDepth;
+    *turn = self->m_hintTurn;
+    *score = self->m_hintScore;
+    SDL_UnlockMutex(self->m_hintMutex);
+    return depth;
+}
+
+/// @brief Joue un coup et l'ajoute à l'historique de la partie et à celui du joueur.
+static void UIQuoridor_playTurn(UIQuoridor *self, QuoridorTurn turn)
+{
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    const int playerID = core->playerID;
+    const bool ponderHit = UIQuoridor_stopPonder(self, turn);
+    UIQuoridor_stopHint(self);
+
+    QuoridorData data = { 0 };
+    data.action = turn.action;
+    data.destPos.i = turn.i;
+    data.destPos.j = turn.j;
+    data.originPos = core->positions[playerID];
+
+    QuoridorCore_playTurn(core, turn);
+    core->startTime = clock();
+
+    AIData_add(self->m_aiData[playerID], data);
+    Timeline_push(self->m_timeline, core, turn);
+    UIQuoridor_addPosition(self, core, true);
+
+    // Coup prévu : la réponse de l'IA est déjà calculée
+    if (ponderHit && core->playerID == self->m_ponderPlayer)
+    {
+        AIData *aiData = (AIData *)self->m_aiData[self->m_ponderPlayer];
+        aiData->stats = self->m_ponderData->stats;
+        aiData->rng = self->m_ponderData->rng;
+        self->m_aiTurn = self->m_ponderTurn;
+        self->m_aiAccu = 0;
+        self->m_lastAIPlayer = self->m_ponderPlayer;
+    }
+}
+
+/// @brief Annule ou rétablit un coup, en gardant à jour l'historique des joueurs.
+/// @return false s'il n'y a pas de coup à annuler ou à rétablir.
+static bool UIQuoridor_step(UIQuoridor *self, bool forward)
+{
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    Timeline *timeline = self->m_timeline;
+
+    if (forward)
+    {
+        if (Timeline_canRedo(timeline) == false) return false;
+
+        const QuoridorTurn turn = timeline->turns[Timeline_getPly(timeline)];
+        QuoridorData data = { 0 };
+        data.action = turn.action;
+        data.destPos.i = turn.i;
+        data.destPos.j = turn.j;
+        data.originPos = core->positions[core->playerID];
+        AIData_add(self->m_aiData[core->playerID], data);
+
+        Timeline_redo(timeline, core, 1);
+        UIQuoridor_addPosition(self, core, true);
+    }
+    else
+    {
+        if (Timeline_canUndo(timeline) == false) return false;
+
+        // Après l'annulation, le joueur courant est celui qui avait joué le coup
+        UIQuoridor_addPosition(self, core, false);
+        Timeline_undo(timeline, core, 1);
+        MoveHistory_pop(&(((AIData *)self->m_aiData[core->playerID])->history), NULL);
+    }
+    return true;
+}
+
+/// @brief Annule ou rétablit des coups.
+/// Contre l'IA, on revient directement au tour du joueur humain.
+static void UIQuoridor_undoRedo(UIQuoridor *self, bool forward)
+{
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    const bool againstAI = UIList_getSelected(self->m_listMode) == 1;
+
+    UIQuoridor_stopPonder(self, (QuoridorTurn) { 0 });
+    UIQuoridor_stopHint(self);
+    if (UIQuoridor_step(self, forward) == false) return;
+    while (againstAI && UIQuoridor_isPlayerTurn(self) == false && UIQuoridor_step(self, forward))
+        ;
+
+    // Le coup calculé par l'IA ne correspond plus à la position
+    self->m_aiTurn.action = QUORIDOR_ACTION_UNDEFINED;
+    self->m_aiAccu = 0;
+    core->startTime = clock();
+}
+
+/// @brief Ajoute la partie en cours (jusqu'à la position affichée) au fichier des parties enregistrées.
+static void UIQuoridor_exportGame(UIQuoridor *self)
+{
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    GameRecordWriter *writer = GameRecordWriter_create(UI_GAME_RECORD_PATH, true);
+    if (writer == NULL)
+    {
+        printf("ERROR - fopen %s\n", UI_GAME_RECORD_PATH);
+        return;
+    }
+    Timeline_writeGame(self->m_timeline, writer, core->state);
+    GameRecordWriter_destroy(writer);
+    printf("Game saved to %s (%d moves)\n", UI_GAME_RECORD_PATH, Timeline_getPly(self->m_timeline));
+}
+
 void UIQuoridor_updateTurn(UIQuoridor *self)
 {
 
@@ -40,32 +336,14 @@ void UIQuoridor_updateTurn(UIQuoridor *self)
         if (self->m_aiTurn.action == QUORIDOR_ACTION_UNDEFINED)
         {
             self->m_aiAccu = 0;
-            int depth = 1;
-            switch (UIList_getSelected(self->m_listLevel))
-            {
-            default:
-            case 0: depth = 2; break;
-            case 1: depth = 3; break;
-            case 2: depth = 5; break;
-            }
-
-
-
-           
             int currentPlayerBeforeMove = core->playerID;
-            
-            self->m_aiTurn = QuoridorCore_computeTurn(core, depth, self->m_aiData[core->playerID]);
-           
-            
-            QuoridorData data;
-            data.action = self->m_aiTurn.action;
-            data.destPos.i = self->m_aiTurn.i;
-            data.destPos.j = self->m_aiTurn.j;
-            data.originPos = core->positions[currentPlayerBeforeMove]; 
-
 
-           
-            AIData_add(self->m_aiData[currentPlayerBeforeMove], data);
+            AIData *aiData = self->m_aiData[core->playerID];
+            UIQuoridor_configureAI(self, aiData);
+            AIData_setTimeLimit(aiData, UI_AI_MAX_TIME_MS);
+            self->m_aiTurn = QuoridorCore_computeTurn(core, AI_MAX_PLY - 1, aiData);
+            AIData_clearStop(aiData);
+            self->m_lastAIPlayer = currentPlayerBeforeMove;
 
 
             clock_t startTime = clock();
@@ -90,7 +368,7 @@ void UIQuoridor_updateTurn(UIQuoridor *self)
 
             if (self->m_aiAccu > minTime)
             {
-                QuoridorCore_playTurn(core, self->m_aiTurn);
+                UIQuoridor_playTurn(self, self->m_aiTurn);
                 self->m_aiTurn.action = QUORIDOR_ACTION_UNDEFINED;
                 return;
             }
@@ -103,13 +381,18 @@ void UIQuoridor_updateTurn(UIQuoridor *self)
         clock_t endTime;
 
 
+        // Contre l'IA, celle-ci réfléchit pendant le tour du joueur
+        if (UIList_getSelected(self->m_listMode) == 1 && self->m_isPonderStarted == false)
+            UIQuoridor_startPonder(self);
+
+        // Le conseil se cherche en arrière-plan pendant que le joueur réfléchit
+        if (self->m_isCheatEnable && self->m_isHintStarted == false)
+            UIQuoridor_startHint(self);
+
         const int gridSize = core->gridSize;
         Input *input = Scene_getInput(self->m_scene);
         if (input->validatePressed == false) return;
 
-        
-        int currentPlayerBeforeMove = core->playerID;
-
         Vec2 mousePos = input->mousePos;
         for (int i = 0; i < gridSize; i++)
         {
@@ -119,24 +402,8 @@ void UIQuoridor_updateTurn(UIQuoridor *self)
                 {
                     if (QuoridorCore_canMoveTo(core, i, j))
                     {
-
-                        
-                        QuoridorData data;
-                        data.action = QUORIDOR_MOVE_TO;
-                        data.destPos.i = i;
-                        data.destPos.j = j;
-                        data.originPos = core->positions[currentPlayerBeforeMove]; // Position avt mvt 
-
-                        
-
-                        QuoridorCore_moveTo(core, i, j);
-
-
-                        core->startTime = clock();
-                      
-                        AIData_add(self->m_aiData[currentPlayerBeforeMove], data);
-
-
+                        QuoridorTurn turn = { .action = QUORIDOR_MOVE_TO, .i = i, .j = j };
+                        UIQuoridor_playTurn(self, turn);
                         return; 
                     }
                 }
@@ -151,21 +418,8 @@ void UIQuoridor_updateTurn(UIQuoridor *self)
                 {
                     if (QuoridorCore_canPlayWall(core, WALL_TYPE_HORIZONTAL, i, j))
                     {
-                        endTime = clock();
-
-                        QuoridorData data;
-                        data.action = QUORIDOR_PLAY_HORIZONTAL_WALL;
-                        data.destPos.i = i;
-                        data.destPos.j = j;
-                        data.originPos = core->positions[currentPlayerBeforeMove];
-
-                        QuoridorCore_playWall(core, WALL_TYPE_HORIZONTAL, i, j);
-
-                        core->startTime = clock();
-
-
-
-                        AIData_add(self->m_aiData[currentPlayerBeforeMove], data);
+                        QuoridorTurn turn = { .action = QUORIDOR_PLAY_HORIZONTAL_WALL, .i = i, .j = j };
+                        UIQuoridor_playTurn(self, turn);
                         return; 
 
                     }
@@ -174,18 +428,8 @@ void UIQuoridor_updateTurn(UIQuoridor *self)
                 {
                     if (QuoridorCore_canPlayWall(core, WALL_TYPE_VERTICAL, i, j))
                     {
-
-                        core->startTime = clock();
-
-                        QuoridorData data;
-                        data.action = QUORIDOR_PLAY_VERTICAL_WALL;
-                        data.destPos.i = i;
-                        data.destPos.j = j;
-                        data.originPos = core->positions[currentPlayerBeforeMove];
-
-                        QuoridorCore_playWall(core, WALL_TYPE_VERTICAL, i, j);
-
-                        AIData_add(self->m_aiData[currentPlayerBeforeMove], data);
+                        QuoridorTurn turn = { .action = QUORIDOR_PLAY_VERTICAL_WALL, .i = i, .j = j };
+                        UIQuoridor_playTurn(self, turn);
                         return; 
 
                     }
@@ -262,10 +506,21 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
     QuoridorCore *core = Scene_getQuoridorCore(scene);
 
     core->playerCount = 2;
+    self->m_openingBook = OpeningBook_open(UI_OPENING_BOOK_PATH);
     for (int i = 0; i < 8; i++)
     {
-        self->m_aiData[i] = AIData_create(core); 
+        self->m_aiData[i] = AIData_create(); 
+        ((AIData *)self->m_aiData[i])->openingBook = self->m_openingBook;
+        AIData_loadKnowledge(self->m_aiData[i], UI_AI_KNOWLEDGE_PATH);
     }
+    self->m_lastAIPlayer = -1;
+    self->m_ponderData = AIData_create();
+    self->m_hintData = AIData_create();
+    self->m_hintMutex = SDL_CreateMutex();
+    AssertNew(self->m_hintMutex);
+    self->m_timeline = Timeline_create();
+    Timeline_reset(self->m_timeline, core);
+    UIQuoridor_addPosition(self, core, true);
 
     AssetManager *assets = Scene_getAssetManager(scene);
     TTF_Font *font = NULL;
@@ -281,10 +536,12 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
     );
     UIList_setSelected(self->m_listMode, 0);
 
-    const char *levelValues[] = { "easy", "medium", "hard" };
+    const char *levelValues[AI_LEVEL_COUNT] = { 0 };
+    for (int level = 0; level < AI_LEVEL_COUNT; level++)
+        levelValues[level] = AILevel_getName((AILevel)level);
     self->m_listLevel = UIList_create(
         scene, rect, 0.5f, font,
-        "CPU Level", levelValues, sizeof(levelValues) / sizeof(char *),
+        "CPU Level", levelValues, AI_LEVEL_COUNT,
         g_colors.white, g_colors.cell, g_colors.selected
     );
     UIList_setSelected(self->m_listLevel, 0);
@@ -347,6 +604,10 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
         scene, rect, font, "<-",
         g_colors.white, g_colors.cell, g_colors.selected 
     );
+    self->m_buttonActionForward = UIButton_create(
+        scene, rect, font, "->",
+        g_colors.white, g_colors.cell, g_colors.selected
+    );
     self->m_buttonCheatSwitch = UIButton_create(
         scene, rect, font, "Preview",
         g_colors.white, g_colors.cell, g_colors.selected 
@@ -358,6 +619,8 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
     self->m_textTitleDistances = Text_create(g_renderer, font, "Distances", g_colors.white);
     self->m_textTime[0] = Text_create(g_renderer, font, "0.00", g_colors.white);
     self->m_textTitleTime = Text_create(g_renderer, font, "Time", g_colors.white);
+    self->m_textTitleHint = Text_create(g_renderer, font, "Hint", g_colors.white);
+    self->m_textHint = Text_create(g_renderer, font, "-", g_colors.white);
 
     font = AssetManager_getFont(assets, FONT_BIG);
     self->m_textTitleSettings = Text_create(g_renderer, font, "Settings", g_colors.player[0]);
@@ -383,12 +646,31 @@ void UIQuoridor_destroy(UIQuoridor *self)
 {
     if (!self) return;
 
+    UIQuoridor_stopPonder(self, (QuoridorTurn) { 0 });
+    UIQuoridor_stopHint(self);
+
+    // Les connaissances de la dernière IA qui a joué servent au prochain lancement
+    if (self->m_lastAIPlayer >= 0 && !AIData_saveKnowledge(self->m_aiData[self->m_lastAIPlayer], UI_AI_KNOWLEDGE_PATH))
+        printf("ERROR - fopen %s\n", UI_AI_KNOWLEDGE_PATH);
+
+    // Les arbres MCTS et les tables des fins de partie de la copie appartiennent à l'IA copiée
+    self->m_ponderData->mcts = NULL;
+    self->m_ponderData->raceSolver = NULL;
+    self->m_ponderData->pnSearch = NULL;
+    AIData_destroy(self->m_ponderData);
+    self->m_hintData->mcts = NULL;
+    self->m_hintData->raceSolver = NULL;
+    self->m_hintData->pnSearch = NULL;
+    AIData_destroy(self->m_hintData);
+    SDL_DestroyMutex(self->m_hintMutex);
+
     for (int i = 0; i < 8; i++)
     {
         AIData_destroy(self->m_aiData[i]);
         Text_destroy(self->m_textWalls[i]);
         Text_destroy(self->m_textDistances[i]);
     }
+    OpeningBook_close(self->m_openingBook);
 
     Text_destroy(self->m_textTitleInfo);
     Text_destroy(self->m_textTitleWalls);
@@ -397,6 +679,8 @@ void UIQuoridor_destroy(UIQuoridor *self)
 
 
     Text_destroy(self->m_textInfo);
+    Text_destroy(self->m_textTitleHint);
+    Text_destroy(self->m_textHint);
 
     UIList_destroy(self->m_listMode);
     UIList_destroy(self->m_listLevel);
@@ -409,6 +693,8 @@ void UIQuoridor_destroy(UIQuoridor *self)
     UIButton_destroy(self->m_buttonRestart);
     UIButton_destroy(self->m_buttonBack);
 	UIButton_destroy(self->m_buttonActionBack);
+    UIButton_destroy(self->m_buttonActionForward);
+    Timeline_destroy(self->m_timeline);
 	UIButton_destroy(self->m_buttonCheatSwitch);
 
     free(self);
@@ -435,10 +721,12 @@ void UIQuoridor_updatePageMain(UIQuoridor *self)
     assert(self && "The UIQuoridor must be created");
 
     QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    Input *input = Scene_getInput(self->m_scene);
 
     UIButton_update(self->m_buttonSettings);
     UIButton_update(self->m_buttonRestart);
     UIButton_update(self->m_buttonActionBack);
+    UIButton_update(self->m_buttonActionForward);
 	UIButton_update(self->m_buttonCheatSwitch);
 
 
@@ -460,17 +748,29 @@ void UIQuoridor_updatePageMain(UIQuoridor *self)
     {
         UIQuoridor_restartQuoridor(self);
     }
-    else if (UIButton_isPressed(self->m_buttonActionBack))
+    else if (UIButton_isPressed(self->m_buttonActionBack) || input->undoPressed)
+    {
+        UIQuoridor_undoRedo(self, false);
+    }
+    else if (UIButton_isPressed(self->m_buttonActionForward) || input->redoPressed)
     {
-        QuoridorCore_Undo(core, self);
+        UIQuoridor_undoRedo(self, true);
+    }
+    else if (input->exportPressed)
+    {
+        UIQuoridor_exportGame(self);
     }
     else if (UIButton_isPressed(self->m_buttonCheatSwitch))
     {
 		self->m_isCheatEnable = !self->m_isCheatEnable; 
+        if (self->m_isCheatEnable == false)
+            UIQuoridor_stopHint(self);
     }
     else
     {
+        TRACE_SCOPE_BEGIN("UIQuoridor_updateTurn");
         UIQuoridor_updateTurn(self);
+        TRACE_SCOPE_END();
     }
 
     char buffer[128] = { 0 };
@@ -494,6 +794,22 @@ void UIQuoridor_updatePageMain(UIQuoridor *self)
         Text_setString(self->m_textDistances[i], buffer);
     }
 
+    // Le conseil affiché est lu à chaque image, sans attendre la recherche
+    QuoridorTurn hintTurn = { 0 };
+    float hintScore = 0.f;
+    const int hintDepth = UIQuoridor_getHint(self, &hintTurn, &hintScore);
+    if (hintDepth > 0)
+    {
+        char turnName[16] = { 0 };
+        QuoridorTurn_toString(hintTurn, turnName, sizeof(turnName));
+        sprintf(buffer, "%s  %+.2f  depth %d", turnName, hintScore, hintDepth);
+    }
+    else
+    {
+        sprintf(buffer, "%s", self->m_isHintStarted ? "..." : "-");
+    }
+    Text_setString(self->m_textHint, buffer);
+
     const bool playerTurn = UIQuoridor_isPlayerTurn(self);
     if (core->state == QUORIDOR_STATE_IN_PROGRESS)
     {
@@ -579,6 +895,9 @@ void UIQuoridor_restartQuoridor(UIQuoridor *self)
     assert(self && "The UIQuoridor must be created");
 
     QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    UIQuoridor_stopPonder(self, (QuoridorTurn) { 0 });
+    UIQuoridor_stopHint(self);
+    self->m_lastAIPlayer = -1;
 
     int wallCount = 0;
     switch (UIList_getSelected(self->m_listWallCount))
@@ -621,7 +940,7 @@ void UIQuoridor_restartQuoridor(UIQuoridor *self)
         QuoridorCore_randomStart(core);
     }
 
-    for (int i = 0; i < 4; i++)
+    for (int i = 0; i < 8; i++)
     {
         AIData_reset(self->m_aiData[i]); 
     }
@@ -639,6 +958,8 @@ void UIQuoridor_restartQuoridor(UIQuoridor *self)
     
     self->m_aiTurn.action = QUORIDOR_ACTION_UNDEFINED;
     self->m_isCheatEnable = false;
+    Timeline_reset(self->m_timeline, core);
+    UIQuoridor_addPosition(self, core, true);
     UIQuoridor_updateRects(self);
 }
 
@@ -672,10 +993,17 @@ void UIQuoridor_updateRects(UIQuoridor *self)
     rect.x += roundf(rect.w + 0.2f * scale);
     UIButton_setRect(self->m_buttonRestart, rect);
 
+    // Les boutons d'annulation et de rétablissement se partagent la place d'un bouton
     rect.x += roundf(rect.w + 0.2f * scale); 
+    const float buttonW = rect.w;
+    rect.w = roundf(0.5f * (buttonW - 0.2f * scale));
 	UIButton_setRect(self->m_buttonActionBack, rect);
+
+    rect.x += roundf(rect.w + 0.2f * scale);
+    UIButton_setRect(self->m_buttonActionForward, rect);
     
     rect.x += roundf(rect.w + 0.2f * scale); 
+    rect.w = buttonW;
 	UIButton_setRect(self->m_buttonCheatSwitch, rect);
 
 
@@ -848,20 +1176,20 @@ void UIQuoridor_renderBoard(UIQuoridor *self)
 
         }
 
+    // Le plus court chemin du joueur courant ne dépend pas de la case dessinée
+    QuoridorPos path[MAX_PATH_LEN];
+#ifdef A_STAR
+    int size = AStar_search(core, core->playerID, path);
+#else 
+    int size = BFS_search2(core, core->playerID, path);
+#endif
+
     int tmp = 0;
     for (int i = 0; i < gridSize; i++)
     {
         for (int j = 0; j < gridSize; j++)
         {
             tmp = 0;
-            QuoridorPos path[MAX_PATH_LEN];
-            
-#ifdef A_STAR
-			int size = AStar_search(core, core->playerID, path);
-#else 
-			int size = BFS_search2(core, core->playerID, path);
-#endif
-
 
             SDL_FRect rect = self->m_rectCells[i][j];
             for (int c = 0; c < core->playerCount; c++)
@@ -965,6 +1293,24 @@ void UIQuoridor_renderBoard(UIQuoridor *self)
             }
         }
     }
+
+    // Coup conseillé par la recherche en arrière-plan
+    QuoridorTurn hintTurn = { 0 };
+    float hintScore = 0.f;
+    if (self->m_isCheatEnable && playerTurn && core->state == QUORIDOR_STATE_IN_PROGRESS &&
+        UIQuoridor_getHint(self, &hintTurn, &hintScore) > 0)
+    {
+        if (hintTurn.action == QUORIDOR_MOVE_TO)
+        {
+            Game_setRenderDrawColor(g_colors.player[core->playerID], 90);
+            SDL_RenderFillRect(g_renderer, &(self->m_rectCells[hintTurn.i][hintTurn.j]));
+        }
+        Game_setRenderDrawColor(g_colors.player[core->playerID], 160);
+        if (hintTurn.action == QUORIDOR_PLAY_HORIZONTAL_WALL)
+            SDL_RenderFillRect(g_renderer, &(self->m_rectHWalls[hintTurn.i][hintTurn.j]));
+        else if (hintTurn.action == QUORIDOR_PLAY_VERTICAL_WALL)
+            SDL_RenderFillRect(g_renderer, &(self->m_rectVWalls[hintTurn.i][hintTurn.j]));
+    }
 }
 
 void UIQuoridor_render(UIQuoridor *self)
@@ -998,6 +1344,7 @@ void UIQuoridor_renderPageMain(UIQuoridor *self)
     UIButton_render(self->m_buttonSettings);
     UIButton_render(self->m_buttonRestart);
 	UIButton_render(self->m_buttonActionBack);
+    UIButton_render(self->m_buttonActionForward);
 	UIButton_render(self->m_buttonCheatSwitch);
 
     // Panels
@@ -1038,6 +1385,16 @@ void UIQuoridor_renderPageMain(UIQuoridor *self)
             self->m_textTime, 1
         );
 
+        if (self->m_isCheatEnable)
+        {
+            y += blockSep;
+            y = UIQuoridor_renderPanel(
+                self, x, y, panelWidth,
+                self->m_textTitleHint,
+                &(self->m_textHint), 1
+            );
+        }
+
         y += blockSep;
         for (int p = 0; p < core->playerCount; p++)
         {
@@ -9,6 +9,7 @@
 #include "settings.h"
 #include "core/quoridor_core.h"
 #include "core/quoridor_ai.h"
+#include "core/timeline.h"
 #include "engine/text.h"
 #include "game/ui_button.h"
 #include "game/ui_list.h"
@@ -16,6 +17,23 @@
 
 typedef struct Scene Scene;
 
+/// @brief Fichier auquel sont ajoutées les parties enregistrées depuis l'interface (touche F5).
+#define UI_GAME_RECORD_PATH "quoridor_games.qrec"
+
+/// @brief Bibliothèque d'ouvertures ouverte au lancement si le fichier existe (voir l'outil "book").
+#define UI_OPENING_BOOK_PATH "quoridor_book.qbk"
+
+/// @brief Connaissances de l'IA chargées au lancement et enregistrées à la fermeture (voir AIData_saveKnowledge()).
+#define UI_AI_KNOWLEDGE_PATH "quoridor_ai.qkn"
+
+/// @brief Durée maximale d'un coup de l'IA en millisecondes, qui ne sert qu'à ne pas bloquer
+/// l'interface sur une machine lente : le coût d'un coup est fixé par la limite de noeuds du niveau.
+#define UI_AI_MAX_TIME_MS 5000
+
+/// @brief Durée maximale en millisecondes de la recherche de conseil pour le joueur humain,
+/// qui s'arrête ensuite pour ne pas occuper un coeur pendant toute la réflexion du joueur.
+#define UI_HINT_MAX_TIME_MS 20000
+
 typedef struct UIQuoridor
 {
     Scene *m_scene;
@@ -43,6 +61,7 @@ typedef struct UIQuoridor
     UIButton *m_buttonRestart;
     UIButton *m_buttonBack;
 	UIButton* m_buttonActionBack;
+    UIButton *m_buttonActionForward;
 	UIButton* m_buttonCheatSwitch;
 
     UIList *m_listMode;
@@ -59,6 +78,41 @@ typedef struct UIQuoridor
 
     void *m_aiData[8];
 
+    /// @brief Joueur dont l'IA a calculé le dernier coup (-1 si aucun).
+    int m_lastAIPlayer;
+
+    /// @brief Historique complet de la partie, pour annuler et rétablir les coups.
+    Timeline *m_timeline;
+
+    /// @brief Bibliothèque d'ouvertures partagée par les IA (NULL si le fichier est absent).
+    OpeningBook *m_openingBook;
+
+    /// @brief Recherche de l'IA pendant le tour du joueur humain (pondering).
+    /// Elle porte sur m_ponderCore, la partie après le coup prévu m_ponderMove,
+    /// avec une copie m_ponderData des données de l'IA m_ponderPlayer.
+    SDL_Thread *m_ponderThread;
+    QuoridorCore m_ponderCore;
+    QuoridorTurn m_ponderMove;
+    QuoridorTurn m_ponderTurn;
+    AIData *m_ponderData;
+    int m_ponderPlayer;
+    bool m_isPonderStarted;
+
+    /// @brief Conseil affiché au joueur humain quand m_isCheatEnable est vrai.
+    /// Une recherche par approfondissement itératif porte sur m_hintCore avec une copie m_hintData
+    /// des données de l'IA du joueur. Après chaque profondeur, elle publie sous m_hintMutex
+    /// le meilleur coup m_hintTurn, son score m_hintScore et la profondeur m_hintDepth (0 si aucune).
+    SDL_Thread *m_hintThread;
+    SDL_Mutex *m_hintMutex;
+    QuoridorCore m_hintCore;
+    AIData *m_hintData;
+    QuoridorTurn m_hintTurn;
+    float m_hintScore;
+    int m_hintDepth;
+    bool m_isHintStarted;
+    Text *m_textTitleHint;
+    Text *m_textHint;
+
 
     Uint64 m_aiAccu;
 
@@ -80,5 +134,3 @@ void UIQuoridor_render(UIQuoridor *self);
 void UIQuoridor_renderPageMain(UIQuoridor *self);
 void UIQuoridor_renderPageSettings(UIQuoridor *self);
 void UIQuoridor_renderBoard(UIQuoridor *self);
-
-void QuoridorCore_Undo(QuoridorCore* self, UIQuoridor* uiSelf); 
\ No newline at end of file
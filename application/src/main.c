@@ -12,6 +12,8 @@
 #include "game/game_common.h"
 #include "game/input.h"
 #include "game/scene.h"
+#include "tools/tools.h"
+#include "core/trace.h"
 
 #include <SDL3/SDL_main.h>
 
@@ -31,6 +33,15 @@
 int main(int argc, char *argv[])
 {
     srand((unsigned int)time(NULL));
+    TRACE_INIT(NULL);
+
+    // Outils en ligne de commande, sans fenêtre
+    if (argc > 1)
+    {
+        const int exitStatus = Tools_main(argc, argv);
+        TRACE_QUIT();
+        return exitStatus;
+    }
 
     Scene *scene = NULL;
     bool quitGame = false;
@@ -80,6 +91,7 @@ int main(int argc, char *argv[])
     // Libération de la mémoire
 
     Scene_destroy(scene); scene = NULL;
+    TRACE_QUIT();
     Game_destroyRenderer();
     Game_destroyWindow();
     Game_quit();
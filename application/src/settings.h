@@ -37,4 +37,9 @@
 
 //#define A_STAR
 
+/// Active les marqueurs de profilage (voir core/trace.h).
+/// Un fichier trace_<date>.json est écrit à la fin de chaque session.
+
+//#define TRACE
+
 // ---------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,253 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "tools/tools.h"
+#include "core/quoridor_ai.h"
+#include "core/utils.h"
+
+#define ANALYZE_MAX_THREADS 64
+
+/// @brief Résultat de l'analyse d'une position.
+typedef struct AnalyzeResult
+{
+    bool valid;
+    QuoridorTurn turn;
+    AIStats stats;
+
+    /// @brief Lignes de l'analyse multi-PV (si AnalyzeContext::lineCount > 1).
+    AIPVLine lines[AI_MAX_MULTI_PV];
+    int lineCount;
+} AnalyzeResult;
+
+/// @brief Paramètres et données partagées par les threads d'analyse.
+/// Chaque thread prend la position suivante avec un compteur atomique
+/// et écrit son résultat à l'indice de la position.
+typedef struct AnalyzeContext
+{
+    char **positions;
+    AnalyzeResult *results;
+    int positionCount;
+    int depth;
+    Uint64 moveTime;
+    Uint64 nodeLimit;
+    int lineCount;
+    Uint64 seed;
+    AIEngine engine;
+    AISearchSettings searchSettings;
+    Tablebase *tablebase;
+    const char *knowledgePath;
+    SDL_AtomicInt nextPosition;
+} AnalyzeContext;
+
+static int AnalyzeTool_workerMain(void *data)
+{
+    AnalyzeContext *context = (AnalyzeContext *)data;
+    QuoridorCore *core = QuoridorCore_create();
+    AIData *aiData = AIData_create();
+
+    while (true)
+    {
+        const int index = SDL_AddAtomicInt(&context->nextPosition, 1);
+        if (index >= context->positionCount)
+            break;
+
+        AnalyzeResult *result = &(context->results[index]);
+        result->valid = QuoridorCore_fromString(core, context->positions[index]) > 0;
+        if (result->valid == false)
+            continue;
+
+        // Le résultat d'une position ne dépend pas du thread qui l'analyse
+        AIData_reset(aiData);
+        AIData_setSeed(aiData, Rng_mix(context->seed + (Uint64)index));
+        AIData_clearKnowledge(aiData);
+        if (context->knowledgePath)
+            AIData_loadKnowledge(aiData, context->knowledgePath);
+        aiData->engine = context->engine;
+        aiData->searchSettings = context->searchSettings;
+        aiData->tablebase = context->tablebase;
+        aiData->mctsSettings.timeMS = context->moveTime > 0 ? (int)context->moveTime : (context->nodeLimit > 0 ? 0 : 100);
+        AIData_setNodeLimit(aiData, context->nodeLimit);
+
+        // MCTS est déjà limité en temps : l'approfondissement itératif ne concerne que max^n et min-max
+        if (context->lineCount > 1)
+        {
+            AIData_clearStop(aiData);
+            if (context->moveTime > 0)
+                AIData_setTimeLimit(aiData, context->moveTime);
+            result->lineCount = QuoridorCore_computeMultiPV(
+                core, context->depth, context->lineCount, aiData, result->lines, NULL, NULL);
+            result->turn = (result->lineCount > 0) ? result->lines[0].pv[0] : (QuoridorTurn) { 0 };
+        }
+        else if (context->moveTime > 0 && context->engine != AI_ENGINE_MCTS)
+        {
+            AIData_clearStop(aiData);
+            AIData_setTimeLimit(aiData, context->moveTime);
+            result->turn = QuoridorCore_computeIterativeTurn(core, context->depth, aiData, NULL, NULL);
+        }
+        else
+        {
+            result->turn = QuoridorCore_computeTurn(core, context->depth, aiData);
+        }
+        result->stats = aiData->stats;
+    }
+
+    AIData_destroy(aiData);
+    QuoridorCore_destroy(core);
+    return 0;
+}
+
+/// @brief Lit les positions d'un fichier, une par ligne.
+/// Les lignes vides et celles commençant par '#' sont ignorées.
+/// @return Le tableau des positions, à libérer avec free() (ainsi que chaque position).
+static char **AnalyzeTool_readPositions(FILE *file, int *positionCount)
+{
+    int capacity = 1024;
+    int count = 0;
+    char **positions = (char **)calloc(capacity, sizeof(char *));
+    AssertNew(positions);
+
+    char line[MAX_POSITION_STRING] = { 0 };
+    while (fgets(line, sizeof(line), file))
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#')
+            continue;
+
+        if (count == capacity)
+        {
+            capacity *= 2;
+            positions = (char **)realloc(positions, capacity * sizeof(char *));
+            AssertNew(positions);
+        }
+        positions[count] = SDL_strdup(line);
+        AssertNew(positions[count]);
+        count++;
+    }
+
+    *positionCount = count;
+    return positions;
+}
+
+int AnalyzeTool_main(int argc, char *argv[])
+{
+    const char *inputPath = Tools_getStringOption(argc, argv, "--input", NULL);
+    const char *outputPath = Tools_getStringOption(argc, argv, "--output", NULL);
+    if (inputPath == NULL)
+    {
+        printf("analyze: --input is required\n");
+        return EXIT_FAILURE;
+    }
+
+    AnalyzeContext context = { 0 };
+    context.engine = AIEngine_fromName(Tools_getStringOption(argc, argv, "--engine", "minmax"));
+    if (!Tools_getNodeLimit(argc, argv, -1, context.engine, &context.nodeLimit) ||
+        !Tools_getKnowledgePath(argc, argv, &context.knowledgePath) ||
+        !Tools_openTablebase(argc, argv, &context.tablebase))
+        return EXIT_FAILURE;
+
+    FILE *input = strcmp(inputPath, "-") == 0 ? stdin : fopen(inputPath, "r");
+    if (input == NULL)
+    {
+        printf("ERROR - fopen %s\n", inputPath);
+        Tablebase_close(context.tablebase);
+        return EXIT_FAILURE;
+    }
+
+    context.positions = AnalyzeTool_readPositions(input, &context.positionCount);
+    if (input != stdin) fclose(input);
+
+    context.depth = Int_clamp(Tools_getIntOption(argc, argv, "--depth", 2), 1, AI_MAX_PLY - 1);
+    context.moveTime = (Uint64)Int_max(0, Tools_getIntOption(argc, argv, "--movetime", 0));
+    context.seed = (Uint64)Tools_getIntOption(argc, argv, "--seed", 0);
+    context.lineCount = Int_clamp(Tools_getIntOption(argc, argv, "--multipv", 1), 1, AI_MAX_MULTI_PV);
+    AISearchSettings_setDefault(&context.searchSettings);
+    Tools_getSearchSettings(argc, argv, -1, &context.searchSettings);
+    context.results = (AnalyzeResult *)calloc(Int_max(1, context.positionCount), sizeof(AnalyzeResult));
+    AssertNew(context.results);
+    SDL_SetAtomicInt(&context.nextPosition, 0);
+
+    // Sans limite de temps ni de noeuds, la profondeur est fixe ; sinon elle est un maximum
+    if ((context.moveTime > 0 || context.nodeLimit > 0) && Tools_hasOption(argc, argv, "--depth") == false)
+        context.depth = AI_MAX_PLY - 1;
+
+    int threadCount = Tools_getIntOption(argc, argv, "--threads", SDL_GetNumLogicalCPUCores());
+    threadCount = Int_clamp(threadCount, 1, ANALYZE_MAX_THREADS);
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    SDL_Thread *threads[ANALYZE_MAX_THREADS] = { 0 };
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads[t] = SDL_CreateThread(AnalyzeTool_workerMain, "analyze", &context);
+        if (threads[t] == NULL)
+        {
+            printf("ERROR - SDL_CreateThread %s\n", SDL_GetError());
+            AnalyzeTool_workerMain(&context);
+        }
+    }
+    for (int t = 0; t < threadCount; t++)
+    {
+        SDL_WaitThread(threads[t], NULL);
+    }
+    const double elapsed = Tools_getElapsed(start);
+
+    FILE *output = outputPath ? fopen(outputPath, "w") : stdout;
+    if (output == NULL)
+    {
+        printf("ERROR - fopen %s\n", outputPath);
+        output = stdout;
+    }
+
+    int invalidCount = 0;
+    fprintf(output, "# position\tbestmove\tscore\tdepth\tnodes\ttime_ms%s\n",
+        context.lineCount > 1 ? "\tlines (score pv)" : "");
+    for (int p = 0; p < context.positionCount; p++)
+    {
+        const AnalyzeResult *result = &(context.results[p]);
+        if (result->valid == false)
+        {
+            fprintf(output, "%s\tinvalid\n", context.positions[p]);
+            invalidCount++;
+            continue;
+        }
+
+        char move[16] = "(none)";
+        if (result->turn.action != QUORIDOR_ACTION_UNDEFINED)
+            QuoridorTurn_toString(result->turn, move, sizeof(move));
+
+        fprintf(output, "%s\t%s\t%.2f\t%d\t%llu\t%.1f",
+            context.positions[p], move, result->stats.score, result->stats.depth,
+            (unsigned long long)result->stats.nodeCount, 1000.0 * result->stats.elapsed);
+
+        // Une colonne par ligne de l'analyse multi-PV : score puis variation
+        for (int k = 0; k < result->lineCount; k++)
+        {
+            const AIPVLine *line = &(result->lines[k]);
+            fprintf(output, "\t%.2f", line->score);
+            for (int m = 0; m < line->pvLength; m++)
+            {
+                char name[16] = { 0 };
+                QuoridorTurn_toString(line->pv[m], name, sizeof(name));
+                fprintf(output, " %s", name);
+            }
+        }
+        fprintf(output, "\n");
+    }
+    if (output != stdout) fclose(output);
+
+    fprintf(stderr, "analyze: %d positions (%d invalid) in %.2f s with %d threads (%.1f positions/s)\n",
+        context.positionCount, invalidCount, elapsed, threadCount,
+        elapsed > 0.0 ? context.positionCount / elapsed : 0.0);
+
+    for (int p = 0; p < context.positionCount; p++)
+    {
+        SDL_free(context.positions[p]);
+    }
+    free(context.positions);
+    free(context.results);
+    Tablebase_close(context.tablebase);
+
+    return invalidCount > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "tools/tools.h"
+#include "core/opening_book.h"
+#include "core/game_record.h"
+#include "core/utils.h"
+
+/// @brief Nombre maximal de plies retenus au début de chaque partie.
+#define BOOK_TOOL_MAX_PLIES 64
+
+/// @brief Ajoute les parties d'un enregistrement au constructeur.
+/// @return Le nombre de parties lues, ou -1 si l'enregistrement est mal formé.
+static int BookTool_addGames(OpeningBookBuilder *builder, GameRecordReader *reader, int maxPlies)
+{
+    QuoridorCore start = { 0 };
+    QuoridorTurn turns[BOOK_TOOL_MAX_PLIES];
+    int gameCount = 0;
+
+    while (GameRecordReader_beginGame(reader, &start))
+    {
+        // Seuls les premiers coups sont gardés, la suite n'est lue que pour le résultat
+        int turnCount = 0;
+        QuoridorTurn turn = { 0 };
+        while (GameRecordReader_nextTurn(reader, &turn))
+        {
+            if (turnCount < maxPlies)
+                turns[turnCount++] = turn;
+        }
+        if (reader->hasError)
+            return -1;
+
+        OpeningBookBuilder_addGame(builder, &start, turns, turnCount, reader->result);
+        gameCount++;
+    }
+    return reader->hasError ? -1 : gameCount;
+}
+
+/// @brief Affiche les coups de la bibliothèque pour une position.
+static void BookTool_printPosition(OpeningBook *book, QuoridorCore *core)
+{
+    char str[MAX_POSITION_STRING] = { 0 };
+    QuoridorCore_toString(core, str, sizeof(str));
+
+    int count = 0;
+    const OpeningBookEntry *entries = OpeningBook_find(book, core, &count);
+    if (count == 0)
+    {
+        printf("%s: not in the book\n", str);
+        return;
+    }
+
+    printf("%s: %d moves\n", str, count);
+    for (int k = 0; k < count; k++)
+    {
+        const QuoridorTurn turn = { entries[k].action, entries[k].i, entries[k].j };
+        char name[16] = { 0 };
+        QuoridorTurn_toString(turn, name, sizeof(name));
+        printf("  %-5s weight %u  games %u  won %u  drawn %u\n", name,
+            entries[k].weight, entries[k].gameCount, entries[k].winCount, entries[k].drawCount);
+    }
+}
+
+int BookTool_main(int argc, char *argv[])
+{
+    const char *inputPath = Tools_getStringOption(argc, argv, "--input", NULL);
+    const char *outputPath = Tools_getStringOption(argc, argv, "--output", NULL);
+    const char *path = Tools_getStringOption(argc, argv, "--book", outputPath);
+    if (path == NULL || (inputPath && outputPath == NULL))
+    {
+        printf("ERROR - book: --input FILE --output FILE or --book FILE is required\n");
+        return EXIT_FAILURE;
+    }
+
+    if (inputPath)
+    {
+        GameRecordReader *reader = GameRecordReader_create(inputPath);
+        if (reader == NULL)
+        {
+            printf("ERROR - %s is not a game record\n", inputPath);
+            return EXIT_FAILURE;
+        }
+
+        const int maxPlies = Int_clamp(Tools_getIntOption(argc, argv, "--plies", 16), 1, BOOK_TOOL_MAX_PLIES);
+        const int minGames = Int_max(1, Tools_getIntOption(argc, argv, "--min-games", 2));
+        OpeningBookBuilder *builder = OpeningBookBuilder_create(maxPlies);
+
+        const Uint64 start = SDL_GetPerformanceCounter();
+        const int gameCount = BookTool_addGames(builder, reader, maxPlies);
+        GameRecordReader_destroy(reader);
+        if (gameCount < 0)
+        {
+            printf("ERROR - invalid game record %s\n", inputPath);
+            OpeningBookBuilder_destroy(builder);
+            return EXIT_FAILURE;
+        }
+
+        const bool success = OpeningBookBuilder_write(builder, outputPath, minGames);
+        OpeningBookBuilder_destroy(builder);
+        if (!success)
+        {
+            printf("ERROR - fopen %s\n", outputPath);
+            return EXIT_FAILURE;
+        }
+        printf("built %s from %d games in %.2f s\n", outputPath, gameCount, Tools_getElapsed(start));
+    }
+
+    OpeningBook *book = OpeningBook_open(path);
+    if (book == NULL)
+    {
+        printf("ERROR - %s is not an opening book\n", path);
+        return EXIT_FAILURE;
+    }
+    printf("%d games, %d plies: %d positions, %d moves (%.1f KB)\n", book->gameCount, book->maxPlies,
+        book->positionCount, book->entryCount, (double)book->file->size / 1024.0);
+
+    QuoridorCore core = { 0 };
+    Tools_resetCore(argc, argv, &core);
+    const char *position = Tools_getStringOption(argc, argv, "--position", NULL);
+    if (position && QuoridorCore_fromString(&core, position) == 0)
+    {
+        printf("ERROR - invalid position %s\n", position);
+        OpeningBook_close(book);
+        return EXIT_FAILURE;
+    }
+    BookTool_printPosition(book, &core);
+
+    OpeningBook_close(book);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,378 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "tools/tools.h"
+#include "core/quoridor_ai.h"
+#include "core/utils.h"
+
+#include <stdarg.h>
+
+#define ENGINE_LINE_SIZE 16384
+
+/// @brief État du moteur piloté par le protocole texte.
+/// Seul le thread principal lit les commandes ; la recherche tourne sur son propre thread
+/// et travaille sur une copie de la position.
+typedef struct EngineTool
+{
+    QuoridorCore *core;
+    AIData *aiData;
+
+    int gridSize;
+    int playerCount;
+    int wallCount;
+
+    SDL_Thread *searchThread;
+    QuoridorCore searchCore;
+    int searchDepth;
+
+    /// @brief Nombre de lignes de l'analyse multi-PV (1 pour une recherche simple).
+    int searchLineCount;
+    AIPVLine searchLines[AI_MAX_MULTI_PV];
+
+    /// @brief Verrou de la sortie standard, écrite par les deux threads (voir EngineTool_send()).
+    SDL_Mutex *outputMutex;
+} EngineTool;
+
+/// @brief Envoie une ligne du protocole. La ligne est formatée en entier puis écrite
+/// sous verrou : celles du thread de recherche et du thread principal ne se mélangent pas.
+static void EngineTool_send(EngineTool *self, const char *format, ...)
+{
+    char line[ENGINE_LINE_SIZE + 256] = { 0 };
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line) - 1, format, args);
+    va_end(args);
+    length = Int_clamp(length, 0, (int)sizeof(line) - 2);
+    line[length] = '\n';
+    line[length + 1] = '\0';
+
+    SDL_LockMutex(self->outputMutex);
+    fputs(line, stdout);
+    fflush(stdout);
+    SDL_UnlockMutex(self->outputMutex);
+}
+
+/// @brief Écrit une variation, chaque coup précédé d'une espace.
+static void EngineTool_formatPV(const QuoridorTurn *pv, int pvLength, char *buffer)
+{
+    int length = 0;
+    buffer[0] = '\0';
+    for (int k = 0; k < pvLength && length < ENGINE_LINE_SIZE - 8; k++)
+    {
+        buffer[length++] = ' ';
+        length += QuoridorTurn_toString(pv[k], buffer + length, ENGINE_LINE_SIZE - length);
+    }
+}
+
+static void EngineTool_info(const AIStats *stats, void *userData)
+{
+    EngineTool *self = (EngineTool *)userData;
+    char buffer[ENGINE_LINE_SIZE] = { 0 };
+    EngineTool_formatPV(stats->pv, stats->pvLength, buffer);
+
+    EngineTool_send(self, "info depth %d score %.2f nodes %llu nps %.0f time %.0f pv%s",
+        stats->depth, stats->score, (unsigned long long)stats->nodeCount,
+        stats->nodesPerSecond, 1000.0 * stats->elapsed, buffer);
+}
+
+/// @brief Envoie une ligne "info ... multipv k" par ligne de l'analyse multi-PV.
+static void EngineTool_multiPVInfo(const AIStats *stats, void *userData)
+{
+    EngineTool *self = (EngineTool *)userData;
+    char buffer[ENGINE_LINE_SIZE] = { 0 };
+    for (int k = 0; k < self->searchLineCount && self->searchLines[k].pvLength > 0; k++)
+    {
+        const AIPVLine *line = &(self->searchLines[k]);
+        EngineTool_formatPV(line->pv, line->pvLength, buffer);
+        EngineTool_send(self, "info depth %d multipv %d score %.2f nodes %llu nps %.0f time %.0f pv%s",
+            line->depth, k + 1, line->score, (unsigned long long)stats->nodeCount,
+            stats->nodesPerSecond, 1000.0 * stats->elapsed, buffer);
+    }
+}
+
+static int EngineTool_searchMain(void *data)
+{
+    EngineTool *self = (EngineTool *)data;
+    QuoridorTurn bestTurn = { 0 };
+    if (self->searchLineCount > 1)
+    {
+        memset(self->searchLines, 0, sizeof(self->searchLines));
+        const int lineCount = QuoridorCore_computeMultiPV(&(self->searchCore), self->searchDepth,
+            self->searchLineCount, self->aiData, self->searchLines, EngineTool_multiPVInfo, self);
+
+        // Recherche interrompue avant la fin de la première profondeur :
+        // le coup vient d'une recherche à la profondeur 1 sans limite
+        if (lineCount > 0)
+            bestTurn = self->searchLines[0].pv[0];
+        else
+            bestTurn = QuoridorCore_computeTurn(&(self->searchCore), 1, NULL);
+    }
+    else
+    {
+        bestTurn = QuoridorCore_computeIterativeTurn(
+            &(self->searchCore), self->searchDepth, self->aiData, EngineTool_info, self);
+    }
+
+    char buffer[16] = { 0 };
+    QuoridorTurn_toString(bestTurn, buffer, sizeof(buffer));
+    EngineTool_send(self, "bestmove %s", bestTurn.action == QUORIDOR_ACTION_UNDEFINED ? "(none)" : buffer);
+    return 0;
+}
+
+/// @brief Attend la fin de la recherche en cours.
+/// @param stop Booléen indiquant s'il faut interrompre la recherche.
+static void EngineTool_waitSearch(EngineTool *self, bool stop)
+{
+    if (self->searchThread == NULL) return;
+
+    if (stop) AIData_stop(self->aiData);
+    SDL_WaitThread(self->searchThread, NULL);
+    self->searchThread = NULL;
+    AIData_clearStop(self->aiData);
+}
+
+/// @brief Met en place la position de la commande "position". La commande entière est refusée,
+/// sans modifier la position du moteur, si un champ est inconnu ou sans valeur,
+/// si la position est invalide ou si un coup est illégal.
+static void EngineTool_position(EngineTool *self, char *context)
+{
+    QuoridorCore core = *(self->core);
+    int wallCount = self->wallCount;
+    char *token = SDL_strtok_r(NULL, " \t", &context);
+
+    if (token && strcmp(token, "string") == 0)
+    {
+        // Position en notation compacte (voir QuoridorCore_toString())
+        char position[MAX_POSITION_STRING] = { 0 };
+        for (int field = 0; field < 5 && (token = SDL_strtok_r(NULL, " \t", &context)) != NULL; field++)
+        {
+            SDL_strlcat(position, token, sizeof(position));
+            SDL_strlcat(position, " ", sizeof(position));
+        }
+        if (QuoridorCore_fromString(&core, position) == 0)
+        {
+            EngineTool_send(self, "info string invalid position %s", position);
+            return;
+        }
+        token = SDL_strtok_r(NULL, " \t", &context);
+    }
+    else
+    {
+        int gridSize = self->gridSize;
+        int playerCount = self->playerCount;
+        int firstPlayer = 0;
+        while (token && strcmp(token, "moves") != 0)
+        {
+            char *value = SDL_strtok_r(NULL, " \t", &context);
+            if (value == NULL)
+            {
+                EngineTool_send(self, "info string missing value for position field %s", token);
+                return;
+            }
+
+            if (strcmp(token, "grid") == 0) gridSize = Int_clamp(atoi(value), 3, MAX_GRID_SIZE);
+            else if (strcmp(token, "players") == 0) playerCount = atoi(value);
+            else if (strcmp(token, "walls") == 0) wallCount = Int_max(0, atoi(value));
+            else if (strcmp(token, "first") == 0) firstPlayer = Int_max(0, atoi(value));
+            else
+            {
+                EngineTool_send(self, "info string unknown position field %s", token);
+                return;
+            }
+
+            token = SDL_strtok_r(NULL, " \t", &context);
+        }
+        Tools_reset(&core, gridSize, playerCount, wallCount, firstPlayer);
+    }
+
+    if (token && strcmp(token, "moves") != 0)
+    {
+        EngineTool_send(self, "info string unknown position field %s", token);
+        return;
+    }
+
+    // Les coups sont tous vérifiés avant de modifier la position du moteur
+    // (un coup et son séparateur occupent au moins deux caractères de la ligne)
+    QuoridorTurn *moves = (QuoridorTurn *)calloc(ENGINE_LINE_SIZE / 2, sizeof(QuoridorTurn));
+    AssertNew(moves);
+    const QuoridorCore start = core;
+    int moveCount = 0;
+    while (token && (token = SDL_strtok_r(NULL, " \t", &context)) != NULL)
+    {
+        QuoridorTurn turn = { 0 };
+        const int length = QuoridorTurn_fromString(token, &turn);
+        if (length == 0 || token[length] != '\0' || !QuoridorCore_canPlayTurn(&core, turn))
+        {
+            EngineTool_send(self, "info string illegal move %s", token);
+            free(moves);
+            return;
+        }
+        QuoridorCore_playTurn(&core, turn);
+        moves[moveCount++] = turn;
+    }
+
+    *(self->core) = core;
+    self->playerCount = core.playerCount;
+    self->gridSize = core.gridSize;
+    self->wallCount = wallCount;
+
+    // Les positions de la partie servent à éviter les répétitions
+    core = start;
+    AIData_clearPositions(self->aiData);
+    AIData_addPosition(self->aiData, &core);
+    for (int k = 0; k < moveCount; k++)
+    {
+        QuoridorCore_playTurn(&core, moves[k]);
+        AIData_addPosition(self->aiData, &core);
+    }
+    free(moves);
+}
+
+static void EngineTool_go(EngineTool *self, char *context)
+{
+    int depth = 2;
+    Uint64 moveTime = 0;
+    Uint64 nodeCount = 0;
+    int lineCount = 1;
+
+    char *token = NULL;
+    while ((token = SDL_strtok_r(NULL, " \t", &context)) != NULL)
+    {
+        if (strcmp(token, "infinite") == 0)
+        {
+            depth = AI_MAX_PLY - 1;
+            continue;
+        }
+
+        char *value = SDL_strtok_r(NULL, " \t", &context);
+        if (value == NULL) break;
+
+        if (strcmp(token, "depth") == 0)
+        {
+            depth = atoi(value);
+        }
+        else if (strcmp(token, "movetime") == 0)
+        {
+            moveTime = (Uint64)Int_max(1, atoi(value));
+            depth = AI_MAX_PLY - 1;
+        }
+        else if (strcmp(token, "nodes") == 0)
+        {
+            nodeCount = (Uint64)Int_max(1, atoi(value));
+            depth = AI_MAX_PLY - 1;
+        }
+        else if (strcmp(token, "multipv") == 0)
+        {
+            lineCount = Int_clamp(atoi(value), 1, AI_MAX_MULTI_PV);
+        }
+    }
+
+    AIData_clearStop(self->aiData);
+    if (moveTime > 0)
+        AIData_setTimeLimit(self->aiData, moveTime);
+    AIData_setNodeLimit(self->aiData, nodeCount);
+
+    self->searchCore = *(self->core);
+    self->searchDepth = Int_clamp(depth, 1, AI_MAX_PLY - 1);
+    self->searchLineCount = lineCount;
+    self->searchThread = SDL_CreateThread(EngineTool_searchMain, "search", self);
+    if (self->searchThread == NULL)
+    {
+        printf("ERROR - SDL_CreateThread %s\n", SDL_GetError());
+        EngineTool_searchMain(self);
+    }
+}
+
+int EngineTool_main(int argc, char *argv[])
+{
+    EngineTool self = { 0 };
+    self.outputMutex = SDL_CreateMutex();
+    AssertNew(self.outputMutex);
+    self.core = QuoridorCore_create();
+    self.aiData = AIData_create();
+    self.gridSize = 9;
+    self.playerCount = 2;
+    self.wallCount = 10;
+    Tools_reset(self.core, self.gridSize, self.playerCount, self.wallCount, 0);
+
+    if (Tools_hasOption(argc, argv, "--seed"))
+        AIData_setSeed(self.aiData, (Uint64)Tools_getIntOption(argc, argv, "--seed", 0));
+
+    // Les connaissances de l'IA sont reprises d'une session à l'autre (le fichier peut ne pas exister encore)
+    const char *knowledgePath = Tools_getStringOption(argc, argv, "--knowledge", NULL);
+    if (knowledgePath)
+        AIData_loadKnowledge(self.aiData, knowledgePath);
+
+    char *line = (char *)calloc(ENGINE_LINE_SIZE, sizeof(char));
+    AssertNew(line);
+
+    bool quit = false;
+    while (quit == false && fgets(line, ENGINE_LINE_SIZE, stdin))
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+
+        char *context = NULL;
+        const char *command = SDL_strtok_r(line, " \t", &context);
+        if (command == NULL) continue;
+
+        if (strcmp(command, "quit") == 0)
+        {
+            quit = true;
+        }
+        else if (strcmp(command, "isready") == 0)
+        {
+            EngineTool_send(&self, "readyok");
+        }
+        else if (strcmp(command, "stop") == 0)
+        {
+            EngineTool_waitSearch(&self, true);
+        }
+        else if (strcmp(command, "quoridor") == 0)
+        {
+            EngineTool_waitSearch(&self, false);
+            EngineTool_send(&self, "id name Quoridor");
+            EngineTool_send(&self, "quoridorok");
+        }
+        else if (strcmp(command, "newgame") == 0)
+        {
+            EngineTool_waitSearch(&self, false);
+            AIData_reset(self.aiData);
+            Tools_reset(self.core, self.gridSize, self.playerCount, self.wallCount, 0);
+        }
+        else if (strcmp(command, "position") == 0)
+        {
+            EngineTool_waitSearch(&self, false);
+            EngineTool_position(&self, context);
+        }
+        else if (strcmp(command, "go") == 0)
+        {
+            EngineTool_waitSearch(&self, false);
+            EngineTool_go(&self, context);
+        }
+        else if (strcmp(command, "d") == 0)
+        {
+            EngineTool_waitSearch(&self, false);
+            char position[MAX_POSITION_STRING] = { 0 };
+            QuoridorCore_toString(self.core, position, sizeof(position));
+            QuoridorCore_print(self.core);
+            EngineTool_send(&self, "position string %s", position);
+        }
+        else
+        {
+            EngineTool_send(&self, "info string unknown command %s", command);
+        }
+    }
+
+    // En fin d'entrée, la dernière recherche est menée à son terme
+    EngineTool_waitSearch(&self, quit);
+    if (knowledgePath && !AIData_saveKnowledge(self.aiData, knowledgePath))
+        printf("ERROR - fopen %s\n", knowledgePath);
+    free(line);
+    AIData_destroy(self.aiData);
+    QuoridorCore_destroy(self.core);
+    SDL_DestroyMutex(self.outputMutex);
+    return EXIT_SUCCESS;
+}
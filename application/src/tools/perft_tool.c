@@ -0,0 +1,92 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "tools/tools.h"
+#include "core/perft.h"
+#include "core/utils.h"
+
+static Uint64 PerftTool_run(QuoridorCore *core, int depth, PerftMode mode, bool divide, PerftEntry *entries, int *entryCount)
+{
+    const char *modeName = (mode == PERFT_MODE_FAST) ? "fast" : "reference";
+    Uint64 total = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    if (divide)
+    {
+        *entryCount = Perft_divide(core, depth, mode, entries);
+        for (int k = 0; k < *entryCount; k++)
+        {
+            char name[16] = { 0 };
+            QuoridorTurn_toString(entries[k].turn, name, sizeof(name));
+            printf("  %-5s %llu\n", name, (unsigned long long)entries[k].count);
+            total += entries[k].count;
+        }
+    }
+    else
+    {
+        total = Perft_count(core, depth, mode);
+    }
+
+    const double elapsed = Tools_getElapsed(start);
+    printf("%-9s depth %d: %llu leaves in %.3f s (%.0f leaves/s)\n",
+        modeName, depth, (unsigned long long)total, elapsed,
+        elapsed > 0.0 ? (double)total / elapsed : 0.0);
+    return total;
+}
+
+int PerftTool_main(int argc, char *argv[])
+{
+    const int depth = Int_max(1, Tools_getIntOption(argc, argv, "--depth", 2));
+    const char *modeName = Tools_getStringOption(argc, argv, "--mode", "fast");
+    const bool check = (strcmp(modeName, "check") == 0);
+    const bool divide = Tools_hasOption(argc, argv, "--divide") || check;
+
+    QuoridorCore *core = QuoridorCore_create();
+    Tools_resetCore(argc, argv, core);
+    printf("perft: grid %d, players %d, walls %d\n",
+        core->gridSize, core->playerCount, core->wallCounts[0]);
+
+    PerftEntry *fastEntries = (PerftEntry *)calloc(MAX_TURN_COUNT, sizeof(PerftEntry));
+    PerftEntry *refEntries = (PerftEntry *)calloc(MAX_TURN_COUNT, sizeof(PerftEntry));
+    AssertNew(fastEntries);
+    AssertNew(refEntries);
+
+    int fastCount = 0, refCount = 0;
+    int exitCode = EXIT_SUCCESS;
+
+    if (check || strcmp(modeName, "reference") != 0)
+        PerftTool_run(core, depth, PERFT_MODE_FAST, divide, fastEntries, &fastCount);
+    if (check || strcmp(modeName, "reference") == 0)
+        PerftTool_run(core, depth, PERFT_MODE_REFERENCE, divide, refEntries, &refCount);
+
+    if (check)
+    {
+        // Compare les deux générateurs action par action
+        int mismatches = (fastCount != refCount) ? 1 : 0;
+        for (int k = 0; k < Int_min(fastCount, refCount); k++)
+        {
+            const QuoridorTurn a = fastEntries[k].turn;
+            const QuoridorTurn b = refEntries[k].turn;
+            if (a.action != b.action || a.i != b.i || a.j != b.j ||
+                fastEntries[k].count != refEntries[k].count)
+            {
+                char name[16] = { 0 };
+                QuoridorTurn_toString(a, name, sizeof(name));
+                printf("MISMATCH at %s: fast %llu, reference %llu\n", name,
+                    (unsigned long long)fastEntries[k].count,
+                    (unsigned long long)refEntries[k].count);
+                mismatches++;
+            }
+        }
+        printf("check: %s\n", mismatches ? "FAILED" : "OK");
+        exitCode = mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    free(fastEntries);
+    free(refEntries);
+    QuoridorCore_destroy(core);
+    return exitCode;
+}
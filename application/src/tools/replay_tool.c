@@ -0,0 +1,142 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "tools/tools.h"
+#include "core/game_record.h"
+#include "core/timeline.h"
+
+/// @brief Affiche chaque partie après un nombre donné de coups.
+/// Les parties sont chargées une par une dans un historique, comme dans l'interface.
+/// @param ply Nombre de coups, compté depuis la fin de la partie s'il est négatif.
+static int ReplayTool_showPly(GameRecordReader *reader, int ply)
+{
+    QuoridorCore *core = QuoridorCore_create();
+    Timeline *timeline = Timeline_create();
+
+    int gameCount = 0;
+    while (Timeline_readGame(timeline, reader, core))
+    {
+        const int turnCount = Timeline_getTurnCount(timeline);
+        Timeline_seek(timeline, core, ply >= 0 ? ply : turnCount + 1 + ply);
+
+        char position[MAX_POSITION_STRING] = { 0 };
+        QuoridorCore_toString(core, position, sizeof(position));
+        printf("game %d, move %d/%d: %s\n", gameCount, Timeline_getPly(timeline), turnCount, position);
+        QuoridorCore_print(core);
+        gameCount++;
+    }
+    const bool hasError = reader->hasError;
+
+    Timeline_destroy(timeline);
+    QuoridorCore_destroy(core);
+
+    if (hasError)
+        printf("ERROR - invalid game record after %d games\n", gameCount);
+    return hasError ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int ReplayTool_main(int argc, char *argv[])
+{
+    const char *inputPath = Tools_getStringOption(argc, argv, "--input", NULL);
+    if (inputPath == NULL)
+    {
+        printf("replay: --input is required\n");
+        return EXIT_FAILURE;
+    }
+
+    GameRecordReader *reader = GameRecordReader_create(inputPath);
+    if (reader == NULL)
+    {
+        printf("ERROR - %s is not a game record\n", inputPath);
+        return EXIT_FAILURE;
+    }
+
+    if (Tools_hasOption(argc, argv, "--ply"))
+    {
+        const int exitCode = ReplayTool_showPly(reader, Tools_getIntOption(argc, argv, "--ply", -1));
+        GameRecordReader_destroy(reader);
+        return exitCode;
+    }
+
+    const bool verify = Tools_hasOption(argc, argv, "--verify");
+    const bool print = Tools_hasOption(argc, argv, "--print");
+
+    QuoridorCore *core = QuoridorCore_create();
+    Uint64 gameCount = 0;
+    Uint64 turnCount = 0;
+    Uint64 errorCount = 0;
+    int wins[8] = { 0 };
+    int unfinished = 0;
+
+    // Les parties sont rejouées une par une, sans charger le fichier en mémoire
+    const Uint64 start = SDL_GetPerformanceCounter();
+    while (GameRecordReader_beginGame(reader, core))
+    {
+        bool isValid = true;
+        QuoridorTurn turn = { 0 };
+        while (GameRecordReader_nextTurn(reader, &turn))
+        {
+            if (verify && isValid && !QuoridorCore_canPlayTurn(core, turn))
+            {
+                char move[16] = { 0 };
+                QuoridorTurn_toString(turn, move, sizeof(move));
+                printf("game %llu: illegal move %s\n", (unsigned long long)gameCount, move);
+                isValid = false;
+            }
+            if (isValid)
+                QuoridorCore_playTurn(core, turn);
+            turnCount++;
+        }
+        if (reader->hasError)
+            break;
+
+        if (verify && isValid && core->state != reader->result)
+        {
+            printf("game %llu: recorded result does not match the replay\n", (unsigned long long)gameCount);
+            isValid = false;
+        }
+        if (isValid == false)
+            errorCount++;
+
+        if (reader->result == QUORIDOR_STATE_IN_PROGRESS)
+            unfinished++;
+        else
+            wins[reader->result - QUORIDOR_STATE_P0_WON]++;
+
+        if (print)
+        {
+            char position[MAX_POSITION_STRING] = { 0 };
+            QuoridorCore_toString(core, position, sizeof(position));
+            printf("%s\n", position);
+        }
+        gameCount++;
+    }
+    const double elapsed = Tools_getElapsed(start);
+
+    const bool hasError = reader->hasError;
+    const long byteCount = ftell(reader->file);
+    GameRecordReader_destroy(reader);
+    QuoridorCore_destroy(core);
+
+    if (hasError)
+    {
+        printf("ERROR - %s is truncated or corrupted after %llu games\n",
+            inputPath, (unsigned long long)gameCount);
+    }
+
+    printf("replay: %llu games, %llu moves, %ld bytes (%.1f bytes/game)\n",
+        (unsigned long long)gameCount, (unsigned long long)turnCount, byteCount,
+        gameCount ? (double)byteCount / (double)gameCount : 0.0);
+    for (int p = 0; p < 8; p++)
+    {
+        if (wins[p] > 0) printf("P%d wins: %d\n", p + 1, wins[p]);
+    }
+    printf("unfinished: %d\n", unfinished);
+    printf("%.2f s (%.0f games/s)%s\n", elapsed, elapsed > 0.0 ? gameCount / elapsed : 0.0,
+        verify ? (errorCount ? ", verification FAILED" : ", verification OK") : "");
+
+    return (hasError || errorCount > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,368 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "tools/tools.h"
+#include "core/quoridor_ai.h"
+#include "core/utils.h"
+#include "core/game_record.h"
+
+#define SELF_PLAY_MAX_THREADS 64
+
+/// @brief Paramètres communs à toutes les parties d'un tournoi.
+typedef struct SelfPlayConfig
+{
+    int gameCount;
+    int gridSize;
+    int playerCount;
+    int wallCount;
+    int maxPlies;
+    int depths[8];
+    Uint64 nodeLimits[8];
+    AIEngine engines[8];
+    AISearchSettings searchSettings[8];
+    MCTSSettings mctsSettings;
+    Uint64 seed;
+
+    /// @brief Table de fin de partie (optionnelle), partagée par les threads.
+    Tablebase *tablebase;
+
+    /// @brief Bibliothèque d'ouvertures (optionnelle), partagée par les threads.
+    OpeningBook *openingBook;
+
+    /// @brief Fichier des connaissances de départ de l'IA dans chaque partie (optionnel).
+    const char *knowledgePath;
+
+    /// @brief Enregistrement des parties (optionnel), partagé par les threads.
+    GameRecordWriter *record;
+    SDL_Mutex *recordMutex;
+} SelfPlayConfig;
+
+/// @brief Résultats accumulés par un thread.
+/// Chaque thread possède ses propres résultats, fusionnés à la fin du tournoi.
+typedef struct SelfPlayResult
+{
+    int wins[8];
+    int draws;
+    int games;
+    Uint64 moves[8];
+    Uint64 nodes[8];
+    double thinkTime[8];
+    Uint64 bookMoves;
+} SelfPlayResult;
+
+typedef struct SelfPlayWorker
+{
+    const SelfPlayConfig *config;
+    SDL_AtomicInt *nextGame;
+    SelfPlayResult result;
+
+    /// @brief Position de départ et actions de la partie en cours,
+    /// écrites d'un bloc dans l'enregistrement à la fin de la partie.
+    QuoridorCore start;
+    QuoridorTurn *turns;
+} SelfPlayWorker;
+
+static void SelfPlayTool_recordGame(SelfPlayWorker *worker, QuoridorState state, int plies)
+{
+    const SelfPlayConfig *config = worker->config;
+
+    SDL_LockMutex(config->recordMutex);
+    GameRecordWriter_beginGame(config->record, &(worker->start));
+    for (int k = 0; k < plies; k++)
+    {
+        GameRecordWriter_addTurn(config->record, worker->turns[k]);
+    }
+    GameRecordWriter_endGame(config->record, state);
+    SDL_UnlockMutex(config->recordMutex);
+}
+
+static void SelfPlayTool_playGame(SelfPlayWorker *worker, QuoridorCore *core, AIData **aiData, int gameID)
+{
+    const SelfPlayConfig *config = worker->config;
+    SelfPlayResult *result = &(worker->result);
+
+    // Le premier joueur change à chaque partie pour équilibrer les résultats
+    Tools_reset(core, config->gridSize, config->playerCount, config->wallCount, gameID);
+    // La graine de chaque IA ne dépend que de la partie et du joueur :
+    // une partie se rejoue à l'identique quel que soit le thread qui l'exécute
+    for (int p = 0; p < core->playerCount; p++)
+    {
+        AIData_reset(aiData[p]);
+        AIData_setSeed(aiData[p], Rng_mix(config->seed + 8 * (Uint64)gameID + (Uint64)p));
+
+        // Les connaissances des parties précédentes du thread ne sont pas gardées
+        AIData_clearKnowledge(aiData[p]);
+        if (config->knowledgePath)
+            AIData_loadKnowledge(aiData[p], config->knowledgePath);
+    }
+    for (int p = 0; p < core->playerCount; p++)
+    {
+        AIData_addPosition(aiData[p], core);
+    }
+    if (config->record)
+        worker->start = *core;
+
+    int plies = 0;
+    while (core->state == QUORIDOR_STATE_IN_PROGRESS && plies < config->maxPlies)
+    {
+        const int playerID = core->playerID;
+        const Uint64 start = SDL_GetPerformanceCounter();
+        QuoridorTurn turn = QuoridorCore_computeTurn(core, config->depths[playerID], aiData[playerID]);
+
+        result->thinkTime[playerID] += Tools_getElapsed(start);
+        result->nodes[playerID] += aiData[playerID]->stats.nodeCount;
+        result->moves[playerID]++;
+        if (aiData[playerID]->stats.fromBook)
+            result->bookMoves++;
+
+        if (turn.action == QUORIDOR_ACTION_UNDEFINED)
+            break;
+
+        QuoridorCore_playTurn(core, turn);
+        for (int p = 0; p < core->playerCount; p++)
+        {
+            AIData_addPosition(aiData[p], core);
+        }
+        if (worker->turns)
+            worker->turns[plies] = turn;
+        plies++;
+    }
+
+    if (config->record)
+        SelfPlayTool_recordGame(worker, core->state, plies);
+
+    result->games++;
+    if (core->state == QUORIDOR_STATE_IN_PROGRESS)
+        result->draws++;
+    else
+        result->wins[core->state - QUORIDOR_STATE_P0_WON]++;
+}
+
+static int SelfPlayTool_workerMain(void *data)
+{
+    SelfPlayWorker *worker = (SelfPlayWorker *)data;
+    QuoridorCore *core = QuoridorCore_create();
+    AIData *aiData[8] = { 0 };
+    for (int p = 0; p < 8; p++)
+    {
+        aiData[p] = AIData_create();
+        aiData[p]->engine = worker->config->engines[p];
+        aiData[p]->searchSettings = worker->config->searchSettings[p];
+        aiData[p]->mctsSettings = worker->config->mctsSettings;
+        AIData_setNodeLimit(aiData[p], worker->config->nodeLimits[p]);
+        aiData[p]->tablebase = worker->config->tablebase;
+        aiData[p]->openingBook = worker->config->openingBook;
+    }
+    if (worker->config->record)
+    {
+        worker->turns = (QuoridorTurn *)calloc(Int_max(1, worker->config->maxPlies), sizeof(QuoridorTurn));
+        AssertNew(worker->turns);
+    }
+
+    while (true)
+    {
+        const int gameID = SDL_AddAtomicInt(worker->nextGame, 1);
+        if (gameID >= worker->config->gameCount)
+            break;
+
+        SelfPlayTool_playGame(worker, core, aiData, gameID);
+    }
+
+    for (int p = 0; p < 8; p++)
+    {
+        AIData_destroy(aiData[p]);
+    }
+    free(worker->turns);
+    worker->turns = NULL;
+    QuoridorCore_destroy(core);
+    return 0;
+}
+
+/// @brief Calcule l'intervalle de confiance de Wilson à 95 % d'une proportion.
+static void SelfPlayTool_wilson(int successes, int trials, double *lower, double *upper)
+{
+    const double z = 1.96;
+    if (trials <= 0)
+    {
+        *lower = 0.0;
+        *upper = 1.0;
+        return;
+    }
+    const double n = (double)trials;
+    const double p = (double)successes / n;
+    const double denom = 1.0 + z * z / n;
+    const double center = (p + z * z / (2.0 * n)) / denom;
+    const double margin = z * sqrt(p * (1.0 - p) / n + z * z / (4.0 * n * n)) / denom;
+    *lower = fmax(0.0, center - margin);
+    *upper = fmin(1.0, center + margin);
+}
+
+int SelfPlayTool_main(int argc, char *argv[])
+{
+    SelfPlayConfig config = { 0 };
+    config.gameCount = Int_max(1, Tools_getIntOption(argc, argv, "--games", 100));
+    config.playerCount = Tools_getIntOption(argc, argv, "--players", 2);
+    config.gridSize = Int_clamp(Tools_getIntOption(argc, argv, "--grid", 9), 3, MAX_GRID_SIZE);
+    config.wallCount = Tools_getIntOption(argc, argv, "--walls", 10);
+    config.maxPlies = Int_max(0, Tools_getIntOption(argc, argv, "--max-plies", 400));
+    config.seed = (Uint64)Tools_getIntOption(argc, argv, "--seed", rand());
+    if (config.playerCount != 4 && config.playerCount != 8)
+        config.playerCount = 2;
+    if (config.playerCount == 8)
+        config.gridSize = 17;
+
+    const int depth = Tools_getIntOption(argc, argv, "--depth", 2);
+    for (int p = 0; p < 8; p++)
+    {
+        char name[16] = { 0 };
+        sprintf(name, "--depth%d", p);
+        config.depths[p] = Int_max(1, Tools_getIntOption(argc, argv, name, depth));
+    }
+
+    const char *engine = Tools_getStringOption(argc, argv, "--engine", "minmax");
+    for (int p = 0; p < 8; p++)
+    {
+        char name[16] = { 0 };
+        sprintf(name, "--engine%d", p);
+        const char *value = Tools_getStringOption(argc, argv, name, engine);
+        config.engines[p] = AIEngine_fromName(value);
+    }
+    for (int p = 0; p < 8; p++)
+    {
+        AISearchSettings_setDefault(&config.searchSettings[p]);
+        Tools_getSearchSettings(argc, argv, p, &config.searchSettings[p]);
+    }
+    config.mctsSettings.timeMS = Int_max(0, Tools_getIntOption(argc, argv, "--movetime", 100));
+    config.mctsSettings.iterationCount = Int_max(0, Tools_getIntOption(argc, argv, "--iterations", 0));
+    config.mctsSettings.threadCount = Int_clamp(Tools_getIntOption(argc, argv, "--mcts-threads", 1), 1, MCTS_MAX_THREADS);
+
+    // Avec une limite de noeuds, la profondeur n'est limitée que si elle est donnée,
+    // et MCTS n'a pas de durée si tous ses joueurs ont une limite
+    bool isMCTSLimited = true;
+    for (int p = 0; p < 8; p++)
+    {
+        if (!Tools_getNodeLimit(argc, argv, p, config.engines[p], &config.nodeLimits[p]))
+            return EXIT_FAILURE;
+
+        char name[16] = { 0 };
+        sprintf(name, "--depth%d", p);
+        if (config.nodeLimits[p] > 0 && !Tools_hasOption(argc, argv, "--depth") && !Tools_hasOption(argc, argv, name))
+            config.depths[p] = AI_MAX_PLY - 1;
+        if (p < config.playerCount && config.engines[p] == AI_ENGINE_MCTS && config.nodeLimits[p] == 0)
+            isMCTSLimited = false;
+    }
+    if (isMCTSLimited && !Tools_hasOption(argc, argv, "--movetime"))
+        config.mctsSettings.timeMS = 0;
+
+    if (!Tools_openTablebase(argc, argv, &config.tablebase))
+        return EXIT_FAILURE;
+    if (!Tools_openOpeningBook(argc, argv, &config.openingBook) ||
+        !Tools_getKnowledgePath(argc, argv, &config.knowledgePath))
+    {
+        Tablebase_close(config.tablebase);
+        OpeningBook_close(config.openingBook);
+        return EXIT_FAILURE;
+    }
+
+    int threadCount = Tools_getIntOption(argc, argv, "--threads", SDL_GetNumLogicalCPUCores());
+    threadCount = Int_clamp(threadCount, 1, SELF_PLAY_MAX_THREADS);
+
+    const char *recordPath = Tools_getStringOption(argc, argv, "--record", NULL);
+    if (recordPath)
+    {
+        config.record = GameRecordWriter_create(recordPath, Tools_hasOption(argc, argv, "--append"));
+        if (config.record == NULL)
+        {
+            printf("ERROR - fopen %s\n", recordPath);
+            return EXIT_FAILURE;
+        }
+        config.recordMutex = SDL_CreateMutex();
+        AssertNew(config.recordMutex);
+    }
+
+    printf("selfplay: %d games, grid %d, players %d, walls %d, %d threads, seed %llu\n",
+        config.gameCount, config.gridSize, config.playerCount, config.wallCount, threadCount,
+        (unsigned long long)config.seed);
+
+    SDL_AtomicInt nextGame = { 0 };
+    SDL_SetAtomicInt(&nextGame, 0);
+
+    SelfPlayWorker workers[SELF_PLAY_MAX_THREADS] = { 0 };
+    SDL_Thread *threads[SELF_PLAY_MAX_THREADS] = { 0 };
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers[t].config = &config;
+        workers[t].nextGame = &nextGame;
+        threads[t] = SDL_CreateThread(SelfPlayTool_workerMain, "selfplay", &workers[t]);
+        if (threads[t] == NULL)
+        {
+            printf("ERROR - SDL_CreateThread %s\n", SDL_GetError());
+            SelfPlayTool_workerMain(&workers[t]);
+        }
+    }
+
+    SelfPlayResult total = { 0 };
+    for (int t = 0; t < threadCount; t++)
+    {
+        SDL_WaitThread(threads[t], NULL);
+
+        const SelfPlayResult *result = &(workers[t].result);
+        total.games += result->games;
+        total.draws += result->draws;
+        total.bookMoves += result->bookMoves;
+        for (int p = 0; p < 8; p++)
+        {
+            total.wins[p] += result->wins[p];
+            total.moves[p] += result->moves[p];
+            total.nodes[p] += result->nodes[p];
+            total.thinkTime[p] += result->thinkTime[p];
+        }
+    }
+    const double elapsed = Tools_getElapsed(start);
+
+    printf("\n%-8s %6s %6s %7s %17s %12s %12s\n",
+        "player", "engine", "wins", "rate", "95% CI", "ms/move", "nodes/s");
+    for (int p = 0; p < config.playerCount; p++)
+    {
+        double lower = 0.0, upper = 0.0;
+        SelfPlayTool_wilson(total.wins[p], total.games, &lower, &upper);
+
+        const double rate = total.games ? (double)total.wins[p] / total.games : 0.0;
+        const double msPerMove = total.moves[p] ? 1000.0 * total.thinkTime[p] / (double)total.moves[p] : 0.0;
+        const double nps = total.thinkTime[p] > 0.0 ? (double)total.nodes[p] / total.thinkTime[p] : 0.0;
+        char engineName[32] = { 0 };
+        if (config.engines[p] == AI_ENGINE_MCTS)
+            sprintf(engineName, "mcts");
+        else if (config.nodeLimits[p] > 0)
+            sprintf(engineName, "%sn%llu", config.engines[p] == AI_ENGINE_MAXN ? "maxn" : "", (unsigned long long)config.nodeLimits[p]);
+        else if (config.engines[p] == AI_ENGINE_MAXN)
+            sprintf(engineName, "maxn%d", config.depths[p]);
+        else
+            sprintf(engineName, "d%d", config.depths[p]);
+
+        printf("P%-7d %6s %6d %6.1f%% [%5.1f%%, %5.1f%%] %12.3f %12.0f\n",
+            p + 1, engineName, total.wins[p], 100.0 * rate,
+            100.0 * lower, 100.0 * upper, msPerMove, nps);
+    }
+    printf("draws (max plies reached): %d\n", total.draws);
+    if (config.openingBook)
+        printf("book moves: %llu\n", (unsigned long long)total.bookMoves);
+    printf("%d games in %.2f s (%.2f games/s)\n",
+        total.games, elapsed, elapsed > 0.0 ? total.games / elapsed : 0.0);
+
+    if (config.record)
+    {
+        printf("%llu games recorded in %s\n", (unsigned long long)config.record->gameCount, recordPath);
+        GameRecordWriter_destroy(config.record);
+        SDL_DestroyMutex(config.recordMutex);
+    }
+    Tablebase_close(config.tablebase);
+    OpeningBook_close(config.openingBook);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "tools/tools.h"
+#include "core/tablebase.h"
+#include "core/utils.h"
+
+static const char *TablebaseTool_getResultName(RaceEntry entry)
+{
+    switch (entry.result)
+    {
+    case RACE_RESULT_WIN: return "win";
+    case RACE_RESULT_LOSS: return "loss";
+    default: return "draw";
+    }
+}
+
+/// @brief Affiche la valeur d'une position et la suite de coups des deux joueurs.
+static void TablebaseTool_printPosition(Tablebase *tablebase, QuoridorCore *core)
+{
+    char str[MAX_POSITION_STRING] = { 0 };
+    QuoridorCore_toString(core, str, sizeof(str));
+    if (!Tablebase_canProbe(tablebase, core))
+    {
+        printf("%s: not in the tablebase\n", str);
+        return;
+    }
+
+    RaceEntry entry = { 0 };
+    Tablebase_getBestTurn(tablebase, core, &entry);
+    printf("%s: %s in %d plies, pv", str, TablebaseTool_getResultName(entry), entry.plies);
+
+    QuoridorCore copy = *core;
+    for (int ply = 0; ply < 32 && Tablebase_canProbe(tablebase, &copy); ply++)
+    {
+        const QuoridorTurn turn = Tablebase_getBestTurn(tablebase, &copy, NULL);
+        char name[16] = { 0 };
+        QuoridorTurn_toString(turn, name, sizeof(name));
+        printf(" %s", name);
+        QuoridorCore_playTurn(&copy, turn);
+    }
+    printf("\n");
+}
+
+/// @brief Vérifie la table sur des positions obtenues en jouant au hasard depuis le début :
+/// la valeur de chaque position doit découler de celles des positions atteintes par ses actions,
+/// et celle d'une course sans mur doit être celle de RaceSolver.
+/// @return Le nombre d'erreurs.
+static int TablebaseTool_verify(Tablebase *tablebase, int positionCount, Uint64 seed)
+{
+    Rng rng = { 0 };
+    Rng_seed(&rng, seed);
+    RaceSolver *raceSolver = RaceSolver_create();
+    QuoridorCore core = { 0 };
+    QuoridorTurn turns[MAX_TURN_COUNT];
+    int errorCount = 0, raceCount = 0;
+
+    for (int k = 0; k < positionCount; k++)
+    {
+        if (k == 0 || !Tablebase_canProbe(tablebase, &core))
+            Tools_reset(&core, tablebase->gridSize, 2, tablebase->wallCount, k % 2);
+
+        const RaceEntry entry = Tablebase_probe(tablebase, &core);
+
+        // Valeur recalculée à partir des positions atteintes
+        const int turnCount = QuoridorCore_getTurns(&core, turns);
+        int winPlies = -1, lossPlies = -1;
+        bool hasDraw = false;
+        for (int t = 0; t < turnCount; t++)
+        {
+            QuoridorCore copy = core;
+            QuoridorCore_playTurn(&copy, turns[t]);
+            const RaceEntry child = (copy.state == QUORIDOR_STATE_IN_PROGRESS)
+                ? Tablebase_probe(tablebase, &copy) : (RaceEntry) { RACE_RESULT_LOSS, 0 };
+
+            if (child.result == RACE_RESULT_LOSS)
+                winPlies = (winPlies < 0) ? child.plies + 1 : Int_min(winPlies, child.plies + 1);
+            else if (child.result == RACE_RESULT_WIN)
+                lossPlies = Int_max(lossPlies, child.plies + 1);
+            else
+                hasDraw = true;
+        }
+
+        RaceEntry expected = { RACE_RESULT_DRAW, 0 };
+        if (winPlies >= 0)
+            expected = (RaceEntry) { RACE_RESULT_WIN, (Uint16)winPlies };
+        else if (!hasDraw && lossPlies >= 0)
+            expected = (RaceEntry) { RACE_RESULT_LOSS, (Uint16)lossPlies };
+
+        bool isValid = (entry.result == expected.result) && (entry.plies == expected.plies);
+        if (RaceSolver_canSolve(&core))
+        {
+            RaceEntry raceEntry = { 0 };
+            RaceSolver_getBestTurn(raceSolver, &core, &raceEntry);
+            isValid = isValid && (entry.result == raceEntry.result) && (entry.plies == raceEntry.plies);
+            raceCount++;
+        }
+        if (!isValid)
+        {
+            char str[MAX_POSITION_STRING] = { 0 };
+            QuoridorCore_toString(&core, str, sizeof(str));
+            printf("MISMATCH at %s: %s %d, expected %s %d\n", str,
+                TablebaseTool_getResultName(entry), entry.plies,
+                TablebaseTool_getResultName(expected), expected.plies);
+            errorCount++;
+        }
+
+        // Les déplacements sont préférés pour garder des murs dans les positions vérifiées
+        int moveCount = 0;
+        while (moveCount < turnCount && turns[moveCount].action == QUORIDOR_MOVE_TO)
+            moveCount++;
+        if (moveCount > 0 && Rng_next(&rng) % 4 != 0)
+            QuoridorCore_playTurn(&core, turns[Rng_next(&rng) % moveCount]);
+        else if (turnCount > 0)
+            QuoridorCore_playTurn(&core, turns[Rng_next(&rng) % turnCount]);
+    }
+
+    printf("verify: %d positions (%d races), %s\n", positionCount, raceCount, errorCount ? "FAILED" : "OK");
+    RaceSolver_destroy(raceSolver);
+    return errorCount;
+}
+
+int TablebaseTool_main(int argc, char *argv[])
+{
+    const char *outputPath = Tools_getStringOption(argc, argv, "--output", NULL);
+    const char *path = Tools_getStringOption(argc, argv, "--input", outputPath);
+    if (path == NULL)
+    {
+        printf("ERROR - tablebase: --input or --output is required\n");
+        return EXIT_FAILURE;
+    }
+
+    if (outputPath)
+    {
+        const int gridSize = Int_clamp(Tools_getIntOption(argc, argv, "--grid", 5), 3, TABLEBASE_MAX_GRID_SIZE);
+        const int wallCount = Int_clamp(Tools_getIntOption(argc, argv, "--walls", 2), 0, TABLEBASE_MAX_WALLS);
+        const int threadCount = Int_clamp(
+            Tools_getIntOption(argc, argv, "--threads", SDL_GetNumLogicalCPUCores()), 1, TABLEBASE_MAX_THREADS);
+        printf("tablebase: grid %d, walls %d, %d threads\n", gridSize, wallCount, threadCount);
+
+        const Uint64 start = SDL_GetPerformanceCounter();
+        if (!Tablebase_build(outputPath, gridSize, wallCount, threadCount))
+        {
+            printf("ERROR - fopen %s\n", outputPath);
+            return EXIT_FAILURE;
+        }
+        printf("built %s in %.1f s\n", outputPath, Tools_getElapsed(start));
+    }
+
+    Tablebase *tablebase = Tablebase_open(path);
+    if (tablebase == NULL)
+    {
+        printf("ERROR - %s is not a tablebase\n", path);
+        return EXIT_FAILURE;
+    }
+
+    const size_t entryCount = tablebase->file->size - sizeof(TablebaseHeader) - tablebase->maskCount * sizeof(TablebaseMask);
+    Uint64 winCount = 0, lossCount = 0;
+    for (size_t k = 0; k < entryCount; k++)
+    {
+        const Uint8 value = tablebase->entries[k];
+        if (value > 0 && (value - 1) % 2 == 0) lossCount++;
+        else if (value > 0) winCount++;
+    }
+    printf("grid %d, walls %d: %d wall layouts, %llu entries (%.1f MB), %llu won, %llu lost\n",
+        tablebase->gridSize, tablebase->wallCount, tablebase->maskCount, (unsigned long long)entryCount,
+        (double)tablebase->file->size / (1024.0 * 1024.0),
+        (unsigned long long)winCount, (unsigned long long)lossCount);
+
+    QuoridorCore core = { 0 };
+    Tools_reset(&core, tablebase->gridSize, 2, tablebase->wallCount, 0);
+    const char *position = Tools_getStringOption(argc, argv, "--position", NULL);
+    if (position && QuoridorCore_fromString(&core, position) == 0)
+    {
+        printf("ERROR - invalid position %s\n", position);
+        Tablebase_close(tablebase);
+        return EXIT_FAILURE;
+    }
+    TablebaseTool_printPosition(tablebase, &core);
+
+    int errorCount = 0;
+    const int verifyCount = Tools_getIntOption(argc, argv, "--verify", 0);
+    if (verifyCount > 0)
+        errorCount = TablebaseTool_verify(tablebase, verifyCount, (Uint64)Tools_getIntOption(argc, argv, "--seed", 1));
+
+    Tablebase_close(tablebase);
+    return errorCount ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "tools/tools.h"
+#include "core/utils.h"
+
+typedef struct ToolEntry
+{
+    const char *name;
+    int (*main)(int argc, char *argv[]);
+    const char *help;
+} ToolEntry;
+
+static const ToolEntry g_tools[] = {
+    { "perft", PerftTool_main,
+      "[--depth N] [--grid 5|7|9|17] [--players 2|4|8] [--walls N] [--mode fast|reference|check] [--divide]" },
+    { "selfplay", SelfPlayTool_main,
+      "[--games N] [--threads N] [--depth N] [--depth0 N] [--depth1 N] ... [--nodes N] [--nodes0 N] ... [--level easy|medium|hard] [--level0 L] ... [--engine minmax|maxn|mcts] [--engine0 E] ... [--movetime MS] [--mcts-threads N] [--iterations N] [--lmr 0|1] [--null-move 0|1] [--futility 0|1] [--quiescence 0|1] [--proof-number 0|1] [--tablebase FILE] [--book FILE] [--knowledge FILE] [--lmr0 0|1] ... [--grid N] [--players N] [--walls N] [--max-plies N] [--seed N] [--record FILE [--append]]" },
+    { "engine", EngineTool_main,
+      "[--seed N] [--knowledge FILE] (text protocol on stdin/stdout)" },
+    { "analyze", AnalyzeTool_main,
+      "--input FILE|- [--output FILE] [--depth N] [--movetime MS] [--nodes N] [--multipv K] [--level easy|medium|hard] [--engine minmax|maxn|mcts] [--lmr 0|1] [--null-move 0|1] [--futility 0|1] [--quiescence 0|1] [--proof-number 0|1] [--tablebase FILE] [--knowledge FILE] [--threads N] [--seed N]" },
+    { "replay", ReplayTool_main,
+      "--input FILE [--verify] [--print] [--ply N]" },
+    { "tablebase", TablebaseTool_main,
+      "--output FILE [--grid 3|4|5] [--walls N] [--threads N] | --input FILE [--position POS] [--verify N] [--seed N]" },
+    { "book", BookTool_main,
+      "--input FILE --output FILE [--plies N] [--min-games N] | --book FILE [--grid N] [--walls N] [--position POS]" },
+};
+static const int g_toolCount = sizeof(g_tools) / sizeof(g_tools[0]);
+
+static void Tools_printUsage(const char *program)
+{
+    printf("Usage: %s <tool> [options]\n", program);
+    for (int i = 0; i < g_toolCount; i++)
+    {
+        printf("  %s %s\n", g_tools[i].name, g_tools[i].help);
+    }
+}
+
+int Tools_main(int argc, char *argv[])
+{
+    assert(argc > 1);
+    for (int i = 0; i < g_toolCount; i++)
+    {
+        if (strcmp(argv[1], g_tools[i].name) == 0)
+            return g_tools[i].main(argc, argv);
+    }
+    Tools_printUsage(argv[0]);
+    return EXIT_FAILURE;
+}
+
+bool Tools_hasOption(int argc, char *argv[], const char *name)
+{
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], name) == 0)
+            return true;
+    }
+    return false;
+}
+
+const char *Tools_getStringOption(int argc, char *argv[], const char *name, const char *defaultValue)
+{
+    for (int i = 2; i < argc - 1; i++)
+    {
+        if (strcmp(argv[i], name) == 0)
+            return argv[i + 1];
+    }
+    return defaultValue;
+}
+
+int Tools_getIntOption(int argc, char *argv[], const char *name, int defaultValue)
+{
+    const char *value = Tools_getStringOption(argc, argv, name, NULL);
+    return value ? atoi(value) : defaultValue;
+}
+
+void Tools_reset(QuoridorCore *core, int gridSize, int playerCount, int wallCount, int firstPlayer)
+{
+    if (playerCount == 8)
+        gridSize = 17;
+    else if (playerCount != 4)
+        playerCount = 2;
+
+    QuoridorCore_reset(core, gridSize, wallCount, firstPlayer % playerCount, playerCount == 8);
+    core->playerCount = playerCount;
+    QuoridorCore_updateValidMoves(core);
+}
+
+void Tools_resetCore(int argc, char *argv[], QuoridorCore *core)
+{
+    const int gridSize = Int_clamp(Tools_getIntOption(argc, argv, "--grid", 9), 3, MAX_GRID_SIZE);
+    const int playerCount = Tools_getIntOption(argc, argv, "--players", 2);
+    const int wallCount = Tools_getIntOption(argc, argv, "--walls", 10);
+    Tools_reset(core, gridSize, playerCount, wallCount, 0);
+}
+
+/// @brief Lit une option booléenne, puis sa variante propre à un joueur.
+static bool Tools_getPlayerBoolOption(int argc, char *argv[], const char *name, int playerID, bool defaultValue)
+{
+    bool value = Tools_getIntOption(argc, argv, name, defaultValue) != 0;
+    if (playerID >= 0)
+    {
+        char playerName[64] = { 0 };
+        snprintf(playerName, sizeof(playerName), "%s%d", name, playerID);
+        value = Tools_getIntOption(argc, argv, playerName, value) != 0;
+    }
+    return value;
+}
+
+void Tools_getSearchSettings(int argc, char *argv[], int playerID, AISearchSettings *settings)
+{
+    settings->lateMoveReductions = Tools_getPlayerBoolOption(argc, argv, "--lmr", playerID, settings->lateMoveReductions);
+    settings->nullMove = Tools_getPlayerBoolOption(argc, argv, "--null-move", playerID, settings->nullMove);
+    settings->futility = Tools_getPlayerBoolOption(argc, argv, "--futility", playerID, settings->futility);
+    settings->quiescence = Tools_getPlayerBoolOption(argc, argv, "--quiescence", playerID, settings->quiescence);
+    settings->proofNumber = Tools_getPlayerBoolOption(argc, argv, "--proof-number", playerID, settings->proofNumber);
+}
+
+bool Tools_getNodeLimit(int argc, char *argv[], int playerID, AIEngine engine, Uint64 *nodeLimit)
+{
+    char playerName[64] = { 0 };
+    const char *levelName = Tools_getStringOption(argc, argv, "--level", NULL);
+    int nodeCount = Tools_getIntOption(argc, argv, "--nodes", 0);
+    if (playerID >= 0)
+    {
+        snprintf(playerName, sizeof(playerName), "--level%d", playerID);
+        levelName = Tools_getStringOption(argc, argv, playerName, levelName);
+        snprintf(playerName, sizeof(playerName), "--nodes%d", playerID);
+        nodeCount = Tools_getIntOption(argc, argv, playerName, nodeCount);
+    }
+
+    *nodeLimit = (Uint64)Int_max(0, nodeCount);
+    if (levelName == NULL || nodeCount > 0)
+        return true;
+
+    const AILevel level = AILevel_fromName(levelName);
+    if (level == AI_LEVEL_COUNT)
+    {
+        printf("ERROR - unknown level %s\n", levelName);
+        return false;
+    }
+    *nodeLimit = AILevel_getNodeLimit(level, engine);
+    return true;
+}
+
+bool Tools_openTablebase(int argc, char *argv[], Tablebase **tablebase)
+{
+    const char *path = Tools_getStringOption(argc, argv, "--tablebase", NULL);
+    *tablebase = path ? Tablebase_open(path) : NULL;
+    if (path && *tablebase == NULL)
+    {
+        printf("ERROR - %s is not a tablebase\n", path);
+        return false;
+    }
+    return true;
+}
+
+bool Tools_openOpeningBook(int argc, char *argv[], OpeningBook **book)
+{
+    const char *path = Tools_getStringOption(argc, argv, "--book", NULL);
+    *book = path ? OpeningBook_open(path) : NULL;
+    if (path && *book == NULL)
+    {
+        printf("ERROR - %s is not an opening book\n", path);
+        return false;
+    }
+    return true;
+}
+
+bool Tools_getKnowledgePath(int argc, char *argv[], const char **path)
+{
+    *path = Tools_getStringOption(argc, argv, "--knowledge", NULL);
+    if (*path == NULL)
+        return true;
+
+    AIData *aiData = AIData_create();
+    const bool success = AIData_loadKnowledge(aiData, *path);
+    AIData_destroy(aiData);
+    if (!success)
+        printf("ERROR - %s is not an AI knowledge file\n", *path);
+    return success;
+}
+
+double Tools_getElapsed(Uint64 start)
+{
+    const Uint64 end = SDL_GetPerformanceCounter();
+    return (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+}
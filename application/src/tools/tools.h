@@ -0,0 +1,124 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_ai.h"
+
+/// @brief Point d'entrée des outils en ligne de commande (sans interface graphique).
+/// Le premier argument désigne l'outil, par exemple "application perft --depth 3".
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @return Le code de retour du programme.
+int Tools_main(int argc, char *argv[]);
+
+/// @brief Indique si une option est présente sur la ligne de commande.
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @param name Nom de l'option, par exemple "--divide".
+/// @return true si l'option est présente, false sinon.
+bool Tools_hasOption(int argc, char *argv[], const char *name);
+
+/// @brief Renvoie la valeur entière d'une option de la forme "--name valeur".
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @param name Nom de l'option.
+/// @param defaultValue Valeur renvoyée si l'option est absente.
+/// @return La valeur de l'option.
+int Tools_getIntOption(int argc, char *argv[], const char *name, int defaultValue);
+
+/// @brief Renvoie la valeur d'une option de la forme "--name valeur".
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @param name Nom de l'option.
+/// @param defaultValue Valeur renvoyée si l'option est absente.
+/// @return La valeur de l'option.
+const char *Tools_getStringOption(int argc, char *argv[], const char *name, const char *defaultValue);
+
+/// @brief Réinitialise une partie à partir des options communes
+/// --grid (5, 7, 9 ou 17), --players (2, 4 ou 8) et --walls.
+/// En mode 8 joueurs, la grille est toujours de taille 17.
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @param core Instance du jeu Quoridor à réinitialiser.
+void Tools_resetCore(int argc, char *argv[], QuoridorCore *core);
+
+/// @brief Réinitialise une partie avec les règles données.
+/// @param core Instance du jeu Quoridor à réinitialiser.
+/// @param gridSize Taille de la grille.
+/// @param playerCount Nombre de joueurs (2, 4 ou 8).
+/// @param wallCount Nombre de murs initiaux par joueur.
+/// @param firstPlayer Identifiant du premier joueur.
+void Tools_reset(QuoridorCore *core, int gridSize, int playerCount, int wallCount, int firstPlayer);
+
+/// @brief Lit les options de la recherche sélective --lmr, --null-move et --futility (0 ou 1),
+/// puis leurs variantes propres à un joueur (--lmr0, --null-move0, ...).
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @param playerID Joueur dont les variantes sont lues (-1 pour aucune).
+/// @param settings Options à modifier, qui gardent leur valeur si l'option est absente.
+void Tools_getSearchSettings(int argc, char *argv[], int playerID, AISearchSettings *settings);
+
+/// @brief Lit la limite de noeuds par coup (voir AIData_setNodeLimit()) : l'option --nodes N
+/// ou le budget du niveau --level easy|medium|hard, puis leurs variantes propres à un joueur
+/// (--nodes0, --level0, ...). Un nombre de noeuds l'emporte sur un niveau.
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @param playerID Joueur dont les variantes sont lues (-1 pour aucune).
+/// @param engine Algorithme du joueur, dont dépend le budget d'un niveau.
+/// @param nodeLimit Adresse où est écrite la limite (0 si aucune option n'est donnée).
+/// @return false si le niveau est inconnu.
+bool Tools_getNodeLimit(int argc, char *argv[], int playerID, AIEngine engine, Uint64 *nodeLimit);
+
+/// @brief Ouvre la table de fin de partie donnée par l'option --tablebase.
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @param tablebase Adresse où est écrite la table (NULL si l'option est absente).
+/// @return false si le fichier donné n'est pas une table.
+bool Tools_openTablebase(int argc, char *argv[], Tablebase **tablebase);
+
+/// @brief Ouvre la bibliothèque d'ouvertures donnée par l'option --book.
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @param book Adresse où est écrite la bibliothèque (NULL si l'option est absente).
+/// @return false si le fichier donné n'est pas une bibliothèque.
+bool Tools_openOpeningBook(int argc, char *argv[], OpeningBook **book);
+
+/// @brief Lit l'option --knowledge, fichier de connaissances de l'IA (voir AIData_loadKnowledge()),
+/// et vérifie qu'il peut être chargé.
+/// @param argc Nombre d'arguments.
+/// @param argv Arguments de la ligne de commande.
+/// @param path Adresse où est écrit le chemin du fichier (NULL si l'option est absente).
+/// @return false si le fichier donné ne peut pas être chargé.
+bool Tools_getKnowledgePath(int argc, char *argv[], const char **path);
+
+/// @brief Renvoie le temps écoulé depuis une date donnée.
+/// @param start Date de départ, obtenue avec SDL_GetPerformanceCounter().
+/// @return Le temps écoulé en secondes.
+double Tools_getElapsed(Uint64 start);
+
+/// @brief Outil "perft" : compte les positions feuilles de l'arbre de jeu.
+int PerftTool_main(int argc, char *argv[]);
+
+/// @brief Outil "selfplay" : fait jouer l'IA contre elle-même sur plusieurs threads.
+int SelfPlayTool_main(int argc, char *argv[]);
+
+/// @brief Outil "engine" : moteur piloté par un protocole texte sur l'entrée et la sortie standard.
+int EngineTool_main(int argc, char *argv[]);
+
+/// @brief Outil "analyze" : analyse en parallèle une liste de positions en notation compacte.
+int AnalyzeTool_main(int argc, char *argv[]);
+
+/// @brief Outil "replay" : rejoue les parties d'un enregistrement binaire.
+int ReplayTool_main(int argc, char *argv[]);
+
+/// @brief Outil "tablebase" : génère ou interroge une table de fin de partie des petites grilles.
+int TablebaseTool_main(int argc, char *argv[]);
+
+/// @brief Outil "book" : construit une bibliothèque d'ouvertures à partir de parties enregistrées, ou l'interroge.
+int BookTool_main(int argc, char *argv[]);